@@ -1,19 +1,14 @@
 #include <Arduino.h>
 
 // Definicion de los mensajes a enviar (secuencia de prueba)
+// Las LOAD seguidas van en una sola trama "L,<caracteres>": mismo mensaje
+// que una trama por letra, con 3 bytes de encuadre por rafaga en vez de por letra
 const char* tramas[] = {
-    "L,H",      // Load H
-    "L,O",      // Load O
-    "L,L",      // Load L
+    "L,HOL",    // Load H, O, L
     "M,2",      // Map +2 (rotar rotor)
-    "L,A",      // Load A (se decodificara como C)
-    "L, ",      // Load espacio
-    "L,W",      // Load W (se decodificara como Y)
+    "L,A W",    // Load A, espacio, W (se decodifican como Z, Y, U)
     "M,-2",     // Map -2 (regresar rotor)
-    "L,O",      // Load O
-    "L,R",      // Load R
-    "L,L",      // Load L
-    "L,D",      // Load D
+    "L,ORLD",   // Load O, R, L, D
     "FIN"       // Marcador de fin
 };
 
@@ -21,6 +16,124 @@ const int numTramas = sizeof(tramas) / sizeof(tramas[0]);
 int tramaActual = 0;
 bool transmisionCompleta = false;
 
+// Modo binario compacto (mismas constantes que include/ProtocoloBinario.h del host)
+const char* SOLICITUD_BINARIO = "PRT7?BIN";     // Linea que envia el host
+const char* CONFIRMACION_BINARIO = "PRT7:BIN";  // Respuesta; lo siguiente ya es binario
+const uint8_t BIN_CARGA_CRUDA = 0x01;           // LOAD + byte
+const uint8_t BIN_MAPA = 0x02;                  // MAP + varint zigzag
+const uint8_t BIN_FIN = 0x03;                   // FIN
+const uint8_t BIN_CARGA_ALFABETO = 0x80;        // 0x80 + i: LOAD de "A..Z "[i]
+const uint8_t BIN_SINCRONIA[2] = {0x16, 0xA5};  // Marca de sincronia
+const int PERIODO_SINCRONIA = 64;               // Registros binarios entre marcas
+
+// Marcas de tiempo (mismas constantes que include/LatenciaEnlace.h del host)
+const char* SOLICITUD_MARCAS = "PRT7?TS";       // Linea que envia el host
+const char* CONFIRMACION_MARCAS = "PRT7:TS";    // Respuesta; las tramas de texto llevan "@<micros>,"
+
+bool modoBinario = false;
+bool conMarcas = false;
+int registrosDesdeSincronia = 0;
+uint8_t lote[32];                               // Registros binarios aun no escritos
+int largoLote = 0;
+char lineaHost[16];
+int largoLineaHost = 0;
+
+// Atiende las lineas que envia el host (solicitudes de modo binario y de marcas de tiempo)
+void atenderHost() {
+    while (Serial.available() > 0) {
+        char c = (char)Serial.read();
+        if (c == '\r') continue;
+        if (c != '\n') {
+            if (largoLineaHost < (int)sizeof(lineaHost) - 1) lineaHost[largoLineaHost++] = c;
+            continue;
+        }
+        lineaHost[largoLineaHost] = '\0';
+        largoLineaHost = 0;
+
+        if (!modoBinario && strcmp(lineaHost, SOLICITUD_BINARIO) == 0) {
+            // Ultima linea de texto; despues, la marca de sincronia
+            Serial.println(CONFIRMACION_BINARIO);
+            Serial.write(BIN_SINCRONIA, 2);
+            modoBinario = true;
+            registrosDesdeSincronia = 0;
+        } else if (!modoBinario && strcmp(lineaHost, SOLICITUD_MARCAS) == 0) {
+            Serial.println(CONFIRMACION_MARCAS);
+            conMarcas = true;
+        }
+    }
+}
+
+// Escribe los registros binarios juntados en el lote
+void vaciarLote() {
+    if (largoLote > 0) Serial.write(lote, largoLote);
+    largoLote = 0;
+}
+
+// Agrega un registro binario al lote; la marca de sincronia va cada
+// PERIODO_SINCRONIA registros escritos (una rafaga "L,..." cuenta una vez por letra)
+void agregarRegistro(const uint8_t* bytes, int n) {
+    if (largoLote + 2 + n > (int)sizeof(lote)) vaciarLote();
+    if (registrosDesdeSincronia == PERIODO_SINCRONIA) {
+        lote[largoLote++] = BIN_SINCRONIA[0];
+        lote[largoLote++] = BIN_SINCRONIA[1];
+        registrosDesdeSincronia = 0;
+    }
+    memcpy(lote + largoLote, bytes, n);
+    largoLote += n;
+    registrosDesdeSincronia++;
+}
+
+// Envia una trama "L,c", "M,n" o "FIN" en el modo actual
+void enviarTrama(const char* trama) {
+    if (!modoBinario) {
+        if (conMarcas) {
+            // micros() lo mas cerca posible del envio: un solo println por trama
+            char linea[40];
+            snprintf(linea, sizeof(linea), "@%lu,%s", (unsigned long)micros(), trama);
+            Serial.println(linea);
+        } else {
+            Serial.println(trama);
+        }
+        return;
+    }
+
+    uint8_t bytes[6];
+    int n = 0;
+    if (trama[0] == 'L') {
+        // En binario cada letra ya ocupa un byte: la rafaga va letra por letra,
+        // un registro por letra (el '\0' nunca sale: termina la cadena)
+        for (const char* c = trama + 2; *c != '\0'; c++) {
+            if (*c >= 'A' && *c <= 'Z') {
+                bytes[0] = BIN_CARGA_ALFABETO + (*c - 'A');
+                agregarRegistro(bytes, 1);
+            } else if (*c == ' ') {
+                bytes[0] = BIN_CARGA_ALFABETO + 26;
+                agregarRegistro(bytes, 1);
+            } else {
+                bytes[0] = BIN_CARGA_CRUDA;
+                bytes[1] = (uint8_t)*c;
+                agregarRegistro(bytes, 2);
+            }
+        }
+        vaciarLote();
+        return;
+    } else if (trama[0] == 'M') {
+        // Zigzag (0, -1, 1, -2... -> 0, 1, 2, 3...) y varint de 7 bits por byte
+        int32_t rotacion = atoi(trama + 2);
+        uint32_t valor = ((uint32_t)rotacion << 1) ^ (uint32_t)(rotacion >> 31);
+        bytes[n++] = BIN_MAPA;
+        while (valor >= 0x80) {
+            bytes[n++] = (uint8_t)(valor | 0x80);
+            valor >>= 7;
+        }
+        bytes[n++] = (uint8_t)valor;
+    } else {
+        bytes[n++] = BIN_FIN;
+    }
+    agregarRegistro(bytes, n);
+    vaciarLote();
+}
+
 void setup() {
     // Inicializar comunicacion serial a 115200 baudios
     Serial.begin(115200);
@@ -42,10 +155,13 @@ void setup() {
 }
 
 void loop() {
+    // El host puede pedir el modo binario en cualquier momento
+    atenderHost();
+
     if (!transmisionCompleta) {
         if (tramaActual < numTramas) {
             // Enviar la trama actual
-            Serial.println(tramas[tramaActual]);
+            enviarTrama(tramas[tramaActual]);
             
             // Mensaje de debug (opcional, comentar si causa problemas)
             // Serial.print(">>> Trama enviada: ");
@@ -56,8 +172,9 @@ void loop() {
             // Esperar 1 segundo entre tramas
             delay(1000);
         } else {
-            // Transmision completada
+            // Transmision completada (en binario el host ya no espera texto)
             transmisionCompleta = true;
+            if (modoBinario) return;
             Serial.println();
             Serial.println("========================================");
             Serial.println("  Transmision completada               ");
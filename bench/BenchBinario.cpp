@@ -0,0 +1,256 @@
+/**
+ * @file BenchBinario.cpp
+ * @brief Modo texto contra modo binario sobre una pseudo-terminal
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Un hilo hace de ESP32 en el maestro de una pseudo-terminal y SerialPort
+ * lee el esclavo. Se envia la misma secuencia de tramas (LOAD con un MAP
+ * cada ~10 tramas, FIN al final) dos veces:
+ *
+ * - texto: lineas "L,X\r\n" / "M,N\r\n" como Serial.println()
+ * - binario: el emulador espera SOLICITUD_BINARIO, contesta con
+ *   CONFIRMACION_BINARIO y envia las tramas codificadas con marcas de
+ *   sincronia cada PERIODO_SINCRONIA tramas
+ *
+ * Reporta bytes por trama en cada modo y las tramas/s que eso permite en
+ * el enlace real de 115200 baudios (10 bits por byte en 8N1); la
+ * pseudo-terminal no limita la velocidad, asi que las tramas/s medidas son
+ * las del host. Verifica que ambos modos den el mismo mensaje, y una
+ * tercera ronda inserta un byte invalido para comprobar que el receptor se
+ * resincroniza y llega al FIN.
+ *
+ * Uso: bench_binario [tramas]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "SerialPort.h"
+#include "ProtocoloBinario.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/// Bytes por segundo del enlace a 115200 baudios 8N1
+static const double BYTES_POR_SEGUNDO = 115200.0 / 10.0;
+
+/**
+ * @struct Emisor
+ * @brief Extremo maestro de la pseudo-terminal y lo que debe enviar
+ */
+struct Emisor {
+    int maestro;                ///< Descriptor del maestro
+    const unsigned char* datos; ///< Bytes a enviar
+    int tamanio;                ///< Bytes en datos
+    bool negociar;              ///< Esperar la solicitud y confirmar antes de enviar
+};
+
+/**
+ * @brief Genera la secuencia de tramas de prueba
+ */
+static void generarTramas(Trama* tramas, int cantidad) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    unsigned int semilla = 2024;
+    for (int i = 0; i < cantidad - 1; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        tramas[i].sesion = 0;
+        tramas[i].longitud = 1;
+        if (azar % 10 == 0) {
+            tramas[i].tipo = TRAMA_MAP;
+            tramas[i].rotacion = static_cast<int>(azar % 61) - 30;
+        } else {
+            tramas[i].tipo = TRAMA_LOAD;
+            tramas[i].caracter = alfabeto[azar % 27];
+        }
+    }
+    tramas[cantidad - 1].tipo = TRAMA_FIN;
+    tramas[cantidad - 1].sesion = 0;
+}
+
+/**
+ * @brief Escribe todos los bytes en el maestro
+ */
+static void escribirTodo(int fd, const unsigned char* datos, int tamanio) {
+    int enviados = 0;
+    while (enviados < tamanio) {
+        ssize_t n = write(fd, datos + enviados, tamanio - enviados);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        enviados += static_cast<int>(n);
+    }
+}
+
+/**
+ * @brief Hilo emisor: negocia si corresponde y envia la captura
+ */
+static void emitir(Emisor* emisor) {
+    if (emisor->negociar) {
+        // Esperar la linea de solicitud del host
+        char linea[64];
+        int n = 0;
+        while (true) {
+            char c;
+            ssize_t leido = read(emisor->maestro, &c, 1);
+            if (leido <= 0) {
+                if (leido < 0 && errno == EINTR) continue;
+                return;
+            }
+            if (c == '\r') continue;
+            if (c != '\n') {
+                if (n < 63) linea[n++] = c;
+                continue;
+            }
+            linea[n] = '\0';
+            n = 0;
+            if (std::strcmp(linea, SOLICITUD_BINARIO) == 0) break;
+        }
+        const char* confirmacion = CONFIRMACION_BINARIO "\r\n";
+        escribirTodo(emisor->maestro, reinterpret_cast<const unsigned char*>(confirmacion),
+                     static_cast<int>(std::strlen(confirmacion)));
+    }
+    escribirTodo(emisor->maestro, emisor->datos, emisor->tamanio);
+}
+
+/**
+ * @brief Envia una captura por la pseudo-terminal y la decodifica con SerialPort
+ * @return Segundos, o -1 si no se pudo abrir o no llego el FIN
+ */
+static double decodificar(const unsigned char* datos, int tamanio, bool binario,
+                          ListaDeCarga* lista, unsigned long long* descartados) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        if (maestro >= 0) close(maestro);
+        return -1.0;
+    }
+
+    double segundos = -1.0;
+    {
+        SerialPort puerto(ptsname(maestro));
+        if (puerto.estaConectado()) {
+            Emisor emisor = {maestro, datos, tamanio, binario};
+            RotorDeMapeo rotor;
+            Trama trama;
+            char linea[256];
+
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            std::thread hilo(emitir, &emisor);
+            if (binario) {
+                puerto.solicitarModoBinario();
+            }
+            while (puerto.estaConectado()) {
+                if (puerto.leerLinea(linea, sizeof(linea)) == 0) continue;
+                if (interpretarTrama(linea, &trama) != LINEA_VALIDA) continue;
+                if (trama.tipo == TRAMA_FIN) {
+                    segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                    break;
+                }
+                procesarTrama(trama, lista, &rotor);
+            }
+            hilo.join();
+            *descartados = puerto.getBytesDescartados();
+        }
+    }
+    close(maestro);
+    return segundos;
+}
+
+int main(int argc, char* argv[]) {
+    int cantidad = 1000000;
+    if (argc > 1 && std::atoi(argv[1]) > 1) cantidad = std::atoi(argv[1]);
+
+    // Sin eco de consola: se mide solo la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    Trama* tramas = new Trama[cantidad];
+    generarTramas(tramas, cantidad);
+
+    // Captura de texto, como la envia Serial.println()
+    unsigned char* texto = new unsigned char[static_cast<long long>(cantidad) * 8];
+    int bytesTexto = 0;
+    for (int i = 0; i < cantidad; i++) {
+        bytesTexto += escribirTrama(tramas[i], reinterpret_cast<char*>(texto + bytesTexto), 8);
+        texto[bytesTexto++] = '\r';
+        texto[bytesTexto++] = '\n';
+    }
+
+    // Captura binaria con marcas de sincronia
+    long long capacidad = static_cast<long long>(cantidad) * TRAMA_BINARIA_MAXIMA
+                          + (cantidad / PERIODO_SINCRONIA + 2) * 2;
+    unsigned char* binario = new unsigned char[capacidad];
+    int bytesBinario = 0;
+    int bytesSincronia = 0;
+    for (int i = 0; i < cantidad; i++) {
+        if (i % PERIODO_SINCRONIA == 0) {
+            binario[bytesBinario++] = BIN_SINCRONIA;
+            binario[bytesBinario++] = BIN_SINCRONIA_2;
+            bytesSincronia += 2;
+        }
+        bytesBinario += codificarTramaBinaria(tramas[i], binario + bytesBinario);
+    }
+
+    double porTramaTexto = static_cast<double>(bytesTexto) / cantidad;
+    double porTramaBinario = static_cast<double>(bytesBinario) / cantidad;
+    std::cout << cantidad << " tramas" << std::endl;
+    std::cout << "  texto    " << porTramaTexto << " bytes/trama  "
+              << static_cast<long long>(BYTES_POR_SEGUNDO / porTramaTexto) << " tramas/s a 115200" << std::endl;
+    std::cout << "  binario  " << porTramaBinario << " bytes/trama (" << bytesSincronia
+              << " de sincronia)  " << static_cast<long long>(BYTES_POR_SEGUNDO / porTramaBinario)
+              << " tramas/s a 115200  x" << porTramaTexto / porTramaBinario << std::endl;
+
+    int errores = 0;
+    ListaDeCarga listaTexto;
+    ListaDeCarga listaBinario;
+    unsigned long long descartados = 0;
+
+    double tTexto = decodificar(texto, bytesTexto, false, &listaTexto, &descartados);
+    double tBinario = decodificar(binario, bytesBinario, true, &listaBinario, &descartados);
+    if (tTexto < 0 || tBinario < 0) {
+        std::cout << "  ERROR: no se pudo abrir la pseudo-terminal o no llego el FIN" << std::endl;
+        errores++;
+    } else {
+        std::cout << "  host texto    " << static_cast<long long>(cantidad / tTexto) << " tramas/s" << std::endl;
+        std::cout << "  host binario  " << static_cast<long long>(cantidad / tBinario) << " tramas/s" << std::endl;
+
+        int largo = listaTexto.getTamanio();
+        char* mensajeTexto = new char[largo + 1];
+        char* mensajeBinario = new char[listaBinario.getTamanio() + 1];
+        listaTexto.copiarMensaje(mensajeTexto, largo + 1);
+        listaBinario.copiarMensaje(mensajeBinario, listaBinario.getTamanio() + 1);
+        if (listaBinario.getTamanio() != largo || std::memcmp(mensajeTexto, mensajeBinario, largo) != 0) {
+            std::cout << "  ERROR: el modo binario no da el mismo mensaje" << std::endl;
+            errores++;
+        }
+        delete[] mensajeTexto;
+        delete[] mensajeBinario;
+    }
+
+    // Un byte invalido a media captura: se pierde hasta la siguiente marca
+    binario[bytesBinario / 2] = 0x7F;
+    ListaDeCarga listaDanada;
+    descartados = 0;
+    if (decodificar(binario, bytesBinario, true, &listaDanada, &descartados) < 0 || descartados == 0) {
+        std::cout << "  ERROR: no se resincronizo tras un byte invalido" << std::endl;
+        errores++;
+    } else {
+        std::cout << "  byte invalido: " << descartados << " bytes descartados, "
+                  << listaBinario.getTamanio() - listaDanada.getTamanio() << " caracteres perdidos" << std::endl;
+    }
+
+    delete[] tramas;
+    delete[] texto;
+    delete[] binario;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file BenchCarga.cpp
+ * @brief Memoria y throughput: lista de nodos por caracter vs ListaDeCarga por bloques
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Para mensajes de 1 KB, 1 MB y 1 GB mide el tiempo de armar y liberar el
+ * mensaje y la memoria de heap usada. La lista original (un new por
+ * caracter) solo se mide hasta 64 MB; arriba de eso necesitaria decenas de
+ * GB de RAM y se reporta la estimacion.
+ *
+ * La ListaDeCarga se llena con insertarBloque() en tramos de 16 bytes, el
+ * tamanio tipico de una racha de LOAD decodificada ("bloques"), y tambien
+ * con insertarAlFinal() caracter por caracter ("bloques1").
+ *
+ * Uso: bench_carga [bytes_maximos]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "ListaDeCarga.h"
+#include "NivelDetalle.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+/**
+ * @class ListaNodosLegado
+ * @brief Copia de referencia de la lista original (un nodo por caracter, sin eco)
+ */
+class ListaNodosLegado {
+private:
+    struct Nodo {
+        char dato;
+        Nodo* siguiente;
+        Nodo* previo;
+        Nodo(char c) : dato(c), siguiente(nullptr), previo(nullptr) {}
+    };
+
+    Nodo* cabeza;
+    Nodo* cola;
+    long long tamanio;
+
+public:
+    ListaNodosLegado() : cabeza(nullptr), cola(nullptr), tamanio(0) {}
+
+    ~ListaNodosLegado() {
+        Nodo* actual = cabeza;
+        while (actual) {
+            Nodo* siguiente = actual->siguiente;
+            delete actual;
+            actual = siguiente;
+        }
+    }
+
+    void insertarAlFinal(char dato) {
+        Nodo* nuevo = new Nodo(dato);
+        if (!cabeza) {
+            cabeza = nuevo;
+            cola = nuevo;
+        } else {
+            cola->siguiente = nuevo;
+            nuevo->previo = cola;
+            cola = nuevo;
+        }
+        tamanio++;
+    }
+};
+
+/**
+ * @brief Bytes de heap en uso (0 si la plataforma no lo reporta)
+ */
+static long long heapEnUso() {
+#ifdef __GLIBC__
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+    struct mallinfo info = mallinfo();
+    return static_cast<long long>(info.uordblks) + info.hblkhd;
+#endif
+#else
+    return 0;
+#endif
+}
+
+static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - inicio;
+    return d.count();
+}
+
+/**
+ * @brief Imprime una fila de resultados
+ */
+static void reportar(const char* nombre, long long n, double tArmar, double tLiberar, long long heap) {
+    std::cout << "  " << nombre
+              << "  armar: " << tArmar << " s (" << (n / tArmar) / 1e6 << " MB/s)"
+              << "  liberar: " << tLiberar << " s"
+              << "  heap: " << heap / 1024.0 / 1024.0 << " MiB ("
+              << static_cast<double>(heap) / n << " B/caracter)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    long long maximo = 1LL << 30;
+    if (argc > 1) {
+        maximo = std::atoll(argv[1]);
+        if (maximo <= 0) maximo = 1LL << 30;
+    }
+
+    const long long LIMITE_LEGADO = 64LL << 20;
+    const long long tamanios[] = { 1LL << 10, 1LL << 20, 1LL << 30 };
+    const char* etiquetas[] = { "1 KB", "1 MB", "1 GB" };
+
+    // Tramo de datos "decodificados" que se inserta repetidamente
+    const int TRAMO = 16;
+    char tramo[TRAMO];
+    for (int i = 0; i < TRAMO; i++) tramo[i] = static_cast<char>('A' + i);
+
+    int errores = 0;
+
+    // Sin eco de consola: se mide solo el almacenamiento
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    for (int t = 0; t < 3; t++) {
+        long long n = tamanios[t];
+        if (n > maximo) break;
+
+        std::cout << "Mensaje de " << etiquetas[t] << ":" << std::endl;
+
+        if (n <= LIMITE_LEGADO) {
+            long long heapAntes = heapEnUso();
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+            ListaNodosLegado* legado = new ListaNodosLegado();
+            for (long long i = 0; i < n; i++) legado->insertarAlFinal(tramo[i % TRAMO]);
+            double tArmar = segundosDesde(inicio);
+            long long heap = heapEnUso() - heapAntes;
+
+            inicio = std::chrono::steady_clock::now();
+            delete legado;
+            reportar("nodos   ", n, tArmar, segundosDesde(inicio), heap);
+        } else {
+            std::cout << "  nodos     (no se ejecuta: necesitaria ~"
+                      << (n * 32) / (1024.0 * 1024.0 * 1024.0) << " GiB de heap)" << std::endl;
+        }
+
+        long long heapAntes = heapEnUso();
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+        ListaDeCarga* lista = new ListaDeCarga();
+        for (long long i = 0; i < n; i += TRAMO) {
+            lista->insertarBloque(tramo, static_cast<int>(n - i < TRAMO ? n - i : TRAMO));
+        }
+        double tArmar = segundosDesde(inicio);
+        long long heap = heapEnUso() - heapAntes;
+
+        if (lista->getTamanio() != n) errores++;
+
+        inicio = std::chrono::steady_clock::now();
+        delete lista;
+        reportar("bloques ", n, tArmar, segundosDesde(inicio), heap);
+
+        // Misma lista, pero caracter por caracter (ruta de TramaLoad)
+        heapAntes = heapEnUso();
+        inicio = std::chrono::steady_clock::now();
+
+        lista = new ListaDeCarga();
+        for (long long i = 0; i < n; i++) lista->insertarAlFinal(tramo[i % TRAMO]);
+        tArmar = segundosDesde(inicio);
+        heap = heapEnUso() - heapAntes;
+
+        if (lista->getTamanio() != n) errores++;
+
+        inicio = std::chrono::steady_clock::now();
+        delete lista;
+        reportar("bloques1", n, tArmar, segundosDesde(inicio), heap);
+    }
+
+    // Verificar que el contenido por bloques conserva el orden de llegada
+    ListaDeCarga verificacion;
+    const char mensaje[] = "HOLA MUNDO";
+    for (int i = 0; i < 1000; i++) verificacion.insertarBloque(mensaje, 10);
+    char* copia = new char[10 * 1000 + 1];
+    verificacion.copiarMensaje(copia, 10 * 1000 + 1);
+    for (int i = 0; i < 1000; i++) {
+        if (std::memcmp(copia + i * 10, mensaje, 10) != 0) errores++;
+    }
+    delete[] copia;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
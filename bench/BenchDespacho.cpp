@@ -0,0 +1,163 @@
+/**
+ * @file BenchDespacho.cpp
+ * @brief Asignaciones y throughput del despacho de tramas: TramaBase* vs Trama por valor
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Reemplaza operator new/delete globales para contar asignaciones de heap.
+ * Decodifica el mismo flujo de lineas con:
+ *   - la ruta polimorfica (parsearTrama -> new TramaLoad/TramaMap -> procesar -> delete)
+ *   - la ruta por valor (parsearTrama en una Trama reutilizable -> procesarTrama)
+ *
+ * La ruta por valor, con la ListaDeCarga ya reservada, debe hacer cero
+ * asignaciones por trama; si no es asi el programa termina con codigo 1.
+ *
+ * Uso: bench_despacho [numero_de_tramas]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "Trama.h"
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "NivelDetalle.h"
+
+static unsigned long long asignaciones = 0;  ///< Llamadas a operator new desde el arranque
+
+void* operator new(std::size_t n) {
+    asignaciones++;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t n) {
+    asignaciones++;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+/**
+ * @brief Genera n lineas "L,X" / "M,N" de 8 bytes cada una (1 MAP cada ~16)
+ */
+static void generarLineas(char* lineas, int n) {
+    const char simbolos[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ .";
+    unsigned int estado = 7;
+
+    for (int i = 0; i < n; i++) {
+        char* linea = lineas + i * 8;
+        estado = estado * 1103515245u + 12345u;
+        unsigned int r = (estado >> 16) & 0x7FFF;
+
+        if (r % 16 == 0) {
+            int rot = static_cast<int>(r % 53) - 26;
+            int k = 0;
+            linea[k++] = 'M';
+            linea[k++] = ',';
+            if (rot < 0) { linea[k++] = '-'; rot = -rot; }
+            if (rot >= 10) linea[k++] = static_cast<char>('0' + rot / 10);
+            linea[k++] = static_cast<char>('0' + rot % 10);
+            linea[k] = '\0';
+        } else {
+            linea[0] = 'L';
+            linea[1] = ',';
+            linea[2] = simbolos[r % 28];
+            linea[3] = '\0';
+        }
+    }
+}
+
+static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - inicio;
+    return d.count();
+}
+
+int main(int argc, char* argv[]) {
+    int n = 2000000;
+    if (argc > 1) {
+        n = std::atoi(argv[1]);
+        if (n <= 0) n = 2000000;
+    }
+
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    char* lineas = new char[static_cast<long long>(n) * 8];
+    generarLineas(lineas, n);
+
+    // Ruta polimorfica (adaptador TramaBase)
+    ListaDeCarga* cargaPoli = new ListaDeCarga();
+    RotorDeMapeo* rotorPoli = new RotorDeMapeo();
+    cargaPoli->reservar(n);
+
+    unsigned long long antes = asignaciones;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        TramaBase* trama = parsearTrama(lineas + i * 8);
+        if (trama) {
+            trama->procesar(cargaPoli, rotorPoli);
+            delete trama;
+        }
+    }
+    double tPoli = segundosDesde(inicio);
+    unsigned long long asigPoli = asignaciones - antes;
+
+    // Ruta por valor
+    ListaDeCarga* cargaValor = new ListaDeCarga();
+    RotorDeMapeo* rotorValor = new RotorDeMapeo();
+    cargaValor->reservar(n);
+    Trama trama;
+
+    antes = asignaciones;
+    inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        if (parsearTrama(lineas + i * 8, &trama)) {
+            procesarTrama(trama, cargaValor, rotorValor);
+        }
+    }
+    double tValor = segundosDesde(inicio);
+    unsigned long long asigValor = asignaciones - antes;
+
+    // Ambas rutas deben armar el mismo mensaje
+    int errores = 0;
+    int tam = cargaPoli->getTamanio();
+    if (tam != cargaValor->getTamanio()) {
+        errores++;
+    } else {
+        char* a = new char[tam + 1];
+        char* b = new char[tam + 1];
+        cargaPoli->copiarMensaje(a, tam + 1);
+        cargaValor->copiarMensaje(b, tam + 1);
+        for (int i = 0; i < tam; i++) {
+            if (a[i] != b[i]) errores++;
+        }
+        delete[] a;
+        delete[] b;
+    }
+
+    std::cout << "Tramas: " << n << std::endl;
+    std::cout << "TramaBase* (new/virtual/delete): " << tPoli << " s  "
+              << (n / tPoli) / 1e6 << " Mtramas/s  "
+              << static_cast<double>(asigPoli) / n << " asignaciones/trama" << std::endl;
+    std::cout << "Trama por valor (switch):        " << tValor << " s  "
+              << (n / tValor) / 1e6 << " Mtramas/s  "
+              << static_cast<double>(asigValor) / n << " asignaciones/trama ("
+              << asigValor << " en total)" << std::endl;
+    std::cout << "Diferencias: " << errores << std::endl;
+
+    delete cargaPoli;
+    delete rotorPoli;
+    delete cargaValor;
+    delete rotorValor;
+    delete[] lineas;
+
+    return (errores == 0 && asigValor == 0) ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file BenchIdaVuelta.cpp
+ * @brief Ida y vuelta: texto -> CodificadorDeTramas -> parsearTrama -> procesarTrama -> texto
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Primero comprueba que el cifrado sea la inversa exacta del mapeo para los
+ * 256 bytes y las 27 cabezas (getCifrado() y codificarBloque()).
+ *
+ * Despues genera varios megabytes de texto (A-Z, espacio y algunos signos
+ * que viajan sin cifrar) y un calendario de rotaciones al azar, lo codifica
+ * en tramas y lo decodifica como el bucle principal sin eco:
+ * FuenteMapeada::extraerLinea -> parsearTrama -> procesarTrama ->
+ * ListaDeCarga. Reporta tramas/s de cada lado y exige que el mensaje
+ * recuperado sea identico byte a byte, con LOAD de un caracter y en rafaga.
+ *
+ * Uso: bench_ida_vuelta [megabytes]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "CodificadorDeTramas.h"
+#include "FuenteMapeada.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/**
+ * @brief Verifica getCifrado y codificarBloque contra getMapeo
+ * @return Diferencias encontradas
+ */
+static int verificarInversa() {
+    char entrada[256];
+    char cifrado[256];
+    char claro[256];
+    for (int i = 0; i < 256; i++) {
+        entrada[i] = static_cast<char>(i);
+    }
+
+    int errores = 0;
+    RotorDeMapeo rotor;
+    for (int cabeza = 0; cabeza < RotorDeMapeo::TAMANIO; cabeza++) {
+        rotor.setDesplazamiento(cabeza);
+        rotor.codificarBloque(entrada, cifrado, 256);
+        rotor.decodificarBloque(cifrado, claro, 256);
+        for (int i = 0; i < 256; i++) {
+            if (cifrado[i] != rotor.getCifrado(entrada[i])) errores++;
+            if (rotor.getMapeo(rotor.getCifrado(entrada[i])) != entrada[i]) errores++;
+            if (claro[i] != entrada[i]) errores++;
+        }
+    }
+    return errores;
+}
+
+/**
+ * @brief Genera el texto en claro y el calendario de rotaciones (un MAP cada ~50 caracteres)
+ * @return Rotaciones en el calendario
+ */
+static int generarMensaje(char* texto, long long n, RotacionProgramada* calendario, int maximoRotaciones) {
+    const char simbolos[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ     .,;0123456789";
+    const unsigned int numSimbolos = sizeof(simbolos) - 1;
+    unsigned int semilla = 31337;
+    int rotaciones = 0;
+
+    for (long long i = 0; i < n; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        texto[i] = simbolos[azar % numSimbolos];
+        if ((azar >> 6) % 50 == 0 && rotaciones < maximoRotaciones) {
+            calendario[rotaciones].posicion = i;
+            calendario[rotaciones].rotacion = static_cast<int>((azar >> 1) % 121) - 60;
+            rotaciones++;
+        }
+    }
+    return rotaciones;
+}
+
+/**
+ * @brief Decodifica las tramas hasta el FIN
+ * @return Tramas validas
+ */
+static unsigned long long decodificar(const char* tramas, long long tamanio, ListaDeCarga* carga) {
+    RotorDeMapeo rotor;
+    char linea[256];
+    Trama trama;
+    unsigned long long validas = 0;
+    unsigned long long posicion = 0;
+    unsigned long long total = static_cast<unsigned long long>(tamanio);
+
+    while (posicion < total) {
+        FuenteMapeada::extraerLinea(tramas, total, &posicion, linea, sizeof(linea));
+        if (!parsearTrama(linea, &trama)) continue;
+        validas++;
+        if (trama.tipo == TRAMA_FIN) break;
+        procesarTrama(trama, carga, &rotor);
+    }
+    return validas;
+}
+
+int main(int argc, char* argv[]) {
+    long long megabytes = 16;
+    if (argc > 1 && std::atoll(argv[1]) > 0) megabytes = std::atoll(argv[1]);
+    long long n = megabytes * 1024 * 1024;
+
+    // Sin eco de consola: se mide solo la codificacion y la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    int errores = verificarInversa();
+    std::cout << "Inversa (256 bytes x 27 cabezas): " << (errores == 0 ? "OK" : "DISTINTA") << std::endl;
+
+    int maximoRotaciones = static_cast<int>(n / 25 + 1);
+    char* texto = new char[n];
+    RotacionProgramada* calendario = new RotacionProgramada[maximoRotaciones];
+    int rotaciones = generarMensaje(texto, n, calendario, maximoRotaciones);
+    char* recuperado = new char[n + 1];
+
+    std::cout << megabytes << " MB de texto, " << rotaciones << " rotaciones" << std::endl;
+
+    const int rafagas[] = {1, 16, 200};
+    for (int r = 0; r < 3; r++) {
+        long long capacidad = CodificadorDeTramas::capacidadNecesaria(n, rotaciones, rafagas[r]);
+        char* tramas = new char[capacidad];
+
+        CodificadorDeTramas codificador(rafagas[r]);
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        long long tamanio = codificador.codificar(texto, n, calendario, rotaciones, true, tramas);
+        double tCodificar = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        ListaDeCarga carga;
+        carga.reservar(static_cast<int>(n));
+        inicio = std::chrono::steady_clock::now();
+        unsigned long long validas = decodificar(tramas, tamanio, &carga);
+        double tDecodificar = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        int largo = carga.copiarMensaje(recuperado, static_cast<int>(n + 1));
+        bool identico = largo == n && validas == codificador.getTramas()
+                        && std::memcmp(recuperado, texto, static_cast<size_t>(n)) == 0;
+        if (!identico) errores++;
+
+        std::cout << "  rafaga " << rafagas[r] << (rafagas[r] < 10 ? "    " : rafagas[r] < 100 ? "   " : "  ")
+                  << codificador.getTramas() << " tramas, " << static_cast<double>(tamanio) / (1024 * 1024)
+                  << " MB  codificar " << static_cast<long long>(codificador.getTramas() / tCodificar)
+                  << " tramas/s  decodificar " << static_cast<long long>(validas / tDecodificar)
+                  << " tramas/s (" << n / tDecodificar / 1e6 << " MB/s de texto)  "
+                  << (identico ? "identico" : "DISTINTO") << std::endl;
+
+        delete[] tramas;
+    }
+
+    delete[] texto;
+    delete[] calendario;
+    delete[] recuperado;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file BenchMultipuerto.cpp
+ * @brief Prueba de carga de DecodificadorMultipuerto con pseudo-terminales
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Simula N transmisores ESP32: abre N pseudo-terminales y un hilo por
+ * canal escribe en el maestro una captura PRT-7 distinta (LOAD con un MAP
+ * cada ~10 tramas, lineas con "\r\n", FIN al final) lo mas rapido que
+ * acepta el driver. El decodificador abre los esclavos como puertos
+ * seriales y los atiende con su grupo de hilos.
+ *
+ * Para 1, 2, 4, ... N canales reporta tramas/s agregadas y la escala
+ * contra un canal, y compara el mensaje de cada canal con el de la
+ * decodificacion secuencial de su captura.
+ *
+ * Uso: bench_multipuerto [tramas_por_canal] [canales_maximos]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include "DecodificadorMultipuerto.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/**
+ * @struct Transmisor
+ * @brief Extremo maestro de una pseudo-terminal y la captura que envia
+ */
+struct Transmisor {
+    int maestro;            ///< Descriptor del maestro
+    char esclavo[64];       ///< Ruta del esclavo (el "puerto serial")
+    char* captura;          ///< Bytes a enviar
+    int tamanio;            ///< Bytes en captura
+    char* esperado;         ///< Mensaje de la decodificacion secuencial
+    int longitud;           ///< Caracteres en esperado
+};
+
+/**
+ * @brief Genera la captura de un canal y su mensaje esperado
+ */
+static void generarCaptura(Transmisor* transmisor, int tramas, unsigned int semilla) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    transmisor->captura = new char[tramas * 8 + 16];
+    int n = 0;
+
+    for (int i = 0; i < tramas; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        if (azar % 10 == 0) {
+            n += std::sprintf(transmisor->captura + n, "M,%d\r\n", static_cast<int>(azar % 61) - 30);
+        } else {
+            n += std::sprintf(transmisor->captura + n, "L,%c\r\n", alfabeto[azar % 27]);
+        }
+    }
+    n += std::sprintf(transmisor->captura + n, "FIN\r\n");
+    transmisor->tamanio = n;
+
+    // Referencia: misma captura por el camino secuencial
+    ListaDeCarga lista;
+    RotorDeMapeo rotor;
+    Trama trama;
+    char linea[256];
+    int inicio = 0;
+    for (int i = 0; i < n; i++) {
+        if (transmisor->captura[i] != '\n') continue;
+        int largo = i - inicio - 1;
+        std::memcpy(linea, transmisor->captura + inicio, largo);
+        linea[largo] = '\0';
+        inicio = i + 1;
+        if (interpretarTrama(linea, &trama) != LINEA_VALIDA) continue;
+        if (trama.tipo == TRAMA_FIN) break;
+        procesarTrama(trama, &lista, &rotor);
+    }
+    transmisor->longitud = lista.getTamanio();
+    transmisor->esperado = new char[transmisor->longitud + 1];
+    lista.copiarMensaje(transmisor->esperado, transmisor->longitud + 1);
+}
+
+/**
+ * @brief Abre una pseudo-terminal y anota la ruta del esclavo
+ */
+static bool abrirPseudoTerminal(Transmisor* transmisor) {
+    transmisor->maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (transmisor->maestro < 0) return false;
+    if (grantpt(transmisor->maestro) != 0 || unlockpt(transmisor->maestro) != 0) {
+        close(transmisor->maestro);
+        return false;
+    }
+    std::strncpy(transmisor->esclavo, ptsname(transmisor->maestro), sizeof(transmisor->esclavo) - 1);
+    transmisor->esclavo[sizeof(transmisor->esclavo) - 1] = '\0';
+    return true;
+}
+
+/**
+ * @brief Envia la captura completa por el maestro (bloquea si el driver se llena)
+ */
+static void transmitir(Transmisor* transmisor) {
+    int enviados = 0;
+    while (enviados < transmisor->tamanio) {
+        ssize_t n = write(transmisor->maestro, transmisor->captura + enviados,
+                          transmisor->tamanio - enviados);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        enviados += static_cast<int>(n);
+    }
+}
+
+/**
+ * @brief Ejecuta una ronda con 'canales' transmisores simultaneos
+ * @return Segundos, o -1 si algun mensaje no coincide
+ */
+static double medirRonda(int canales, int tramas, unsigned long long* tramasTotales) {
+    Transmisor* transmisores = new Transmisor[canales];
+    char** nombres = new char*[canales];
+    bool abiertos = true;
+
+    for (int i = 0; i < canales; i++) {
+        generarCaptura(&transmisores[i], tramas, 777u + 31u * static_cast<unsigned int>(i));
+        abiertos = abrirPseudoTerminal(&transmisores[i]) && abiertos;
+        nombres[i] = transmisores[i].esclavo;
+    }
+
+    double segundos = -1.0;
+    if (abiertos) {
+        DecodificadorMultipuerto multipuerto(nombres, canales);
+        if (multipuerto.estanConectados()) {
+            std::thread* escritores = new std::thread[canales];
+
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            for (int i = 0; i < canales; i++) {
+                escritores[i] = std::thread(transmitir, &transmisores[i]);
+            }
+            multipuerto.ejecutar();
+            segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+            for (int i = 0; i < canales; i++) {
+                escritores[i].join();
+            }
+            delete[] escritores;
+
+            *tramasTotales = multipuerto.getTramasTotales();
+            for (int i = 0; i < canales; i++) {
+                const ListaDeCarga& carga = multipuerto.getCarga(i);
+                char* obtenido = new char[carga.getTamanio() + 1];
+                carga.copiarMensaje(obtenido, carga.getTamanio() + 1);
+                if (!multipuerto.recibioFin(i) || carga.getTamanio() != transmisores[i].longitud
+                    || std::memcmp(obtenido, transmisores[i].esperado, transmisores[i].longitud) != 0) {
+                    std::cerr << "  canal " << i << " (" << nombres[i] << "): mensaje distinto" << std::endl;
+                    segundos = -1.0;
+                }
+                delete[] obtenido;
+            }
+        }
+    }
+
+    for (int i = 0; i < canales; i++) {
+        if (transmisores[i].maestro >= 0) close(transmisores[i].maestro);
+        delete[] transmisores[i].captura;
+        delete[] transmisores[i].esperado;
+    }
+    delete[] transmisores;
+    delete[] nombres;
+    return segundos;
+}
+
+int main(int argc, char* argv[]) {
+    int tramas = 200000;
+    int canalesMaximos = 8;
+
+    if (argc > 1 && std::atoi(argv[1]) > 0) tramas = std::atoi(argv[1]);
+    if (argc > 2 && std::atoi(argv[2]) > 0) canalesMaximos = std::atoi(argv[2]);
+
+    // Sin eco de consola: se mide solo la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    std::cout << tramas << " tramas por canal, " << std::thread::hardware_concurrency()
+              << " nucleos" << std::endl;
+
+    int errores = 0;
+    double porCanalBase = 0.0;
+    for (int canales = 1; canales <= canalesMaximos;
+         canales = (canales < canalesMaximos && canales * 2 > canalesMaximos) ? canalesMaximos : canales * 2) {
+        unsigned long long total = 0;
+        double t = medirRonda(canales, tramas, &total);
+        if (t < 0) {
+            errores++;
+            std::cout << "  canales " << canales << "  ERROR" << std::endl;
+            continue;
+        }
+
+        double tasa = total / t;
+        if (canales == 1) porCanalBase = tasa;
+        std::cout << "  canales " << canales << (canales < 10 ? "   " : "  ") << t << " s  "
+                  << static_cast<long long>(tasa) << " tramas/s  x"
+                  << (porCanalBase > 0 ? tasa / porCanalBase : 0.0) << " vs 1 canal" << std::endl;
+    }
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
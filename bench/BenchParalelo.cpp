@@ -0,0 +1,163 @@
+/**
+ * @file BenchParalelo.cpp
+ * @brief Escalamiento de DecodificadorParalelo de 1 a N hilos
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Genera una captura PRT-7 en disco (LOAD con un MAP cada ~10 tramas,
+ * lineas con "\r\n" como las envia el ESP32) y la decodifica:
+ * - "secuencial": FuenteMapeada + parsearTrama + procesarTrama, igual que
+ *   el bucle principal con --fuente=mmap:
+ * - "paralelo N": DecodificadorParalelo con 1, 2, 4, ... N hilos
+ *
+ * Cada resultado se compara byte a byte con el secuencial.
+ *
+ * Uso: bench_paralelo [megabytes] [hilos_maximos] [ruta_captura]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include "FuenteMapeada.h"
+#include "DecodificadorParalelo.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/**
+ * @brief Segundos transcurridos desde un instante
+ */
+static double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - inicio;
+    return d.count();
+}
+
+/**
+ * @brief Escribe una captura de aproximadamente 'bytes' bytes terminada en FIN
+ */
+static bool generarCaptura(const char* ruta, long long bytes) {
+    std::ofstream salida(ruta, std::ios::binary);
+    if (!salida) return false;
+
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    const int TAMANIO_BUFFER = 1 << 20;
+    char* buffer = new char[TAMANIO_BUFFER + 64];
+    unsigned int semilla = 12345;
+    long long escritos = 0;
+
+    salida << "=== Transmisor PRT-7 ===\r\n";
+    while (escritos < bytes) {
+        int n = 0;
+        while (n < TAMANIO_BUFFER) {
+            semilla = semilla * 1103515245u + 12345u;
+            unsigned int azar = semilla >> 16;
+            if (azar % 10 == 0) {
+                n += std::sprintf(buffer + n, "M,%d\r\n", static_cast<int>(azar % 61) - 30);
+            } else {
+                buffer[n++] = 'L';
+                buffer[n++] = ',';
+                buffer[n++] = alfabeto[azar % 27];
+                buffer[n++] = '\r';
+                buffer[n++] = '\n';
+            }
+        }
+        salida.write(buffer, n);
+        escritos += n;
+    }
+    salida << "FIN\r\n";
+
+    delete[] buffer;
+    return static_cast<bool>(salida);
+}
+
+/**
+ * @brief Copia el mensaje de una lista a un arreglo nuevo
+ */
+static char* copiar(const ListaDeCarga& lista) {
+    char* copia = new char[lista.getTamanio() + 1];
+    lista.copiarMensaje(copia, lista.getTamanio() + 1);
+    return copia;
+}
+
+int main(int argc, char* argv[]) {
+    long long megabytes = 256;
+    int hilosMaximos = static_cast<int>(std::thread::hardware_concurrency());
+    const char* ruta = "bench_paralelo.cap";
+
+    if (argc > 1 && std::atoll(argv[1]) > 0) megabytes = std::atoll(argv[1]);
+    if (argc > 2 && std::atoi(argv[2]) > 0) hilosMaximos = std::atoi(argv[2]);
+    if (argc > 3) ruta = argv[3];
+    if (hilosMaximos <= 0) hilosMaximos = 1;
+
+    // Sin eco de consola: se mide solo la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    std::cout << "Generando captura de " << megabytes << " MB en " << ruta << "..." << std::endl;
+    if (!generarCaptura(ruta, megabytes << 20)) {
+        std::cerr << "Error: No se pudo escribir " << ruta << std::endl;
+        return 1;
+    }
+
+    int errores = 0;
+
+    // Referencia secuencial (misma ruta que el bucle principal)
+    FuenteMapeada* captura = new FuenteMapeada(ruta);
+    double megas = captura->getTamanio() / 1e6;
+    ListaDeCarga referencia;
+    RotorDeMapeo rotor;
+    char linea[256];
+    Trama trama;
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    while (captura->estaConectado()) {
+        if (captura->leerLinea(linea, sizeof(linea)) > 0 && parsearTrama(linea, &trama)) {
+            if (trama.tipo == TRAMA_FIN) break;
+            procesarTrama(trama, &referencia, &rotor);
+        }
+    }
+    double tSecuencial = segundosDesde(inicio);
+    delete captura;
+
+    char* esperado = copiar(referencia);
+    std::cout << "Mensaje: " << referencia.getTamanio() << " caracteres, "
+              << std::thread::hardware_concurrency() << " nucleos" << std::endl;
+    std::cout << "  secuencial    " << tSecuencial << " s  " << megas / tSecuencial << " MB/s" << std::endl;
+
+    double tUnHilo = 0.0;
+    // 1, 2, 4, ... y al final hilosMaximos
+    for (int hilos = 1; hilos <= hilosMaximos;
+         hilos = (hilos < hilosMaximos && hilos * 2 > hilosMaximos) ? hilosMaximos : hilos * 2) {
+        captura = new FuenteMapeada(ruta);
+        ListaDeCarga lista;
+        RotorDeMapeo rotorParalelo;
+        DecodificadorParalelo paralelo(hilos);
+
+        inicio = std::chrono::steady_clock::now();
+        bool fin = paralelo.decodificar(captura, &lista, &rotorParalelo);
+        double t = segundosDesde(inicio);
+        delete captura;
+
+        char* obtenido = copiar(lista);
+        bool igual = fin && lista.getTamanio() == referencia.getTamanio()
+                     && std::memcmp(obtenido, esperado, lista.getTamanio()) == 0
+                     && rotorParalelo.getDesplazamiento() == rotor.getDesplazamiento();
+        if (!igual) errores++;
+        delete[] obtenido;
+
+        if (hilos == 1) tUnHilo = t;
+        std::cout << "  paralelo " << hilos << (hilos < 10 ? "    " : "   ") << t << " s  "
+                  << megas / t << " MB/s  x" << tSecuencial / t << " vs secuencial  x"
+                  << tUnHilo / t << " vs 1 hilo" << (igual ? "" : "  DISTINTO") << std::endl;
+    }
+
+    delete[] esperado;
+    std::remove(ruta);
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
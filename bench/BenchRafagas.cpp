@@ -0,0 +1,149 @@
+/**
+ * @file BenchRafagas.cpp
+ * @brief LOAD de un caracter contra rafagas "L,<caracteres>"
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Genera en memoria el mismo mensaje (un MAP cada ~40 caracteres) como:
+ *   - una trama "L,X\r\n" por caracter
+ *   - rafagas "L,XXXX...\r\n" de hasta N caracteres, cortadas en cada MAP
+ *
+ * y lo decodifica como el bucle principal sin eco (extraerLinea +
+ * interpretarTrama + procesarTrama). Reporta bytes en el enlace y lineas
+ * parseadas por caracter, y caracteres/s, para N = 1, 4, 16, 64 y 200.
+ * Todas las variantes deben dar el mismo mensaje.
+ *
+ * Uso: bench_rafagas [caracteres]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include "FuenteMapeada.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/**
+ * @brief Genera la captura con rafagas de hasta 'rafaga' caracteres
+ * @return Bytes escritos en datos
+ */
+static long long generarCaptura(char* datos, int caracteres, int rafaga, long long* lineas) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    unsigned int semilla = 99;
+    long long n = 0;
+    int enRafaga = 0;
+    *lineas = 0;
+
+    for (int i = 0; i < caracteres; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+
+        if (azar % 40 == 0) {
+            // Cerrar la rafaga abierta antes del MAP
+            if (enRafaga > 0) {
+                datos[n++] = '\r';
+                datos[n++] = '\n';
+                enRafaga = 0;
+            }
+            n += std::sprintf(datos + n, "M,%d\r\n", static_cast<int>(azar % 61) - 30);
+            (*lineas)++;
+        }
+
+        if (enRafaga == 0) {
+            datos[n++] = 'L';
+            datos[n++] = ',';
+            (*lineas)++;
+        }
+        datos[n++] = alfabeto[(azar >> 3) % 27];
+        if (++enRafaga == rafaga) {
+            datos[n++] = '\r';
+            datos[n++] = '\n';
+            enRafaga = 0;
+        }
+    }
+    if (enRafaga > 0) {
+        datos[n++] = '\r';
+        datos[n++] = '\n';
+    }
+    n += std::sprintf(datos + n, "FIN\r\n");
+    (*lineas)++;
+    return n;
+}
+
+/**
+ * @brief Decodifica la captura hasta el FIN
+ */
+static void decodificar(const char* datos, long long tamanio, ListaDeCarga* carga) {
+    RotorDeMapeo rotor;
+    char linea[256];
+    Trama trama;
+    unsigned long long posicion = 0;
+    unsigned long long total = static_cast<unsigned long long>(tamanio);
+
+    while (posicion < total) {
+        FuenteMapeada::extraerLinea(datos, total, &posicion, linea, sizeof(linea));
+        if (interpretarTrama(linea, &trama) != LINEA_VALIDA) continue;
+        if (trama.tipo == TRAMA_FIN) break;
+        procesarTrama(trama, carga, &rotor);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int caracteres = 20000000;
+    if (argc > 1 && std::atoi(argv[1]) > 0) caracteres = std::atoi(argv[1]);
+
+    // Sin eco de consola: se mide solo la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    // Peor caso: "L,X\r\n" por caracter y un "M,-30\r\n" cada ~40
+    char* datos = new char[static_cast<long long>(caracteres) * 6 + 64];
+    char* referencia = new char[caracteres + 1];
+    char* obtenido = new char[caracteres + 1];
+    int largoReferencia = 0;
+
+    const int rafagas[] = {1, 4, 16, 64, 200};
+    const int numRafagas = sizeof(rafagas) / sizeof(rafagas[0]);
+    double tasaBase = 0.0;
+    int errores = 0;
+
+    std::cout << caracteres << " caracteres" << std::endl;
+    for (int r = 0; r < numRafagas; r++) {
+        long long lineas = 0;
+        long long tamanio = generarCaptura(datos, caracteres, rafagas[r], &lineas);
+
+        ListaDeCarga carga;
+        carga.reservar(caracteres);
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        decodificar(datos, tamanio, &carga);
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        // La primera variante (un caracter por trama) es la referencia
+        bool distinto = false;
+        if (r == 0) {
+            largoReferencia = carga.copiarMensaje(referencia, caracteres + 1);
+        } else {
+            int largo = carga.copiarMensaje(obtenido, caracteres + 1);
+            distinto = largo != largoReferencia || std::memcmp(obtenido, referencia, largo) != 0;
+        }
+        if (distinto) errores++;
+
+        double tasa = carga.getTamanio() / t;
+        if (r == 0) tasaBase = tasa;
+        std::cout << "  rafaga " << rafagas[r] << (rafagas[r] < 10 ? "    " : rafagas[r] < 100 ? "   " : "  ")
+                  << static_cast<double>(tamanio) / caracteres << " bytes/caracter  "
+                  << static_cast<double>(lineas) / caracteres << " lineas/caracter  "
+                  << static_cast<long long>(tasa) << " caracteres/s  x" << tasa / tasaBase
+                  << (distinto ? "  DISTINTO" : "") << std::endl;
+    }
+
+    delete[] datos;
+    delete[] referencia;
+    delete[] obtenido;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,380 @@
+/**
+ * @file BenchRotor.cpp
+ * @brief Microbenchmark de decodificacion: rotor enlazado vs rotor indexado
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Genera un flujo sintetico de varios millones de tramas (LOAD y MAP) y lo
+ * decodifica con la implementacion original (lista circular recorrida nodo
+ * por nodo) y con el RotorDeMapeo actual (alfabeto contiguo + desplazamiento).
+ * Ambos resultados deben coincidir byte a byte.
+ *
+ * Despues compara la decodificacion por rachas de LOAD (entre dos MAP) byte
+ * a byte con getMapeo() contra RotorDeMapeo::decodificarBloque().
+ *
+ * Por ultimo mide, con trazas por trama (consola descartada), un flujo con
+ * rafagas de MAP entre cada LOAD con y sin rotacion diferida.
+ *
+ * Uso: bench_rotor [numero_de_tramas]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <streambuf>
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/**
+ * @class SalidaNula
+ * @brief Buffer de stream que descarta todo (se paga el formateo, no la terminal)
+ */
+class SalidaNula : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/**
+ * @class RotorEnlazadoLegado
+ * @brief Copia de referencia del rotor original (lista circular doble)
+ *
+ * Se conserva solo para medir el "antes"; no imprime nada al rotar.
+ */
+class RotorEnlazadoLegado {
+private:
+    struct Nodo {
+        char dato;
+        Nodo* siguiente;
+        Nodo* previo;
+        Nodo(char c) : dato(c), siguiente(nullptr), previo(nullptr) {}
+    };
+
+    Nodo* cabeza;
+
+    Nodo* buscarNodo(char c) {
+        Nodo* actual = cabeza;
+        do {
+            if (actual->dato == c) return actual;
+            actual = actual->siguiente;
+        } while (actual != cabeza);
+        return nullptr;
+    }
+
+    int calcularDistancia(Nodo* desde, Nodo* hasta) {
+        int distancia = 0;
+        Nodo* actual = desde;
+        while (actual != hasta) {
+            actual = actual->siguiente;
+            distancia++;
+            if (distancia > 100) break;
+        }
+        return distancia;
+    }
+
+public:
+    RotorEnlazadoLegado() {
+        const char alfabeto[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+        cabeza = new Nodo(alfabeto[0]);
+        Nodo* actual = cabeza;
+        for (int i = 1; i < 27; i++) {
+            Nodo* nuevo = new Nodo(alfabeto[i]);
+            actual->siguiente = nuevo;
+            nuevo->previo = actual;
+            actual = nuevo;
+        }
+        actual->siguiente = cabeza;
+        cabeza->previo = actual;
+    }
+
+    ~RotorEnlazadoLegado() {
+        cabeza->previo->siguiente = nullptr;
+        Nodo* actual = cabeza;
+        while (actual) {
+            Nodo* siguiente = actual->siguiente;
+            delete actual;
+            actual = siguiente;
+        }
+    }
+
+    void rotar(int n) {
+        n = n % 27;
+        if (n > 0) {
+            for (int i = 0; i < n; i++) cabeza = cabeza->siguiente;
+        } else if (n < 0) {
+            for (int i = 0; i > n; i--) cabeza = cabeza->previo;
+        }
+    }
+
+    char getMapeo(char in) {
+        Nodo* nodoOriginal = buscarNodo(in);
+        if (!nodoOriginal) return in;
+        int distancia = calcularDistancia(cabeza, nodoOriginal);
+        Nodo* resultado = buscarNodo('A');
+        for (int i = 0; i < distancia; i++) resultado = resultado->siguiente;
+        return resultado->dato;
+    }
+};
+
+/**
+ * @brief Trama sintetica ya parseada (tipo + dato)
+ */
+struct TramaSintetica {
+    char tipo;      ///< 'L' o 'M'
+    int valor;      ///< Caracter (LOAD) o rotacion (MAP)
+};
+
+/**
+ * @brief Generador congruencial simple para que el flujo sea reproducible
+ */
+static unsigned int siguienteAleatorio(unsigned int& estado) {
+    estado = estado * 1103515245u + 12345u;
+    return (estado >> 16) & 0x7FFF;
+}
+
+/**
+ * @brief Llena el arreglo con un flujo de tramas (1 MAP cada ~mapCada tramas)
+ */
+static void generarFlujo(TramaSintetica* tramas, int n, unsigned int mapCada) {
+    const char simbolos[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ .,";
+    unsigned int estado = 2025;
+
+    for (int i = 0; i < n; i++) {
+        if (siguienteAleatorio(estado) % mapCada == 0) {
+            tramas[i].tipo = 'M';
+            tramas[i].valor = static_cast<int>(siguienteAleatorio(estado) % 53) - 26;
+        } else {
+            tramas[i].tipo = 'L';
+            tramas[i].valor = simbolos[siguienteAleatorio(estado) % 29];
+        }
+    }
+}
+
+/**
+ * @brief Decodifica el flujo completo con el rotor indicado
+ * @return Tiempo en segundos
+ */
+template <typename Rotor>
+static double decodificar(Rotor& rotor, const TramaSintetica* tramas, int n, char* salida) {
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < n; i++) {
+        if (tramas[i].tipo == 'M') {
+            rotor.rotar(tramas[i].valor);
+        } else {
+            salida[i] = rotor.getMapeo(static_cast<char>(tramas[i].valor));
+        }
+    }
+
+    std::chrono::duration<double> duracion = std::chrono::steady_clock::now() - inicio;
+    return duracion.count();
+}
+
+/**
+ * @brief Verifica decodificarBloque contra getMapeo para los 256 bytes y las 27 cabezas
+ * @return Numero de bytes que no coinciden
+ */
+static int verificarBloque() {
+    char entrada[256 + 7];
+    char salida[256 + 7];
+    for (int i = 0; i < 256 + 7; i++) {
+        entrada[i] = static_cast<char>(i & 0xFF);
+    }
+
+    RotorDeMapeo rotor;
+    int diferencias = 0;
+    for (int c = 0; c < RotorDeMapeo::TAMANIO; c++) {
+        // Longitudes no multiplo de 16/32 para ejercitar tambien la cola escalar
+        for (int n = 250; n <= 256 + 7; n += 13) {
+            rotor.decodificarBloque(entrada, salida, n);
+            for (int i = 0; i < n; i++) {
+                if (salida[i] != rotor.getMapeo(entrada[i])) diferencias++;
+            }
+        }
+        rotor.rotar(1);
+    }
+    return diferencias;
+}
+
+/**
+ * @brief Decodifica lineas con trazas por trama hacia una salida nula
+ * @param diferida Rotacion diferida activada
+ * @return Tiempo en segundos
+ */
+static double decodificarConTrazas(const char* lineas, int n, ListaDeCarga* carga, bool diferida) {
+    SalidaNula nula;
+    std::streambuf* consola = std::cout.rdbuf(&nula);
+    establecerNivelDetalle(DETALLE_TRAMA);
+    establecerRotacionDiferida(diferida);
+
+    RotorDeMapeo rotor;
+    Trama trama;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        if (parsearTrama(lineas + i * 8, &trama)) {
+            procesarTrama(trama, carga, &rotor);
+        }
+    }
+    std::chrono::duration<double> duracion = std::chrono::steady_clock::now() - inicio;
+
+    establecerRotacionDiferida(false);
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+    std::cout.rdbuf(consola);
+    return duracion.count();
+}
+
+/**
+ * @brief Decodifica rachas de LOAD separadas por MAP
+ * @param porBloque true = decodificarBloque, false = getMapeo byte a byte
+ * @return Tiempo en segundos
+ */
+static double decodificarRachas(const char* cargas, const int* finRacha, const int* rotaciones,
+                                int numRachas, char* salida, bool porBloque) {
+    RotorDeMapeo rotor;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+    int pos = 0;
+    for (int r = 0; r < numRachas; r++) {
+        int n = finRacha[r] - pos;
+        if (porBloque) {
+            rotor.decodificarBloque(cargas + pos, salida + pos, n);
+        } else {
+            for (int i = pos; i < finRacha[r]; i++) salida[i] = rotor.getMapeo(cargas[i]);
+        }
+        pos = finRacha[r];
+        rotor.rotar(rotaciones[r]);
+    }
+
+    std::chrono::duration<double> duracion = std::chrono::steady_clock::now() - inicio;
+    return duracion.count();
+}
+
+int main(int argc, char* argv[]) {
+    int n = 4000000;
+    if (argc > 1) {
+        n = std::atoi(argv[1]);
+        if (n <= 0) n = 4000000;
+    }
+
+    TramaSintetica* tramas = new TramaSintetica[n];
+    char* salidaLegado = new char[n];
+    char* salidaActual = new char[n];
+    generarFlujo(tramas, n, 16);
+
+    // Sin trazas de consola durante las mediciones
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    RotorEnlazadoLegado legado;
+    double tLegado = decodificar(legado, tramas, n, salidaLegado);
+
+    RotorDeMapeo actual;
+    double tActual = decodificar(actual, tramas, n, salidaActual);
+
+    // Verificar que ambas implementaciones producen el mismo mensaje
+    int diferencias = 0;
+    for (int i = 0; i < n; i++) {
+        if (tramas[i].tipo == 'L' && salidaLegado[i] != salidaActual[i]) diferencias++;
+    }
+
+    std::cout << "Tramas decodificadas: " << n << std::endl;
+    std::cout << "Rotor enlazado (antes):  " << tLegado << " s  -> "
+              << (n / tLegado) / 1e6 << " Mtramas/s" << std::endl;
+    std::cout << "Rotor indexado (ahora):  " << tActual << " s  -> "
+              << (n / tActual) / 1e6 << " Mtramas/s" << std::endl;
+    std::cout << "Aceleracion: " << tLegado / tActual << "x" << std::endl;
+    std::cout << "Diferencias: " << diferencias << std::endl;
+
+    // Rachas de LOAD largas (1 MAP cada ~512 tramas, como en las capturas):
+    // compactar los bytes y registrar donde termina cada racha
+    generarFlujo(tramas, n, 512);
+    char* cargas = new char[n];
+    int* finRacha = new int[n + 1];
+    int* rotaciones = new int[n + 1];
+    int numCargas = 0;
+    int numRachas = 0;
+    for (int i = 0; i < n; i++) {
+        if (tramas[i].tipo == 'M') {
+            finRacha[numRachas] = numCargas;
+            rotaciones[numRachas] = tramas[i].valor;
+            numRachas++;
+        } else {
+            cargas[numCargas++] = static_cast<char>(tramas[i].valor);
+        }
+    }
+    finRacha[numRachas] = numCargas;
+    rotaciones[numRachas] = 0;
+    numRachas++;
+
+    double tEscalar = decodificarRachas(cargas, finRacha, rotaciones, numRachas, salidaLegado, false);
+    double tBloque = decodificarRachas(cargas, finRacha, rotaciones, numRachas, salidaActual, true);
+    int diferenciasTabla = verificarBloque();
+
+    for (int i = 0; i < numCargas; i++) {
+        if (salidaLegado[i] != salidaActual[i]) diferencias++;
+    }
+    diferencias += diferenciasTabla;
+
+    std::cout << std::endl;
+    std::cout << "Rachas LOAD: " << numRachas << " (" << numCargas << " bytes)" << std::endl;
+    std::cout << "getMapeo byte a byte:    " << tEscalar << " s  -> "
+              << (numCargas / tEscalar) / 1e6 << " MB/s" << std::endl;
+    std::cout << "decodificarBloque:       " << tBloque << " s  -> "
+              << (numCargas / tBloque) / 1e6 << " MB/s" << std::endl;
+    std::cout << "Aceleracion: " << tEscalar / tBloque << "x" << std::endl;
+    std::cout << "Diferencias (rachas + tabla 256x27): " << diferencias << std::endl;
+
+    // Rafagas de 8 MAP por cada LOAD (generador que "sacude" el rotor)
+    const int RAFAGA = 8;
+    int numLineas = n / 16;
+    char* lineas = new char[static_cast<long long>(numLineas) * 8];
+    unsigned int estado = 99;
+    for (int i = 0; i < numLineas; i++) {
+        if (i % (RAFAGA + 1) == RAFAGA) {
+            std::sprintf(lineas + i * 8, "L,%c", static_cast<char>('A' + siguienteAleatorio(estado) % 26));
+        } else {
+            std::sprintf(lineas + i * 8, "M,%d", static_cast<int>(siguienteAleatorio(estado) % 53) - 26);
+        }
+    }
+
+    ListaDeCarga cargaInmediata;
+    ListaDeCarga cargaDiferida;
+    double tInmediata = decodificarConTrazas(lineas, numLineas, &cargaInmediata, false);
+    double tDiferida = decodificarConTrazas(lineas, numLineas, &cargaDiferida, true);
+
+    int tamTrazas = cargaInmediata.getTamanio();
+    int diferenciasTrazas = tamTrazas == cargaDiferida.getTamanio() ? 0 : 1;
+    if (diferenciasTrazas == 0) {
+        char* a = new char[tamTrazas + 1];
+        char* b = new char[tamTrazas + 1];
+        cargaInmediata.copiarMensaje(a, tamTrazas + 1);
+        cargaDiferida.copiarMensaje(b, tamTrazas + 1);
+        for (int i = 0; i < tamTrazas; i++) {
+            if (a[i] != b[i]) diferenciasTrazas++;
+        }
+        delete[] a;
+        delete[] b;
+    }
+    diferencias += diferenciasTrazas;
+
+    std::cout << std::endl;
+    std::cout << "Rafagas de " << RAFAGA << " MAP por LOAD con trazas: " << numLineas << " tramas" << std::endl;
+    std::cout << "Rotacion inmediata:      " << tInmediata << " s  -> "
+              << (numLineas / tInmediata) / 1e6 << " Mtramas/s" << std::endl;
+    std::cout << "Rotacion diferida:       " << tDiferida << " s  -> "
+              << (numLineas / tDiferida) / 1e6 << " Mtramas/s" << std::endl;
+    std::cout << "Aceleracion: " << tInmediata / tDiferida << "x" << std::endl;
+    std::cout << "Diferencias: " << diferenciasTrazas << std::endl;
+
+    delete[] lineas;
+    delete[] cargas;
+    delete[] finRacha;
+    delete[] rotaciones;
+    delete[] tramas;
+    delete[] salidaLegado;
+    delete[] salidaActual;
+
+    return diferencias == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file BenchSesiones.cpp
+ * @brief Decodificacion de miles de sesiones multiplexadas en un enlace
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Genera en memoria un flujo con el mismo numero total de tramas repartido
+ * entre 1, 10, 100, ... N sesiones intercaladas al azar ("#id,L,X",
+ * "#id,M,N" y un "#id,FIN" por sesion) y lo decodifica como el bucle
+ * principal con --sesiones: interpretarTrama() + TablaDeSesiones.
+ *
+ * La medicion no verifica nada; despues, una segunda pasada compara el
+ * mensaje de cada sesion (al llegar su FIN) con el hash FNV-1a calculado al
+ * generar el flujo.
+ *
+ * Uso: bench_sesiones [tramas_totales] [sesiones_maximas]
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include "TablaDeSesiones.h"
+#include "FuenteMapeada.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+/// Separacion entre ids, para que no sean consecutivos
+static const unsigned int PASO_ID = 7919;
+
+/**
+ * @brief Agrega un caracter al hash FNV-1a
+ */
+static unsigned int fnv(unsigned int hash, char c) {
+    return (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+}
+
+/**
+ * @brief Genera el flujo multiplexado y el hash esperado de cada sesion
+ * @return Bytes escritos en datos
+ */
+static long long generarFlujo(char* datos, int tramas, int sesiones, unsigned int* esperados) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    int* pendientes = new int[sesiones];     // tramas que faltan por sesion
+    int* abiertas = new int[sesiones];       // indices de sesiones sin FIN
+    RotorDeMapeo* rotores = new RotorDeMapeo[sesiones];
+    int numAbiertas = sesiones;
+
+    for (int i = 0; i < sesiones; i++) {
+        pendientes[i] = tramas / sesiones;
+        abiertas[i] = i;
+        esperados[i] = 2166136261u;
+    }
+
+    unsigned int semilla = 4242;
+    long long n = 0;
+    while (numAbiertas > 0) {
+        semilla = semilla * 1103515245u + 12345u;
+        int k = static_cast<int>((semilla >> 8) % static_cast<unsigned int>(numAbiertas));
+        int s = abiertas[k];
+        unsigned int id = static_cast<unsigned int>(s) * PASO_ID + 1;
+
+        if (pendientes[s] == 0) {
+            n += std::sprintf(datos + n, "#%u,FIN\n", id);
+            abiertas[k] = abiertas[--numAbiertas];
+            continue;
+        }
+        pendientes[s]--;
+
+        unsigned int azar = semilla >> 16;
+        if (azar % 10 == 0) {
+            int rotacion = static_cast<int>(azar % 61) - 30;
+            n += std::sprintf(datos + n, "#%u,M,%d\n", id, rotacion);
+            rotores[s].setDesplazamiento(rotores[s].getDesplazamiento() + rotacion % RotorDeMapeo::TAMANIO);
+        } else {
+            char c = alfabeto[azar % 27];
+            n += std::sprintf(datos + n, "#%u,L,%c\n", id, c);
+            esperados[s] = fnv(esperados[s], rotores[s].getMapeo(c));
+        }
+    }
+
+    delete[] pendientes;
+    delete[] abiertas;
+    delete[] rotores;
+    return n;
+}
+
+/**
+ * @brief Decodifica el flujo; si esperados no es nullptr verifica cada sesion
+ * @return Sesiones con mensaje distinto
+ */
+static int decodificar(const char* datos, long long tamanio, const unsigned int* esperados,
+                       unsigned long long* tramasValidas, int* maximoActivas) {
+    TablaDeSesiones tabla;
+    char linea[256];
+    char* mensaje = nullptr;
+    int capacidadMensaje = 0;
+    Trama trama;
+    int distintas = 0;
+    unsigned long long posicion = 0;
+    unsigned long long total = static_cast<unsigned long long>(tamanio);
+
+    *tramasValidas = 0;
+    while (posicion < total) {
+        FuenteMapeada::extraerLinea(datos, total, &posicion, linea, sizeof(linea));
+        if (interpretarTrama(linea, &trama) != LINEA_VALIDA) continue;
+        (*tramasValidas)++;
+
+        Sesion* sesion = tabla.obtener(trama.sesion);
+        if (trama.tipo != TRAMA_FIN) {
+            TablaDeSesiones::aplicar(sesion, trama);
+            continue;
+        }
+
+        if (esperados) {
+            TablaDeSesiones::completar(sesion);
+            int largo = sesion->carga.getTamanio();
+            if (largo + 1 > capacidadMensaje) {
+                delete[] mensaje;
+                capacidadMensaje = 2 * (largo + 1);
+                mensaje = new char[capacidadMensaje];
+            }
+            sesion->carga.copiarMensaje(mensaje, capacidadMensaje);
+            unsigned int hash = 2166136261u;
+            for (int i = 0; i < largo; i++) {
+                hash = fnv(hash, mensaje[i]);
+            }
+            if (hash != esperados[(sesion->id - 1) / PASO_ID]) distintas++;
+        }
+        tabla.cerrar(sesion);
+    }
+
+    // Toda sesion debe haber llegado a su FIN
+    distintas += tabla.getActivas();
+    *maximoActivas = tabla.getMaximoActivas();
+    delete[] mensaje;
+    return distintas;
+}
+
+int main(int argc, char* argv[]) {
+    int tramas = 4000000;
+    int sesionesMaximas = 100000;
+
+    if (argc > 1 && std::atoi(argv[1]) > 0) tramas = std::atoi(argv[1]);
+    if (argc > 2 && std::atoi(argv[2]) > 0) sesionesMaximas = std::atoi(argv[2]);
+
+    // Sin eco de consola: se mide solo la decodificacion
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+    establecerSesionesMultiplexadas(true);
+
+    // "#999999999,M,-30\n" = 17 bytes por trama, mas un FIN por sesion
+    char* datos = new char[static_cast<long long>(tramas + sesionesMaximas) * 20 + 64];
+    unsigned int* esperados = new unsigned int[sesionesMaximas];
+
+    std::cout << tramas << " tramas en total" << std::endl;
+
+    int errores = 0;
+    double tasaUnaSesion = 0.0;
+    for (int sesiones = 1; sesiones <= sesionesMaximas;
+         sesiones = (sesiones < sesionesMaximas && sesiones * 10 > sesionesMaximas) ? sesionesMaximas : sesiones * 10) {
+        long long tamanio = generarFlujo(datos, tramas, sesiones, esperados);
+
+        unsigned long long validas = 0;
+        int maximo = 0;
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        decodificar(datos, tamanio, nullptr, &validas, &maximo);
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        int distintas = decodificar(datos, tamanio, esperados, &validas, &maximo);
+        errores += distintas;
+
+        double tasa = validas / t;
+        if (sesiones == 1) tasaUnaSesion = tasa;
+        std::cout << "  sesiones " << sesiones << "  " << t << " s  " << static_cast<long long>(tasa)
+                  << " tramas/s  x" << (tasaUnaSesion > 0 ? tasa / tasaUnaSesion : 0.0)
+                  << " vs 1 sesion  maximo " << maximo << " simultaneas"
+                  << (distintas ? "  DISTINTO" : "") << std::endl;
+    }
+
+    delete[] datos;
+    delete[] esperados;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file EmuladorESP32.cpp
+ * @brief Emulador de trafico del ESP32 para pruebas de carga (POSIX)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Escribe el trafico de GeneradorDeTramas en una pseudo-terminal (el
+ * decodificador abre el esclavo como si fuera el puerto del ESP32), en la
+ * salida estandar (para una tuberia con --fuente=stdin) o en un archivo o
+ * FIFO. Envia las lineas en lotes, a la tasa pedida o tan rapido como el
+ * lector las acepte, y puede guardar el mensaje esperado para compararlo
+ * con la salida del decodificador. Con --marcas antepone a cada linea su
+ * instante de envio "@<us>," como el firmware en modo con marcas, para
+ * probar --latencia-enlace sin la placa.
+ *
+ * Ejemplos:
+ * @code
+ * emulador_esp32 --caracteres=5000000 --rafaga=16 --basura=2 --esperado=esperado.txt
+ *     (imprime "Esclavo: /dev/pts/N" en stderr)
+ * DecodificadorPRT7 --puerto=/dev/pts/N --detalle=silencioso | head -n 1 | cmp - esperado.txt
+ *
+ * emulador_esp32 --salida=- --map=30 --tasa=200000 --esperado=esperado.txt \
+ *     | DecodificadorPRT7 --fuente=stdin --detalle=silencioso > salida.txt
+ * head -n 1 salida.txt | cmp - esperado.txt
+ *
+ * emulador_esp32 --marcas --tasa=2000 --lote=1 --caracteres=20000
+ *     (en otra terminal)
+ * DecodificadorPRT7 --puerto=/dev/pts/N --detalle=silencioso --latencia-enlace
+ * @endcode
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include "GeneradorDeTramas.h"
+
+/// Bytes del prefijo "@<us>," mas largo (micros() de 32 bits, como en el ESP32)
+const int LARGO_MARCA = 12;
+
+/**
+ * @brief Muestra las opciones de linea de comandos
+ */
+static void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " [--salida=pty|-|RUTA] [--caracteres=N] [--map=PCT] [--rotacion=R]" << std::endl;
+    std::cerr << "       [--rafaga=N] [--basura=PCT] [--tasa=TRAMAS_POR_S] [--lote=N] [--semilla=N]" << std::endl;
+    std::cerr << "       [--esperado=RUTA] [--espera=MS] [--sin-fin] [--marcas] [--baudios=N]" << std::endl;
+    std::cerr << "  --salida     pty (por defecto): pseudo-terminal; -: salida estandar; RUTA: archivo o FIFO" << std::endl;
+    std::cerr << "  --caracteres Largo del mensaje (por defecto 1000000)" << std::endl;
+    std::cerr << "  --map        Probabilidad de un MAP antes de cada LOAD, en % (por defecto 10)" << std::endl;
+    std::cerr << "  --rotacion   Los MAP rotan entre -R y +R (por defecto 30)" << std::endl;
+    std::cerr << "  --rafaga     Hasta N caracteres por LOAD, \"L,XYZ\" (por defecto 1, maximo "
+              << GeneradorDeTramas::RAFAGA_MAXIMA << ")" << std::endl;
+    std::cerr << "  --basura     Probabilidad de una linea de banner antes de cada trama, en %" << std::endl;
+    std::cerr << "  --tasa       Lineas por segundo (0 = tan rapido como las acepte el lector)" << std::endl;
+    std::cerr << "  --lote       Lineas por escritura (por defecto 64)" << std::endl;
+    std::cerr << "  --esperado   Guardar el mensaje esperado (una linea, como --detalle=silencioso)" << std::endl;
+    std::cerr << "  --espera     Con pty, milisegundos antes de empezar a enviar (por defecto 1000)" << std::endl;
+    std::cerr << "  --sin-fin    No enviar la trama FIN" << std::endl;
+    std::cerr << "  --marcas     Anteponer \"@<us>,\" a cada linea (microsegundos desde el arranque, modulo 2^32);" << std::endl;
+    std::cerr << "               la rafaga se limita a " << GeneradorDeTramas::RAFAGA_MAXIMA - LARGO_MARCA
+              << " para que la linea siga cabiendo" << std::endl;
+    std::cerr << "  --baudios    Entregar cada lote cuando lo habria terminado de transmitir una UART 8N1" << std::endl;
+    std::cerr << "               a N baudios (una pseudo-terminal no limita la velocidad)" << std::endl;
+}
+
+/**
+ * @brief Escribe todos los bytes
+ * @return false si el lector cerro o hubo error
+ */
+static bool escribirTodo(int fd, const char* datos, int n) {
+    while (n > 0) {
+        ssize_t escritos = write(fd, datos, static_cast<size_t>(n));
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        datos += escritos;
+        n -= static_cast<int>(escritos);
+    }
+    return true;
+}
+
+/**
+ * @brief Abre una pseudo-terminal y deja el esclavo abierto en modo crudo
+ *
+ * Mientras el emulador tenga el esclavo abierto, lo enviado antes de que
+ * el decodificador lo abra espera en el driver sin eco ni edicion de linea.
+ *
+ * @return Descriptor del maestro, o -1 si fallo
+ */
+static int abrirPseudoTerminal(int* esclavo) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0) return -1;
+    if (grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        close(maestro);
+        return -1;
+    }
+
+    const char* ruta = ptsname(maestro);
+    *esclavo = open(ruta, O_RDWR | O_NOCTTY);
+    if (*esclavo < 0) {
+        close(maestro);
+        return -1;
+    }
+    struct termios opciones;
+    if (tcgetattr(*esclavo, &opciones) == 0) {
+        cfmakeraw(&opciones);
+        tcsetattr(*esclavo, TCSANOW, &opciones);
+    }
+
+    std::cerr << "Esclavo: " << ruta << std::endl;
+    return maestro;
+}
+
+/**
+ * @brief Genera todo el trafico sin enviarlo y guarda el mensaje esperado
+ * @return false si no se pudo escribir el archivo
+ */
+static bool guardarEsperado(const ConfiguracionTrafico& configuracion, const char* ruta) {
+    GeneradorDeTramas generador(configuracion);
+    char linea[GeneradorDeTramas::LINEA_MAXIMA];
+    while (generador.siguienteLinea(linea) > 0) {
+    }
+
+    FILE* archivo = std::fopen(ruta, "wb");
+    if (!archivo) return false;
+    std::fwrite(generador.getEsperado(), 1, static_cast<size_t>(generador.getLongitudEsperada()), archivo);
+    std::fputc('\n', archivo);
+    return std::fclose(archivo) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    ConfiguracionTrafico configuracion;
+    const char* salida = "pty";
+    const char* rutaEsperado = nullptr;
+    long long tasa = 0;
+    int lote = 64;
+    int esperaMs = 1000;
+    bool conMarcas = false;
+    long long baudios = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (std::strncmp(a, "--salida=", 9) == 0 && a[9] != '\0') {
+            salida = a + 9;
+        } else if (std::strncmp(a, "--caracteres=", 13) == 0) {
+            configuracion.caracteres = std::atoll(a + 13);
+        } else if (std::strncmp(a, "--map=", 6) == 0) {
+            configuracion.porcentajeMap = std::atoi(a + 6);
+        } else if (std::strncmp(a, "--rotacion=", 11) == 0) {
+            configuracion.rotacionMaxima = std::atoi(a + 11);
+        } else if (std::strncmp(a, "--rafaga=", 9) == 0) {
+            configuracion.rafagaMaxima = std::atoi(a + 9);
+        } else if (std::strncmp(a, "--basura=", 9) == 0) {
+            configuracion.porcentajeBasura = std::atoi(a + 9);
+        } else if (std::strncmp(a, "--tasa=", 7) == 0) {
+            tasa = std::atoll(a + 7);
+        } else if (std::strncmp(a, "--lote=", 7) == 0 && std::atoi(a + 7) > 0) {
+            lote = std::atoi(a + 7);
+        } else if (std::strncmp(a, "--semilla=", 10) == 0) {
+            configuracion.semilla = static_cast<unsigned int>(std::strtoul(a + 10, nullptr, 10));
+        } else if (std::strncmp(a, "--esperado=", 11) == 0 && a[11] != '\0') {
+            rutaEsperado = a + 11;
+        } else if (std::strncmp(a, "--espera=", 9) == 0) {
+            esperaMs = std::atoi(a + 9);
+        } else if (std::strcmp(a, "--sin-fin") == 0) {
+            configuracion.conFin = false;
+        } else if (std::strcmp(a, "--marcas") == 0) {
+            conMarcas = true;
+        } else if (std::strncmp(a, "--baudios=", 10) == 0 && std::atoll(a + 10) > 0) {
+            baudios = std::atoll(a + 10);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+
+    // Con la marca, la linea mas larga debe seguir cabiendo en el buffer del decodificador
+    if (conMarcas && configuracion.rafagaMaxima > GeneradorDeTramas::RAFAGA_MAXIMA - LARGO_MARCA) {
+        configuracion.rafagaMaxima = GeneradorDeTramas::RAFAGA_MAXIMA - LARGO_MARCA;
+    }
+
+    // El mensaje esperado se guarda antes de enviar (una pasada aparte con
+    // la misma semilla), para poder compararlo apenas termine el decodificador
+    if (rutaEsperado && !guardarEsperado(configuracion, rutaEsperado)) {
+        std::cerr << "Error: no se pudo crear " << rutaEsperado << std::endl;
+        return 1;
+    }
+
+    // Un lector que cierra la tuberia termina el envio, no el proceso
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::chrono::steady_clock::time_point arranque = std::chrono::steady_clock::now();
+    int fd = -1;
+    int esclavo = -1;
+    bool esPty = std::strcmp(salida, "pty") == 0;
+    if (esPty) {
+        fd = abrirPseudoTerminal(&esclavo);
+    } else if (std::strcmp(salida, "-") == 0) {
+        fd = STDOUT_FILENO;
+    } else {
+        fd = open(salida, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd < 0) {
+        std::cerr << "Error: no se pudo abrir la salida " << salida << " (" << std::strerror(errno) << ")" << std::endl;
+        return 1;
+    }
+    if (esPty && esperaMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(esperaMs));
+    }
+
+    GeneradorDeTramas generador(configuracion);
+    char* buffer = new char[static_cast<long long>(lote) * (GeneradorDeTramas::LINEA_MAXIMA + LARGO_MARCA)];
+    unsigned long long lineas = 0;
+    bool lectorAbierto = true;
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point finTransmision = inicio;
+    while (lectorAbierto && !generador.estaTerminado()) {
+        // Armar un lote y enviarlo con una sola escritura
+        int n = 0;
+        int enLote = 0;
+        while (enLote < lote) {
+            if (conMarcas && !generador.estaTerminado()) {
+                // Reloj propio del "ESP32": origen al arrancar, vuelta a los 2^32 us
+                unsigned int marca = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - arranque).count());
+                n += std::sprintf(buffer + n, "@%u,", marca);
+            }
+            int bytes = generador.siguienteLinea(buffer + n);
+            if (bytes == 0) break;
+            n += bytes;
+            enLote++;
+        }
+
+        // La UART empieza cuando termino el lote anterior y tarda 10 bits por byte
+        if (baudios > 0) {
+            std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+            if (finTransmision < ahora) finTransmision = ahora;
+            finTransmision += std::chrono::nanoseconds(static_cast<long long>(n) * 10 * 1000000000LL / baudios);
+            std::this_thread::sleep_until(finTransmision);
+        }
+        lectorAbierto = escribirTodo(fd, buffer, n);
+        lineas += static_cast<unsigned long long>(enLote);
+
+        // Con tasa fija: dormir hasta que toque el siguiente lote
+        if (tasa > 0) {
+            std::this_thread::sleep_until(inicio + std::chrono::microseconds(
+                static_cast<long long>(lineas * 1000000ULL / static_cast<unsigned long long>(tasa))));
+        }
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (esPty) {
+        // Esperar a que el decodificador lea lo pendiente antes de colgar
+        std::chrono::steady_clock::time_point limite = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        int pendientes = 0;
+        while (ioctl(esclavo, FIONREAD, &pendientes) == 0 && pendientes > 0
+               && std::chrono::steady_clock::now() < limite) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(esclavo);
+        close(fd);
+    } else if (fd != STDOUT_FILENO) {
+        close(fd);
+    }
+
+    std::cerr << "Emulador: " << generador.getTramas() << " tramas, " << generador.getLineasBasura()
+              << " lineas de basura, " << generador.getBytes() << " bytes en " << segundos << " s ("
+              << static_cast<long long>(segundos > 0 ? generador.getTramas() / segundos : 0) << " tramas/s, "
+              << (segundos > 0 ? generador.getBytes() / segundos / 1e6 : 0.0) << " MB/s)"
+              << (lectorAbierto ? "" : " - el lector cerro antes del final") << std::endl;
+
+    delete[] buffer;
+    return lectorAbierto ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file PruebaDiario.cpp
+ * @brief Prueba de --diario con el decodificador interrumpido (POSIX)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Lanza DecodificadorPRT7 leyendo de una FIFO con --diario, le escribe
+ * tramas sin cerrar la FIFO (el enlace sigue abierto, como un puerto
+ * callado) y lo interrumpe:
+ *
+ * - SIGINT con un intervalo de un minuto: solo el punto de control final
+ *   puede guardar las tramas, asi que el proceso debe salir del bucle y
+ *   escribirlo. Otra ejecucion con el mismo diario y una trama FIN debe
+ *   imprimir el mensaje completo.
+ * - SIGKILL con un intervalo de 50 ms: no hay punto final, las ultimas
+ *   tramas deben haber llegado al diario por el vencimiento del intervalo
+ *   con el enlace en reposo, y reanudar con FIN debe imprimirlas.
+ *
+ * Uso: prueba_diario RUTA_DEL_DECODIFICADOR
+ *
+ * Deja prueba_diario.fifo, prueba_diario.dia y la salida de la ultima
+ * reanudacion (prueba_diario.txt) en el directorio actual.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+static const char* RUTA_FIFO = "prueba_diario.fifo";
+static const char* RUTA_DIARIO = "prueba_diario.dia";
+
+/**
+ * @brief Lanza el decodificador con la salida en 'salida' (o descartada si es -1)
+ * @return pid del hijo, -1 si fork() fallo
+ */
+static pid_t lanzar(const char* decodificador, const char* fuente, const char* intervalo, int salida) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    int nulo = open("/dev/null", O_WRONLY);
+    dup2(salida >= 0 ? salida : nulo, 1);
+    dup2(nulo, 2);
+
+    char argFuente[256];
+    char argDiario[256];
+    char argIntervalo[64];
+    std::snprintf(argFuente, sizeof(argFuente), "--fuente=%s", fuente);
+    std::snprintf(argDiario, sizeof(argDiario), "--diario=%s", RUTA_DIARIO);
+    std::snprintf(argIntervalo, sizeof(argIntervalo), "--diario-intervalo=%s", intervalo);
+    char* argumentos[] = {const_cast<char*>(decodificador), argFuente, argDiario, argIntervalo,
+                          const_cast<char*>("--detalle=silencioso"), nullptr};
+    execv(decodificador, argumentos);
+    _exit(127);
+}
+
+/**
+ * @brief Escribe n veces la misma linea
+ */
+static bool escribirLineas(int fd, const char* linea, int n) {
+    int largo = static_cast<int>(std::strlen(linea));
+    for (int i = 0; i < n; i++) {
+        if (write(fd, linea, largo) != largo) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si el archivo contiene la secuencia de bytes
+ */
+static bool archivoContiene(const char* ruta, const char* buscado) {
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat estado;
+    if (fstat(fd, &estado) != 0) {
+        close(fd);
+        return false;
+    }
+    long long tamanio = static_cast<long long>(estado.st_size);
+    char* contenido = new char[tamanio + 1];
+    long long leidos = 0;
+    while (leidos < tamanio) {
+        ssize_t n = read(fd, contenido + leidos, static_cast<size_t>(tamanio - leidos));
+        if (n <= 0) break;
+        leidos += n;
+    }
+    close(fd);
+
+    long long largo = static_cast<long long>(std::strlen(buscado));
+    bool encontrado = false;
+    for (long long i = 0; i + largo <= leidos && !encontrado; i++) {
+        encontrado = std::memcmp(contenido + i, buscado, largo) == 0;
+    }
+    delete[] contenido;
+    return encontrado;
+}
+
+/**
+ * @brief Alimenta la FIFO, espera y envia la senal
+ * @return true si el decodificador salio con codigo 0 (o murio por SIGKILL si se pidio)
+ */
+static bool interrumpir(const char* decodificador, const char* intervalo, int senal,
+                        const char* primeras, int cantidadPrimeras, const char* ultimas, int cantidadUltimas) {
+    char fuente[256];
+    std::snprintf(fuente, sizeof(fuente), "archivo:%s", RUTA_FIFO);
+    pid_t pid = lanzar(decodificador, fuente, intervalo, -1);
+    if (pid < 0) return false;
+
+    // Bloquea hasta que el decodificador abra la FIFO
+    int fifo = open(RUTA_FIFO, O_WRONLY);
+    if (fifo < 0) {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        return false;
+    }
+
+    bool escrito = escribirLineas(fifo, primeras, cantidadPrimeras);
+    usleep(300000);
+    escrito = escrito && escribirLineas(fifo, ultimas, cantidadUltimas);
+    usleep(300000);
+
+    kill(pid, senal);
+    int estado = 0;
+    waitpid(pid, &estado, 0);
+    close(fifo);
+
+    if (senal == SIGKILL) {
+        return escrito && WIFSIGNALED(estado);
+    }
+    return escrito && WIFEXITED(estado) && WEXITSTATUS(estado) == 0;
+}
+
+/**
+ * @brief Reanuda el diario con una trama FIN y verifica el mensaje
+ */
+static bool reanudar(const char* decodificador, const char* esperado) {
+    const char* rutaFin = "prueba_diario.fin";
+    const char* rutaSalida = "prueba_diario.txt";
+    int fin = open(rutaFin, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fin < 0 || write(fin, "FIN\n", 4) != 4) return false;
+    close(fin);
+
+    int salida = open(rutaSalida, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (salida < 0) return false;
+    char fuente[256];
+    std::snprintf(fuente, sizeof(fuente), "archivo:%s", rutaFin);
+    pid_t pid = lanzar(decodificador, fuente, "60000", salida);
+    close(salida);
+    if (pid < 0) return false;
+
+    int estado = 0;
+    waitpid(pid, &estado, 0);
+    return WIFEXITED(estado) && WEXITSTATUS(estado) == 0 && archivoContiene(rutaSalida, esperado);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Uso: " << argv[0] << " RUTA_DEL_DECODIFICADOR" << std::endl;
+        return 2;
+    }
+    const char* decodificador = argv[1];
+    int errores = 0;
+
+    unlink(RUTA_FIFO);
+    if (mkfifo(RUTA_FIFO, 0600) != 0) {
+        std::cerr << "Error: No se pudo crear " << RUTA_FIFO << std::endl;
+        return 1;
+    }
+
+    // SIGINT: el punto de control final guarda las ultimas tramas
+    unlink(RUTA_DIARIO);
+    bool salio = interrumpir(decodificador, "60000", SIGINT, "L,A\n", 900, "L,Q\n", 10);
+    bool guardado = archivoContiene(RUTA_DIARIO, "AQQQQQQQQQQ");
+    bool completo = reanudar(decodificador, "AQQQQQQQQQQ");
+    std::cout << "  SIGINT   salida " << (salio ? "ok" : "ERROR") << ", ultimas tramas en el diario "
+              << (guardado ? "ok" : "ERROR") << ", mensaje reanudado " << (completo ? "ok" : "ERROR") << std::endl;
+    if (!salio || !guardado || !completo) errores++;
+
+    // SIGKILL: sin punto final, el intervalo vence con el enlace en reposo
+    // (las tramas quedan repartidas en varios registros 'D', se verifican reanudando)
+    unlink(RUTA_DIARIO);
+    bool murio = interrumpir(decodificador, "50", SIGKILL, "L,B\n", 100, "L,Z\n", 5);
+    completo = reanudar(decodificador, "BZZZZZ");
+    std::cout << "  SIGKILL  ultimas tramas en el diario " << (murio && completo ? "ok" : "ERROR") << std::endl;
+    if (!murio || !completo) errores++;
+
+    unlink(RUTA_FIFO);
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file PruebaLineasLargas.cpp
+ * @brief Prueba de lineas mas largas que el buffer de leerLinea() (POSIX)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Una linea de TAMANIO_LINEA + 3 bytes ("L,AAA...AL,ZZZ") seguida de FIN
+ * llega al puerto en un solo write(), asi que su '\n' ya esta en el anillo
+ * cuando se busca. La fuente debe entregarla en trozos de bufferSize - 1
+ * sin perder el final (ver FuenteDeTramas).
+ *
+ * La misma captura en un archivo se lee con archivo:RUTA y con mmap:RUTA;
+ * ademas de reconstruir la linea, ambas deben entregar los mismos trozos.
+ *
+ * Uso: prueba_lineas_largas
+ *
+ * Deja prueba_lineas_largas.txt en el directorio actual.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include "FuenteDeTramas.h"
+#include "NivelDetalle.h"
+
+static const int TAMANIO_LINEA = 256;      ///< Mismo buffer de linea que el bucle principal
+static const int INTENTOS = 20;            ///< Lecturas sin linea antes de rendirse
+
+/**
+ * @brief Arma la linea larga y la captura completa (linea, FIN)
+ */
+static void armarCaptura(char* linea, char* captura) {
+    int n = 0;
+    linea[n++] = 'L';
+    linea[n++] = ',';
+    while (n < TAMANIO_LINEA - 2) linea[n++] = 'A';
+    std::memcpy(linea + n, "L,ZZZ", 5);
+    n += 5;
+    linea[n] = '\0';
+    std::strcpy(captura, linea);
+    std::strcat(captura, "\r\nFIN\r\n");
+}
+
+/**
+ * @brief Lee hasta FIN y verifica que los trozos reconstruyen la linea
+ * @param trozos Si no es nullptr, recibe los trozos separados por '\n'
+ */
+static bool verificarFuente(FuenteDeTramas* fuente, const char* linea, char* trozos = nullptr) {
+    char buffer[TAMANIO_LINEA];
+    char reconstruida[TAMANIO_LINEA * 4];
+    int largo = 0;
+    int largoTrozos = 0;
+    bool trozosValidos = true;
+
+    for (int vacias = 0; vacias < INTENTOS && fuente->estaConectado();) {
+        int n = fuente->leerLinea(buffer, TAMANIO_LINEA);
+        if (n == 0) {
+            vacias++;
+            continue;
+        }
+        if (std::strcmp(buffer, "FIN") == 0) break;
+        if (n > TAMANIO_LINEA - 1 || largo + n >= static_cast<int>(sizeof(reconstruida))) {
+            trozosValidos = false;
+            break;
+        }
+        std::memcpy(reconstruida + largo, buffer, n);
+        largo += n;
+        if (trozos) {
+            std::memcpy(trozos + largoTrozos, buffer, n);
+            largoTrozos += n;
+            trozos[largoTrozos++] = '\n';
+        }
+    }
+    reconstruida[largo] = '\0';
+    if (trozos) trozos[largoTrozos] = '\0';
+    return trozosValidos && std::strcmp(reconstruida, linea) == 0;
+}
+
+/**
+ * @brief Envia la captura por una pseudo-terminal en un solo write()
+ */
+static bool probarSerial(const char* linea, const char* captura) {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0) return false;
+    if (grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        close(maestro);
+        return false;
+    }
+
+    FuenteDeTramas* puerto = crearFuenteDeTramas("serial", ptsname(maestro));
+    int largo = static_cast<int>(std::strlen(captura));
+    bool correcto = puerto != nullptr && puerto->estaConectado()
+                    && write(maestro, captura, largo) == largo
+                    && verificarFuente(puerto, linea);
+    delete puerto;
+    close(maestro);
+    return correcto;
+}
+
+/**
+ * @brief Lee la captura desde un archivo con la fuente 'tipo' ("archivo" o "mmap")
+ */
+static bool probarArchivo(const char* tipo, const char* ruta, const char* linea, char* trozos) {
+    char especificacion[256];
+    std::strcpy(especificacion, tipo);
+    std::strcat(especificacion, ":");
+    std::strcat(especificacion, ruta);
+
+    FuenteDeTramas* fuente = crearFuenteDeTramas(especificacion, nullptr);
+    bool correcto = fuente != nullptr && fuente->estaConectado() && verificarFuente(fuente, linea, trozos);
+    delete fuente;
+    return correcto;
+}
+
+int main() {
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    char linea[TAMANIO_LINEA + 8];
+    char captura[TAMANIO_LINEA + 16];
+    armarCaptura(linea, captura);
+
+    int errores = 0;
+    bool serial = probarSerial(linea, captura);
+    std::cout << "  serial   " << (serial ? "ok" : "ERROR") << std::endl;
+    if (!serial) errores++;
+
+    const char* ruta = "prueba_lineas_largas.txt";
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int largo = static_cast<int>(std::strlen(captura));
+    bool escrito = fd >= 0 && write(fd, captura, largo) == largo;
+    if (fd >= 0) close(fd);
+
+    char trozosArchivo[TAMANIO_LINEA * 4];
+    char trozosMapeados[TAMANIO_LINEA * 4];
+    bool archivo = escrito && probarArchivo("archivo", ruta, linea, trozosArchivo);
+    bool mapeado = escrito && probarArchivo("mmap", ruta, linea, trozosMapeados);
+    bool iguales = archivo && mapeado && std::strcmp(trozosArchivo, trozosMapeados) == 0;
+    std::cout << "  archivo  " << (archivo ? "ok" : "ERROR") << std::endl;
+    std::cout << "  mmap     " << (mapeado ? "ok" : "ERROR") << std::endl;
+    std::cout << "  archivo y mmap con los mismos trozos " << (iguales ? "ok" : "ERROR") << std::endl;
+    if (!archivo) errores++;
+    if (!mapeado) errores++;
+    if (!iguales) errores++;
+
+    std::cout << "Errores: " << errores << std::endl;
+    return errores == 0 ? 0 : 1;
+}
@@ -0,0 +1,551 @@
+/**
+ * @file SuiteBenchmarks.cpp
+ * @brief Suite de microbenchmarks reproducibles con salida legible por maquina
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * A diferencia de los bench_* de comparacion (antes/despues de una
+ * optimizacion), esta suite mide siempre los mismos casos con los mismos
+ * datos para seguir regresiones entre versiones:
+ *
+ * - rotor/getMapeo y rotor/decodificarBloque con la cabeza en varias posiciones
+ * - rotor/rotar con rotaciones de varios tamanios
+ * - lista/insertarAlFinal y lista/imprimirMensaje con mensajes de varios tamanios
+ * - parser/parsearTrama con mezclas de LOAD, MAP y basura
+ * - extremo/decodificacion: captura de GeneradorDeTramas decodificada como el
+ *   bucle principal (extraerLinea + parsearTrama + procesarTrama)
+ *
+ * Todos los datos salen de semillas fijas. Cada caso se ejecuta una vez de
+ * calentamiento y luego N veces; se reportan el minimo y la mediana de ns por
+ * operacion, y un valor de control (hash del resultado) que debe ser el mismo
+ * en todas las maquinas y versiones: si cambia, cambio el comportamiento.
+ *
+ * Uso: bench_suite [--formato=texto|csv|json] [--salida=RUTA] [--repeticiones=N] [--filtro=PREFIJO]
+ *
+ * Con --formato=csv o json sin --salida, la salida estandar lleva solo ese
+ * formato. Con --salida la tabla va a la terminal y el archivo recibe el csv
+ * o, si el formato es texto, el json (el objetivo "benchmarks" de CMake
+ * escribe asi benchmarks.json en el directorio de build).
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include "FuenteMapeada.h"
+#include "GeneradorDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+
+#ifndef PRT7_VERSION
+#define PRT7_VERSION "desconocida"
+#endif
+
+/**
+ * @class SalidaNula
+ * @brief Buffer de stream que descarta todo (se paga el formateo, no la terminal)
+ */
+class SalidaNula : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/**
+ * @brief Una ejecucion medida de un caso
+ * @param parametro Parametro del caso (desplazamiento, tamanio, mezcla...)
+ * @param operaciones Destino de las operaciones medidas
+ * @param control Destino del hash del resultado
+ * @return Segundos de la region medida (sin la preparacion)
+ */
+typedef double (*FuncionCaso)(long long parametro, long long* operaciones, unsigned long long* control);
+
+/**
+ * @struct Caso
+ * @brief Caso de la suite
+ */
+struct Caso {
+    const char* nombre;     ///< "grupo/funcion"
+    long long parametro;    ///< Parametro del caso
+    FuncionCaso funcion;    ///< Ejecucion medida
+};
+
+/**
+ * @struct Resultado
+ * @brief Medicion de un caso
+ */
+struct Resultado {
+    const char* nombre;             ///< Nombre del caso
+    long long parametro;            ///< Parametro del caso
+    long long operaciones;          ///< Operaciones por ejecucion
+    double nsMinimo;                ///< Mejor ns por operacion
+    double nsMediana;               ///< Mediana de ns por operacion
+    unsigned long long control;     ///< Hash del resultado
+};
+
+/**
+ * @brief FNV-1a de 64 bits sobre un bloque
+ */
+static unsigned long long fnv(unsigned long long hash, const char* datos, long long n) {
+    for (long long i = 0; i < n; i++) {
+        hash ^= static_cast<unsigned char>(datos[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static const unsigned long long FNV_INICIAL = 14695981039346656037ULL;  ///< Base de FNV-1a
+
+/**
+ * @brief Bytes al azar del alfabeto con algunos signos (semilla fija)
+ */
+static void generarTexto(char* destino, long long n, unsigned int semilla) {
+    const char simbolos[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ .,0123456789";
+    for (long long i = 0; i < n; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        destino[i] = simbolos[(semilla >> 16) % (sizeof(simbolos) - 1)];
+    }
+}
+
+/**
+ * @brief Hash del mensaje de una lista
+ */
+static unsigned long long hashLista(const ListaDeCarga& lista) {
+    int n = lista.getTamanio();
+    char* copia = new char[n + 1];
+    lista.copiarMensaje(copia, n + 1);
+    unsigned long long hash = fnv(FNV_INICIAL, copia, n);
+    delete[] copia;
+    return hash;
+}
+
+static const long long BYTES_ROTOR = 1 << 20;  ///< Bytes por ejecucion de los casos del rotor
+
+/**
+ * @brief getMapeo byte a byte con la cabeza en 'parametro'
+ */
+static double casoGetMapeo(long long parametro, long long* operaciones, unsigned long long* control) {
+    char* entrada = new char[BYTES_ROTOR];
+    char* salida = new char[BYTES_ROTOR];
+    generarTexto(entrada, BYTES_ROTOR, 7);
+    RotorDeMapeo rotor;
+    rotor.setDesplazamiento(static_cast<int>(parametro));
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (long long i = 0; i < BYTES_ROTOR; i++) {
+        salida[i] = rotor.getMapeo(entrada[i]);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    *operaciones = BYTES_ROTOR;
+    *control = fnv(FNV_INICIAL, salida, BYTES_ROTOR);
+    delete[] entrada;
+    delete[] salida;
+    return segundos;
+}
+
+/**
+ * @brief decodificarBloque con la cabeza en 'parametro'
+ */
+static double casoDecodificarBloque(long long parametro, long long* operaciones, unsigned long long* control) {
+    char* entrada = new char[BYTES_ROTOR];
+    char* salida = new char[BYTES_ROTOR];
+    generarTexto(entrada, BYTES_ROTOR, 7);
+    RotorDeMapeo rotor;
+    rotor.setDesplazamiento(static_cast<int>(parametro));
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    rotor.decodificarBloque(entrada, salida, static_cast<int>(BYTES_ROTOR));
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    *operaciones = BYTES_ROTOR;
+    *control = fnv(FNV_INICIAL, salida, BYTES_ROTOR);
+    delete[] entrada;
+    delete[] salida;
+    return segundos;
+}
+
+/**
+ * @brief rotar() alternando +parametro y -(parametro + 1), sin trazas
+ */
+static double casoRotar(long long parametro, long long* operaciones, unsigned long long* control) {
+    const long long ROTACIONES = 1 << 20;
+    RotorDeMapeo rotor;
+    int adelante = static_cast<int>(parametro);
+    int atras = -static_cast<int>(parametro + 1);
+    unsigned long long suma = 0;
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (long long i = 0; i < ROTACIONES; i += 2) {
+        rotor.rotar(adelante);
+        suma += static_cast<unsigned long long>(rotor.getDesplazamiento());
+        rotor.rotar(atras);
+        suma += static_cast<unsigned long long>(rotor.getDesplazamiento());
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    *operaciones = ROTACIONES;
+    *control = suma;
+    return segundos;
+}
+
+/**
+ * @brief insertarAlFinal de 'parametro' caracteres en una lista nueva
+ */
+static double casoInsertar(long long parametro, long long* operaciones, unsigned long long* control) {
+    char* texto = new char[parametro];
+    generarTexto(texto, parametro, 11);
+    ListaDeCarga* lista = new ListaDeCarga();
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (long long i = 0; i < parametro; i++) {
+        lista->insertarAlFinal(texto[i]);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    *operaciones = parametro;
+    *control = hashLista(*lista);
+    delete lista;
+    delete[] texto;
+    return segundos;
+}
+
+/**
+ * @brief imprimirMensaje de una lista de 'parametro' caracteres (salida nula)
+ *
+ * Cada operacion es un mensaje completo; se repite hasta unos 4 MB impresos.
+ */
+static double casoImprimir(long long parametro, long long* operaciones, unsigned long long* control) {
+    char* texto = new char[parametro];
+    generarTexto(texto, parametro, 13);
+    ListaDeCarga* lista = new ListaDeCarga();
+    lista->insertarBloque(texto, static_cast<int>(parametro));
+
+    SalidaNula nula;
+    std::streambuf* consola = std::cout.rdbuf(&nula);
+    const int VECES = static_cast<int>((1 << 22) / parametro) + 1;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (int v = 0; v < VECES; v++) {
+        lista->imprimirMensaje();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout.rdbuf(consola);
+
+    *operaciones = VECES;
+    *control = hashLista(*lista);
+    delete lista;
+    delete[] texto;
+    return segundos;
+}
+
+/// Mezclas de lineas para parsearTrama (porcentajes de LOAD, MAP y basura)
+enum MezclaParser { MEZCLA_LOAD, MEZCLA_MAP, MEZCLA_BASURA, MEZCLA_MIXTA, NUM_MEZCLAS };
+
+static const char* const NOMBRES_MEZCLA[NUM_MEZCLAS] = {"load", "map", "basura", "mixta"};
+static const int PORCENTAJES_MEZCLA[NUM_MEZCLAS][2] = {
+    {100, 0},   // solo LOAD
+    {0, 100},   // solo MAP
+    {0, 0},     // solo basura
+    {70, 20}    // 70% LOAD, 20% MAP, 10% basura
+};
+
+/**
+ * @brief parsearTrama sobre lineas de la mezcla 'parametro' (sin trazas)
+ */
+static double casoParsear(long long parametro, long long* operaciones, unsigned long long* control) {
+    const int LINEAS = 1 << 18;
+    const int ANCHO = 16;
+    const char* basura[] = {"========", "  ESP32 banner", "Iniciando...", "X,1", "L", ""};
+    const int numBasura = sizeof(basura) / sizeof(basura[0]);
+    char* lineas = new char[static_cast<long long>(LINEAS) * ANCHO];
+
+    unsigned int semilla = 17;
+    for (int i = 0; i < LINEAS; i++) {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 16;
+        int tirada = static_cast<int>(azar % 100);
+        char* linea = lineas + static_cast<long long>(i) * ANCHO;
+        if (tirada < PORCENTAJES_MEZCLA[parametro][0]) {
+            std::sprintf(linea, "L,%c", 'A' + static_cast<int>((azar >> 7) % 26));
+        } else if (tirada < PORCENTAJES_MEZCLA[parametro][0] + PORCENTAJES_MEZCLA[parametro][1]) {
+            std::sprintf(linea, "M,%d", static_cast<int>((azar >> 7) % 61) - 30);
+        } else {
+            std::strcpy(linea, basura[(azar >> 7) % numBasura]);
+        }
+    }
+
+    // La basura deja un aviso por linea en stderr: se descarta
+    SalidaNula nula;
+    std::streambuf* errores = std::cerr.rdbuf(&nula);
+    Trama trama;
+    unsigned long long suma = FNV_INICIAL;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < LINEAS; i++) {
+        if (parsearTrama(lineas + static_cast<long long>(i) * ANCHO, &trama)) {
+            int valor = trama.tipo == TRAMA_LOAD ? trama.caracter : (trama.tipo == TRAMA_MAP ? trama.rotacion : 0);
+            suma = suma * 31 + static_cast<unsigned long long>(trama.tipo * 1000 + valor);
+        }
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cerr.rdbuf(errores);
+
+    *operaciones = LINEAS;
+    *control = suma;
+    delete[] lineas;
+    return segundos;
+}
+
+/**
+ * @brief Decodifica una captura sintetica con rafagas de hasta 'parametro' caracteres
+ *
+ * El control es el hash del mensaje, y la ejecucion falla (control 0) si no
+ * coincide con el mensaje esperado del generador.
+ */
+static double casoDecodificacion(long long parametro, long long* operaciones, unsigned long long* control) {
+    ConfiguracionTrafico configuracion;
+    configuracion.caracteres = 1 << 20;
+    configuracion.porcentajeMap = 10;
+    configuracion.rafagaMaxima = static_cast<int>(parametro);
+    configuracion.porcentajeBasura = 1;
+    configuracion.semilla = 2025;
+
+    // "L,X\r\n" por caracter mas los MAP y la basura caben holgados en 16 bytes por caracter
+    GeneradorDeTramas generador(configuracion);
+    long long capacidad = 16 * (configuracion.caracteres + 1);
+    char* captura = new char[capacidad];
+    long long tamanio = 0;
+    while (tamanio + GeneradorDeTramas::LINEA_MAXIMA < capacidad) {
+        int n = generador.siguienteLinea(captura + tamanio);
+        if (n == 0) break;
+        tamanio += n;
+    }
+
+    SalidaNula nula;
+    std::streambuf* errores = std::cerr.rdbuf(&nula);
+    ListaDeCarga* carga = new ListaDeCarga();
+    carga->reservar(static_cast<int>(configuracion.caracteres));
+    RotorDeMapeo rotor;
+    char linea[256];
+    Trama trama;
+    unsigned long long posicion = 0;
+    unsigned long long total = static_cast<unsigned long long>(tamanio);
+    long long tramas = 0;
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    while (posicion < total) {
+        FuenteMapeada::extraerLinea(captura, total, &posicion, linea, sizeof(linea));
+        if (!parsearTrama(linea, &trama)) continue;
+        tramas++;
+        if (trama.tipo == TRAMA_FIN) break;
+        procesarTrama(trama, carga, &rotor);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cerr.rdbuf(errores);
+
+    bool correcto = carga->getTamanio() == generador.getLongitudEsperada()
+                    && hashLista(*carga) == fnv(FNV_INICIAL, generador.getEsperado(), generador.getLongitudEsperada());
+    *operaciones = tramas;
+    *control = correcto ? hashLista(*carga) : 0;
+    delete carga;
+    delete[] captura;
+    return segundos;
+}
+
+static const Caso CASOS[] = {
+    {"rotor/getMapeo", 0, casoGetMapeo},
+    {"rotor/getMapeo", 1, casoGetMapeo},
+    {"rotor/getMapeo", 13, casoGetMapeo},
+    {"rotor/getMapeo", 26, casoGetMapeo},
+    {"rotor/decodificarBloque", 0, casoDecodificarBloque},
+    {"rotor/decodificarBloque", 13, casoDecodificarBloque},
+    {"rotor/rotar", 1, casoRotar},
+    {"rotor/rotar", 13, casoRotar},
+    {"rotor/rotar", 1000, casoRotar},
+    {"lista/insertarAlFinal", 1000, casoInsertar},
+    {"lista/insertarAlFinal", 65536, casoInsertar},
+    {"lista/insertarAlFinal", 1048576, casoInsertar},
+    {"lista/imprimirMensaje", 1000, casoImprimir},
+    {"lista/imprimirMensaje", 65536, casoImprimir},
+    {"lista/imprimirMensaje", 1048576, casoImprimir},
+    {"parser/parsearTrama", MEZCLA_LOAD, casoParsear},
+    {"parser/parsearTrama", MEZCLA_MAP, casoParsear},
+    {"parser/parsearTrama", MEZCLA_BASURA, casoParsear},
+    {"parser/parsearTrama", MEZCLA_MIXTA, casoParsear},
+    {"extremo/decodificacion", 1, casoDecodificacion},
+    {"extremo/decodificacion", 16, casoDecodificacion},
+};
+static const int NUM_CASOS = sizeof(CASOS) / sizeof(CASOS[0]);
+
+/**
+ * @brief Parametro como texto (las mezclas del parser van por nombre)
+ */
+static const char* textoParametro(const Resultado& r, char* buffer) {
+    if (std::strcmp(r.nombre, "parser/parsearTrama") == 0) {
+        return NOMBRES_MEZCLA[r.parametro];
+    }
+    std::sprintf(buffer, "%lld", r.parametro);
+    return buffer;
+}
+
+/**
+ * @brief Ejecuta un caso: calentamiento + repeticiones
+ * @return false si el control cambio entre ejecuciones (resultado no reproducible)
+ */
+static bool ejecutarCaso(const Caso& caso, int repeticiones, Resultado* resultado) {
+    double* nsPorOperacion = new double[repeticiones];
+    long long operaciones = 0;
+    unsigned long long control = 0;
+    caso.funcion(caso.parametro, &operaciones, &control);
+
+    bool estable = true;
+    for (int r = 0; r < repeticiones; r++) {
+        unsigned long long controlRepeticion = 0;
+        double segundos = caso.funcion(caso.parametro, &operaciones, &controlRepeticion);
+        nsPorOperacion[r] = segundos * 1e9 / static_cast<double>(operaciones > 0 ? operaciones : 1);
+        if (controlRepeticion != control) estable = false;
+    }
+
+    // Insercion: pocas repeticiones
+    for (int i = 1; i < repeticiones; i++) {
+        double valor = nsPorOperacion[i];
+        int j = i - 1;
+        while (j >= 0 && nsPorOperacion[j] > valor) {
+            nsPorOperacion[j + 1] = nsPorOperacion[j];
+            j--;
+        }
+        nsPorOperacion[j + 1] = valor;
+    }
+
+    resultado->nombre = caso.nombre;
+    resultado->parametro = caso.parametro;
+    resultado->operaciones = operaciones;
+    resultado->nsMinimo = nsPorOperacion[0];
+    resultado->nsMediana = repeticiones % 2 == 1
+        ? nsPorOperacion[repeticiones / 2]
+        : (nsPorOperacion[repeticiones / 2 - 1] + nsPorOperacion[repeticiones / 2]) / 2;
+    resultado->control = control;
+    delete[] nsPorOperacion;
+    return estable && control != 0;
+}
+
+/**
+ * @brief Escribe los resultados como CSV
+ */
+static void escribirCsv(std::ostream& salida, const Resultado* resultados, int n) {
+    char buffer[32];
+    salida << "caso,parametro,operaciones,ns_por_op_min,ns_por_op_mediana,ops_por_s,control" << std::endl;
+    for (int i = 0; i < n; i++) {
+        const Resultado& r = resultados[i];
+        salida << r.nombre << ',' << textoParametro(r, buffer) << ',' << r.operaciones << ','
+               << std::fixed << std::setprecision(3) << r.nsMinimo << ',' << r.nsMediana << ','
+               << std::setprecision(0) << 1e9 / r.nsMinimo << ','
+               << std::hex << r.control << std::dec << std::endl;
+    }
+}
+
+/**
+ * @brief Escribe los resultados como JSON
+ */
+static void escribirJson(std::ostream& salida, const Resultado* resultados, int n, int repeticiones) {
+    char buffer[32];
+    salida << "{\n  \"version\": \"" << PRT7_VERSION << "\",\n  \"repeticiones\": " << repeticiones
+           << ",\n  \"unidad\": \"ns_por_op\",\n  \"resultados\": [\n";
+    for (int i = 0; i < n; i++) {
+        const Resultado& r = resultados[i];
+        salida << "    {\"caso\": \"" << r.nombre << "\", \"parametro\": \"" << textoParametro(r, buffer)
+               << "\", \"operaciones\": " << r.operaciones
+               << std::fixed << std::setprecision(3)
+               << ", \"min\": " << r.nsMinimo << ", \"mediana\": " << r.nsMediana
+               << std::setprecision(0) << ", \"ops_por_s\": " << 1e9 / r.nsMinimo
+               << ", \"control\": \"" << std::hex << r.control << std::dec << "\"}"
+               << (i + 1 < n ? "," : "") << "\n";
+    }
+    salida << "  ]\n}" << std::endl;
+}
+
+/**
+ * @brief Escribe la tabla para leer en la terminal
+ */
+static void escribirTexto(std::ostream& salida, const Resultado* resultados, int n) {
+    char buffer[32];
+    salida << std::left << std::setw(26) << "caso" << std::setw(10) << "parametro" << std::right
+           << std::setw(12) << "ops" << std::setw(12) << "ns/op min" << std::setw(12) << "mediana"
+           << std::setw(12) << "Mops/s" << "  control" << std::endl;
+    for (int i = 0; i < n; i++) {
+        const Resultado& r = resultados[i];
+        salida << std::left << std::setw(26) << r.nombre << std::setw(10) << textoParametro(r, buffer) << std::right
+               << std::setw(12) << r.operaciones << std::fixed << std::setprecision(3)
+               << std::setw(12) << r.nsMinimo << std::setw(12) << r.nsMediana
+               << std::setprecision(1) << std::setw(12) << 1e3 / r.nsMinimo
+               << "  " << std::hex << r.control << std::dec << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* formato = "texto";
+    const char* rutaSalida = nullptr;
+    const char* filtro = "";
+    int repeticiones = 5;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (std::strncmp(a, "--formato=", 10) == 0
+            && (std::strcmp(a + 10, "texto") == 0 || std::strcmp(a + 10, "csv") == 0 || std::strcmp(a + 10, "json") == 0)) {
+            formato = a + 10;
+        } else if (std::strncmp(a, "--salida=", 9) == 0 && a[9] != '\0') {
+            rutaSalida = a + 9;
+        } else if (std::strncmp(a, "--repeticiones=", 15) == 0 && std::atoi(a + 15) > 0) {
+            repeticiones = std::atoi(a + 15);
+        } else if (std::strncmp(a, "--filtro=", 9) == 0) {
+            filtro = a + 9;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--formato=texto|csv|json] [--salida=RUTA]"
+                      << " [--repeticiones=N] [--filtro=PREFIJO]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Sin trazas: se mide el trabajo, no la consola
+    establecerNivelDetalle(DETALLE_SILENCIOSO);
+
+    Resultado resultados[NUM_CASOS];
+    int n = 0;
+    int inestables = 0;
+    for (int c = 0; c < NUM_CASOS; c++) {
+        if (std::strncmp(CASOS[c].nombre, filtro, std::strlen(filtro)) != 0) continue;
+        if (!ejecutarCaso(CASOS[c], repeticiones, &resultados[n])) {
+            std::cerr << "Aviso: " << CASOS[c].nombre << " (" << CASOS[c].parametro
+                      << ") dio resultados distintos entre ejecuciones o incorrectos" << std::endl;
+            inestables++;
+        }
+        n++;
+    }
+
+    // La tabla va siempre a la terminal; csv/json a --salida o en su lugar
+    bool maquina = std::strcmp(formato, "texto") != 0;
+    if (!maquina || rutaSalida) {
+        escribirTexto(std::cout, resultados, n);
+    }
+    if (maquina || rutaSalida) {
+        std::ofstream archivo;
+        if (rutaSalida) {
+            archivo.open(rutaSalida);
+            if (!archivo) {
+                std::cerr << "Error: no se pudo crear " << rutaSalida << std::endl;
+                return 1;
+            }
+        }
+        std::ostream& salida = rutaSalida ? static_cast<std::ostream&>(archivo) : std::cout;
+        if (std::strcmp(formato, "csv") == 0) {
+            escribirCsv(salida, resultados, n);
+        } else {
+            escribirJson(salida, resultados, n, repeticiones);
+        }
+    }
+    return inestables == 0 ? 0 : 1;
+}
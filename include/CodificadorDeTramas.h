@@ -0,0 +1,111 @@
+/**
+ * @file CodificadorDeTramas.h
+ * @brief Codificador PRT-7: texto en claro + calendario de rotaciones -> tramas
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Es el lado del ESP32 hecho en el host: cifra con el mismo RotorDeMapeo
+ * (RotorDeMapeo::codificarBloque(), la inversa de decodificarBloque()) y
+ * escribe las lineas "L,...", "M,n" y "FIN" que el decodificador convierte
+ * de vuelta en el texto original.
+ */
+
+#ifndef CODIFICADOR_DE_TRAMAS_H
+#define CODIFICADOR_DE_TRAMAS_H
+
+#include "RotorDeMapeo.h"
+
+/**
+ * @struct RotacionProgramada
+ * @brief Un MAP del calendario de rotaciones
+ */
+struct RotacionProgramada {
+    long long posicion;     ///< Caracteres del texto ya enviados cuando se emite el MAP
+    int rotacion;           ///< Posiciones a rotar
+};
+
+/**
+ * @class CodificadorDeTramas
+ * @brief Convierte texto en claro en un flujo de tramas PRT-7
+ *
+ * El texto puede tener cualquier byte salvo '\0', '\r' y '\n' (que
+ * cortarian la linea); los que no son A-Z ni espacio viajan sin cifrar,
+ * igual que los deja pasar el decodificador. Cada linea termina en "\r\n",
+ * como las de Serial.println().
+ */
+class CodificadorDeTramas {
+public:
+    static const int RAFAGA_MAXIMA = 250;   ///< Caracteres por LOAD que caben en el buffer de 256 del decodificador
+
+private:
+    RotorDeMapeo rotor;             ///< Rotor de cifrado (mismo estado que el del decodificador)
+    int rafagaMaxima;               ///< Caracteres por trama LOAD
+    unsigned long long tramas;      ///< Tramas escritas
+
+public:
+    /**
+     * @brief Constructor
+     * @param rafaga Caracteres por LOAD (1 = "L,X"; se acota a RAFAGA_MAXIMA)
+     */
+    CodificadorDeTramas(int rafaga = 1);
+
+    /**
+     * @brief Escribe el texto como tramas LOAD de hasta rafagaMaxima caracteres
+     * @param texto Texto en claro
+     * @param n Caracteres
+     * @param destino Al menos capacidadNecesaria(n, 0, rafaga) bytes
+     * @return Bytes escritos
+     */
+    long long escribirCarga(const char* texto, long long n, char* destino);
+
+    /**
+     * @brief Escribe una trama MAP y rota el rotor de cifrado
+     * @return Bytes escritos (a lo sumo 16)
+     */
+    int escribirMapa(int rotacion, char* destino);
+
+    /**
+     * @brief Escribe la trama FIN
+     * @return Bytes escritos (5)
+     */
+    int escribirFin(char* destino);
+
+    /**
+     * @brief Codifica un mensaje completo siguiendo un calendario de rotaciones
+     *
+     * Los MAP se emiten en el orden del calendario (posiciones no
+     * decrecientes) justo antes del caracter indicado; los que caen despues
+     * del final del texto se emiten antes del FIN.
+     *
+     * @param texto Texto en claro
+     * @param n Caracteres
+     * @param calendario Rotaciones ordenadas por posicion
+     * @param numRotaciones Entradas del calendario
+     * @param conFin Terminar con la trama FIN
+     * @param destino Al menos capacidadNecesaria(n, numRotaciones, rafaga) bytes
+     * @return Bytes escritos
+     */
+    long long codificar(const char* texto, long long n, const RotacionProgramada* calendario,
+                        int numRotaciones, bool conFin, char* destino);
+
+    /**
+     * @brief Bytes suficientes para codificar n caracteres con numRotaciones MAP y FIN
+     */
+    static long long capacidadNecesaria(long long n, int numRotaciones, int rafaga);
+
+    /**
+     * @brief Tramas escritas
+     */
+    unsigned long long getTramas() const;
+
+    /**
+     * @brief Desplazamiento actual del rotor de cifrado
+     */
+    int getDesplazamiento() const;
+
+private:
+    CodificadorDeTramas(const CodificadorDeTramas&);
+    CodificadorDeTramas& operator=(const CodificadorDeTramas&);
+};
+
+#endif // CODIFICADOR_DE_TRAMAS_H
@@ -0,0 +1,129 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular acotada sin bloqueos para un productor y un consumidor
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <atomic>
+
+/**
+ * @class ColaSPSC
+ * @brief Buffer circular de N elementos compartido por exactamente dos hilos
+ *
+ * El productor escribe directamente en la siguiente ranura libre
+ * (reservarEscritura + confirmarEscritura) y el consumidor lee en su lugar
+ * (frenteLectura + liberarLectura), sin copias ni memoria dinamica. Solo se
+ * sincronizan los dos contadores con acquire/release.
+ *
+ * Tambien lleva la profundidad maxima alcanzada y cuantos elementos se
+ * descartaron por encontrar la cola llena, para observar la contrapresion.
+ *
+ * @tparam T Tipo del elemento (se guarda por valor)
+ * @tparam N Capacidad (potencia de 2)
+ */
+template <typename T, unsigned int N>
+class ColaSPSC {
+private:
+    static_assert((N & (N - 1)) == 0, "La capacidad de ColaSPSC debe ser potencia de 2");
+
+    T elementos[N];                         ///< Ranuras de la cola
+    std::atomic<unsigned int> lectura;      ///< Elementos consumidos (lo escribe el consumidor)
+    std::atomic<unsigned int> escritura;    ///< Elementos producidos (lo escribe el productor)
+    std::atomic<unsigned int> maxima;       ///< Profundidad maxima observada
+    std::atomic<unsigned long long> descartados;  ///< Elementos perdidos por cola llena
+
+public:
+    /**
+     * @brief Constructor - Cola vacia
+     */
+    ColaSPSC() : lectura(0), escritura(0), maxima(0), descartados(0) {}
+
+    /**
+     * @brief (Productor) Obtiene la siguiente ranura libre
+     * @return Ranura donde escribir, o nullptr si la cola esta llena
+     */
+    T* reservarEscritura() {
+        unsigned int e = escritura.load(std::memory_order_relaxed);
+        if (e - lectura.load(std::memory_order_acquire) == N) {
+            return nullptr;
+        }
+        return &elementos[e & (N - 1)];
+    }
+
+    /**
+     * @brief (Productor) Publica la ranura obtenida con reservarEscritura()
+     */
+    void confirmarEscritura() {
+        unsigned int e = escritura.load(std::memory_order_relaxed) + 1;
+        escritura.store(e, std::memory_order_release);
+
+        unsigned int profundidad = e - lectura.load(std::memory_order_relaxed);
+        if (profundidad > maxima.load(std::memory_order_relaxed)) {
+            maxima.store(profundidad, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief (Productor) Registra un elemento que no cupo en la cola
+     */
+    void registrarDescarte() {
+        descartados.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief (Consumidor) Obtiene el elemento mas antiguo sin sacarlo
+     * @return Elemento, o nullptr si la cola esta vacia
+     */
+    T* frenteLectura() {
+        unsigned int l = lectura.load(std::memory_order_relaxed);
+        if (l == escritura.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &elementos[l & (N - 1)];
+    }
+
+    /**
+     * @brief (Consumidor) Libera la ranura obtenida con frenteLectura()
+     */
+    void liberarLectura() {
+        lectura.store(lectura.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Elementos en la cola en este momento (aproximado desde otro hilo)
+     */
+    unsigned int getProfundidad() const {
+        return escritura.load(std::memory_order_acquire) - lectura.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Profundidad maxima alcanzada desde la creacion
+     */
+    unsigned int getProfundidadMaxima() const {
+        return maxima.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Elementos descartados por encontrar la cola llena
+     */
+    unsigned long long getDescartados() const {
+        return descartados.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Capacidad total de la cola
+     */
+    unsigned int getCapacidad() const {
+        return N;
+    }
+
+private:
+    ColaSPSC(const ColaSPSC&);
+    ColaSPSC& operator=(const ColaSPSC&);
+};
+
+#endif // COLA_SPSC_H
@@ -0,0 +1,169 @@
+/**
+ * @file DecodificadorMultipuerto.h
+ * @brief Decodificacion simultanea de varios puertos con un grupo de hilos
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef DECODIFICADOR_MULTIPUERTO_H
+#define DECODIFICADOR_MULTIPUERTO_H
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+class SerialPort;
+
+/**
+ * @class DecodificadorMultipuerto
+ * @brief Atiende N transmisores ESP32 en un solo proceso
+ *
+ * Cada puerto es un canal con su propio SerialPort, RotorDeMapeo y
+ * ListaDeCarga. El hilo que llama a ejecutar() espera datos en todos los
+ * puertos a la vez (poll() en POSIX) y entrega los canales listos a un
+ * grupo de hilos de trabajo del tamanio del numero de nucleos. Un canal
+ * solo lo atiende un hilo a la vez, asi que su estado no necesita
+ * candados; cada turno lee las lineas completas disponibles (hasta
+ * LINEAS_POR_TURNO) y devuelve el canal.
+ *
+ * Cada canal termina con su propia trama FIN o al perder su puerto. Las
+ * trazas por trama no se imprimen (se mezclarian entre canales); los
+ * eventos y mensajes finales se etiquetan con el nombre del puerto.
+ *
+ * En Windows no hay poll() para puertos COM: el despachador revisa los
+ * canales libres cada milisegundo.
+ */
+class DecodificadorMultipuerto {
+public:
+    static const int LINEAS_POR_TURNO = 256;    ///< Lineas maximas por canal antes de ceder el hilo
+
+private:
+    /**
+     * @struct Canal
+     * @brief Estado independiente de un puerto
+     */
+    struct Canal {
+        const char* nombre;             ///< Etiqueta (nombre del puerto)
+        SerialPort* puerto;             ///< Puerto del canal
+        RotorDeMapeo rotor;             ///< Rotor propio
+        ListaDeCarga carga;             ///< Mensaje propio
+        bool ocupado;                   ///< En cola o en manos de un hilo (protegido por mutexTrabajo)
+        bool terminado;                 ///< Recibio FIN o perdio el puerto
+        bool finRecibido;               ///< Termino con FIN
+        unsigned long long tramas;      ///< Tramas validas (incluye FIN)
+        unsigned long long invalidas;   ///< Lineas cortas o de tipo desconocido
+    };
+
+    int numCanales;             ///< Canales atendidos
+    Canal* canales;             ///< Estado de cada canal
+    int numHilos;               ///< Hilos de trabajo
+    std::thread* trabajadores;  ///< Grupo de hilos de trabajo
+
+    int* colaTrabajo;           ///< Indices de canales listos (circular, capacidad numCanales)
+    int inicioCola;             ///< Primer elemento de colaTrabajo
+    int cuentaCola;             ///< Elementos en colaTrabajo
+    int canalesActivos;         ///< Canales sin terminar
+    bool detener;               ///< Los hilos deben salir
+    std::mutex mutexTrabajo;    ///< Protege cola, ocupado, canalesActivos y detener
+    std::condition_variable hayTrabajo;     ///< Despierta a los hilos de trabajo
+    std::mutex mutexConsola;    ///< Serializa los mensajes etiquetados
+
+#ifndef WINDOWS_BUILD
+    int avisoDespachador[2];    ///< Tuberia para despertar a poll() al devolver un canal
+#else
+    std::condition_variable canalDevuelto;  ///< Despierta al despachador
+#endif
+
+    /**
+     * @brief Cuerpo de cada hilo de trabajo
+     */
+    void trabajar();
+
+    /**
+     * @brief Procesa las lineas disponibles de un canal
+     * @return true si el canal quedo con lineas pendientes (tope del turno)
+     */
+    bool atenderCanal(int indice);
+
+    /**
+     * @brief Pone un canal en la cola de trabajo (mutexTrabajo tomado)
+     */
+    void encolar(int indice);
+
+    /**
+     * @brief Devuelve un canal al despachador (o lo reencola si quedo pendiente)
+     */
+    void devolverCanal(int indice, bool pendiente);
+
+    /**
+     * @brief Espera datos en los canales libres y encola los listos
+     */
+    void despachar();
+
+public:
+    /**
+     * @brief Constructor - Abre todos los puertos
+     * @param nombres Nombres de los puertos
+     * @param cantidad Numero de puertos
+     * @param hilos Hilos de trabajo (0 = uno por nucleo, nunca mas que puertos)
+     */
+    DecodificadorMultipuerto(char* const* nombres, int cantidad, int hilos = 0);
+
+    /**
+     * @brief Destructor - Cierra los puertos
+     */
+    ~DecodificadorMultipuerto();
+
+    /**
+     * @brief Indica si todos los puertos se abrieron
+     */
+    bool estanConectados() const;
+
+    /**
+     * @brief Atiende todos los canales hasta que cada uno termine
+     */
+    void ejecutar();
+
+    /**
+     * @brief Imprime el mensaje de cada canal, etiquetado con su puerto
+     */
+    void imprimirMensajes();
+
+    /**
+     * @brief Numero de canales
+     */
+    int getCanales() const;
+
+    /**
+     * @brief Hilos de trabajo en uso
+     */
+    int getHilos() const;
+
+    /**
+     * @brief Tramas validas recibidas en todos los canales
+     */
+    unsigned long long getTramasTotales() const;
+
+    /**
+     * @brief Bytes recibidos en todos los canales
+     */
+    unsigned long long getBytesTotales() const;
+
+    /**
+     * @brief Mensaje decodificado de un canal
+     */
+    const ListaDeCarga& getCarga(int indice) const;
+
+    /**
+     * @brief Indica si el canal termino con FIN
+     */
+    bool recibioFin(int indice) const;
+
+private:
+    DecodificadorMultipuerto(const DecodificadorMultipuerto&);
+    DecodificadorMultipuerto& operator=(const DecodificadorMultipuerto&);
+};
+
+#endif // DECODIFICADOR_MULTIPUERTO_H
@@ -0,0 +1,125 @@
+/**
+ * @file DecodificadorParalelo.h
+ * @brief Decodificacion de capturas grandes en varios hilos (suma prefija de rotaciones)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef DECODIFICADOR_PARALELO_H
+#define DECODIFICADOR_PARALELO_H
+
+class FuenteMapeada;
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @class DecodificadorParalelo
+ * @brief Decodifica una captura mapeada repartiendola en trozos entre hilos
+ *
+ * El estado del rotor en cualquier trama es la suma de las rotaciones MAP
+ * anteriores modulo 27. Por eso la captura se corta en trozos (siempre
+ * despues de un '\n') y se procesa en dos pasadas:
+ *
+ * 1. Cada hilo decodifica su trozo como si el rotor empezara en 'A' y
+ *    anota la rotacion neta del trozo.
+ * 2. Una suma prefija exclusiva de esas rotaciones da el desplazamiento
+ *    real con que empieza cada trozo. Empezar d posiciones mas adelante
+ *    solo desplaza cada letra ya decodificada d lugares hacia atras, que es
+ *    justo RotorDeMapeo::decodificarBloque() con la cabeza en d: cada hilo
+ *    corrige su trozo en su lugar con el kernel SIMD.
+ *
+ * Al final los trozos se agregan en orden a la ListaDeCarga. Las lineas se
+ * separan con FuenteMapeada::extraerLinea() y se parsean con
+ * interpretarTrama(), asi que el resultado es identico byte a byte al de
+ * la lectura secuencial (incluido el corte en la primera trama FIN). No se
+ * imprimen trazas por trama; las lineas invalidas solo se cuentan.
+ */
+class DecodificadorParalelo {
+private:
+    /**
+     * @struct Trozo
+     * @brief Rango de la captura asignado a un hilo y sus resultados
+     */
+    struct Trozo {
+        unsigned long long inicio;      ///< Primer byte (inicio de linea)
+        unsigned long long fin;         ///< Byte siguiente al ultimo
+        char* salida;                   ///< Mensaje del trozo (decodificado desde 'A')
+        unsigned long long cargas;      ///< Tramas LOAD antes de FIN (bytes en salida)
+        unsigned long long tramas;      ///< Tramas validas (incluye FIN)
+        unsigned long long invalidas;   ///< Lineas cortas o de tipo desconocido
+        unsigned long long consumido;   ///< Fin real de lectura (despues de FIN, o fin)
+        int rotacion;                   ///< Rotacion neta del trozo (0..26)
+        int desplazamiento;             ///< Cabeza real del rotor al inicio del trozo
+        bool tieneFin;                  ///< El trozo contiene una trama FIN
+    };
+
+    static const int TAMANIO_LINEA = 256;   ///< Mismo buffer de linea que el bucle principal
+
+    int hilos;                  ///< Hilos de trabajo (= trozos)
+    int trozosActivos;          ///< Trozos hasta el que contiene FIN (inclusive)
+    Trozo* trozos;              ///< Un trozo por hilo
+    const char* datos;          ///< Captura en curso
+    unsigned long long tramasProcesadas;    ///< Resultado de la ultima decodificacion
+    unsigned long long lineasInvalidas;     ///< Resultado de la ultima decodificacion
+
+    /**
+     * @brief Pasada 1: decodifica un trozo desde 'A' y obtiene su rotacion neta
+     */
+    void decodificarTrozo(int indice);
+
+    /**
+     * @brief Pasada 2: aplica al trozo su desplazamiento real
+     */
+    void corregirTrozo(int indice);
+
+    /**
+     * @brief Ejecuta una pasada en todos los trozos, un hilo por trozo
+     */
+    void ejecutarPasada(void (DecodificadorParalelo::*pasada)(int));
+
+public:
+    /**
+     * @brief Constructor
+     * @param hilos Hilos de trabajo (0 = uno por nucleo)
+     */
+    DecodificadorParalelo(int hilos);
+
+    /**
+     * @brief Destructor
+     */
+    ~DecodificadorParalelo();
+
+    /**
+     * @brief Decodifica lo que queda de la captura hasta FIN o hasta el final
+     *
+     * Deja la captura posicionada despues de la ultima linea consumida y el
+     * rotor con el desplazamiento final, igual que la lectura secuencial.
+     *
+     * @param captura Captura mapeada
+     * @param carga Lista donde se agrega el mensaje
+     * @param rotor Rotor (su desplazamiento actual es el inicial)
+     * @return true si se encontro FIN
+     */
+    bool decodificar(FuenteMapeada* captura, ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Hilos de trabajo en uso
+     */
+    int getHilos() const;
+
+    /**
+     * @brief Tramas validas de la ultima decodificacion (incluye FIN)
+     */
+    unsigned long long getTramasProcesadas() const;
+
+    /**
+     * @brief Lineas invalidas (cortas o de tipo desconocido) de la ultima decodificacion
+     */
+    unsigned long long getLineasInvalidas() const;
+
+private:
+    DecodificadorParalelo(const DecodificadorParalelo&);
+    DecodificadorParalelo& operator=(const DecodificadorParalelo&);
+};
+
+#endif // DECODIFICADOR_PARALELO_H
@@ -0,0 +1,148 @@
+/**
+ * @file DiarioDeDecodificacion.h
+ * @brief Puntos de control del mensaje y del rotor para reanudar tras una caida
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Con --diario=RUTA el decodificador agrega a RUTA, cada
+ * --diario-intervalo ms, los caracteres nuevos de ListaDeCarga y un punto
+ * de control con el largo del mensaje, el desplazamiento del rotor y las
+ * tramas procesadas. Si el proceso muere, al arrancar otra vez con el
+ * mismo RUTA se restauran la lista y el rotor del ultimo punto completo y
+ * la decodificacion sigue desde ahi, sin retransmitir el mensaje.
+ *
+ * Formato (enteros fijos en little-endian):
+ *
+ * | Bytes                       | Contenido                                       |
+ * |-----------------------------|-------------------------------------------------|
+ * | "\0PRT7DIA" + version (1)   | Cabecera (una por archivo)                      |
+ * | 'D' varint n, n bytes       | Caracteres agregados al mensaje                 |
+ * | 'P' largo (8) rotor (4)     | Punto de control: largo total del mensaje,      |
+ * | tramas (8) completo (1)     | desplazamiento, tramas y si ya llego FIN        |
+ * | FNV-1a (4)                  | Hash de todo lo escrito desde el punto anterior |
+ *
+ * Un punto vale si su hash coincide y su largo es la suma de los 'D'
+ * previos; lo que sigue al ultimo punto valido (una escritura a medias) se
+ * descarta al reanudar. Los caracteres se copian de la lista solo en cada
+ * punto, asi que decodificar no cuesta nada extra por trama; cada punto es
+ * un write() y un fsync() (fdatasync en Linux), el intervalo agrupa todas
+ * las tramas de ese lapso en una sola sincronizacion con el disco. El
+ * vencimiento se revisa en cada trama y en cada timeout de la fuente, y
+ * SIGINT/SIGTERM cierran el bucle con un ultimo punto; solo las tramas de
+ * despues del ultimo punto se pierden si el proceso muere de otra forma.
+ *
+ * Un diario cuyo ultimo punto ya tiene FIN se da por terminado: la
+ * siguiente ejecucion lo vacia y empieza un mensaje nuevo.
+ */
+
+#ifndef DIARIO_DE_DECODIFICACION_H
+#define DIARIO_DE_DECODIFICACION_H
+
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/// Cabecera del archivo (8 bytes, el primero es '\0')
+#define CABECERA_DIARIO "\0PRT7DIA"
+
+/**
+ * @class DiarioDeDecodificacion
+ * @brief Diario de solo agregar con puntos de control sincronizados por lotes
+ *
+ * Lo usa un solo hilo (el bucle secuencial de main).
+ */
+class DiarioDeDecodificacion {
+public:
+    static const int INTERVALO_POR_DEFECTO_MS = 100;    ///< Entre dos puntos de control
+    static const int TAMANIO_LOTE = 65536;              ///< Bytes por write()
+
+private:
+    int fd;                         ///< Descriptor del diario (-1 si no abrio)
+    char* ruta;                     ///< Copia de la ruta (para los mensajes)
+    unsigned char* lote;            ///< Bytes aun no escritos
+    int usados;                     ///< Bytes en lote
+    unsigned int hash;              ///< FNV-1a desde el ultimo punto de control
+    int intervaloMs;                ///< Minimo entre dos puntos
+    long long ultimoPuntoMs;        ///< Instante del ultimo punto (ms, reloj monotono)
+    long long largoDiario;          ///< Caracteres del mensaje ya agregados al diario
+    int desplazamientoDiario;       ///< Rotor del ultimo punto
+    unsigned long long tramasPrevias;   ///< Tramas de las ejecuciones anteriores
+    unsigned long long tramasDiario;    ///< Tramas del ultimo punto
+    bool completoDiario;            ///< El ultimo punto ya tenia FIN
+    long long largoRestaurado;      ///< Caracteres restaurados al abrir
+    unsigned long long puntos;      ///< Puntos de control escritos en esta ejecucion
+    bool fallo;                     ///< Algun write()/fsync() fallo (se deja de escribir)
+
+    /**
+     * @brief Agrega bytes al lote (y al hash), escribiendo si no caben
+     */
+    void agregar(const unsigned char* datos, int n);
+
+    /**
+     * @brief Escribe el lote pendiente
+     */
+    bool escribirLote();
+
+    /**
+     * @brief Lee el diario existente y restaura lista y rotor del ultimo punto valido
+     * @return false si el archivo no es un diario
+     */
+    bool reanudar(ListaDeCarga* lista, RotorDeMapeo* rotor);
+
+public:
+    /**
+     * @brief Constructor
+     * @param ruta Archivo del diario (se crea si no existe)
+     * @param intervaloMs Minimo entre dos puntos de control
+     */
+    DiarioDeDecodificacion(const char* ruta, int intervaloMs = INTERVALO_POR_DEFECTO_MS);
+
+    /**
+     * @brief Destructor - Escribe lo pendiente (sin punto nuevo) y cierra
+     */
+    ~DiarioDeDecodificacion();
+
+    /**
+     * @brief Abre el diario y, si tiene un punto de control, restaura lista y rotor
+     * @param lista Lista vacia donde queda el mensaje restaurado
+     * @param rotor Rotor recien creado
+     * @return false si no se pudo abrir o el archivo no es un diario
+     */
+    bool abrir(ListaDeCarga* lista, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Escribe un punto de control con los caracteres nuevos de la lista y lo sincroniza
+     * @param lista Mensaje actual
+     * @param rotor Rotor actual
+     * @param tramas Tramas procesadas en esta ejecucion
+     * @param completo Ya llego FIN
+     */
+    void puntoDeControl(const ListaDeCarga* lista, const RotorDeMapeo* rotor,
+                        unsigned long long tramas, bool completo);
+
+    /**
+     * @brief Escribe un punto de control si ya paso el intervalo
+     */
+    void puntoDeControlSiVencido(const ListaDeCarga* lista, const RotorDeMapeo* rotor,
+                                 unsigned long long tramas);
+
+    /**
+     * @brief Caracteres restaurados al abrir
+     */
+    long long getLargoRestaurado() const;
+
+    /**
+     * @brief Tramas procesadas antes de esta ejecucion
+     */
+    unsigned long long getTramasPrevias() const;
+
+    /**
+     * @brief Puntos de control escritos en esta ejecucion
+     */
+    unsigned long long getPuntos() const;
+
+private:
+    DiarioDeDecodificacion(const DiarioDeDecodificacion&);
+    DiarioDeDecodificacion& operator=(const DiarioDeDecodificacion&);
+};
+
+#endif // DIARIO_DE_DECODIFICACION_H
@@ -0,0 +1,99 @@
+/**
+ * @file ExportadorMetricas.h
+ * @brief Hilo que publica las metricas en un archivo o en un socket Unix
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef EXPORTADOR_METRICAS_H
+#define EXPORTADOR_METRICAS_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+struct MetricasDecodificador;
+
+/**
+ * @class ExportadorMetricas
+ * @brief Publica instantaneas de MetricasDecodificador en formato Prometheus
+ *
+ * Con una ruta de archivo reescribe la instantanea cada intervalo (primero
+ * en RUTA.tmp y luego la renombra, asi el lector nunca ve un archivo a
+ * medias; sirve para el textfile collector de node_exporter). Con
+ * "unix:RUTA" (solo POSIX) escucha en un socket Unix y a cada conexion le
+ * escribe la instantanea del momento y la cierra, como un scrape
+ * (ej: "socat - UNIX-CONNECT:RUTA"). El decodificador no hace E/S ni toma
+ * bloqueos por las metricas: el hilo solo lee los atomicos.
+ */
+class ExportadorMetricas {
+private:
+    const MetricasDecodificador* origen;    ///< Metricas a publicar
+    char* ruta;                             ///< Archivo o socket (sin el prefijo "unix:")
+    char* rutaTemporal;                     ///< RUTA.tmp (modo archivo)
+    bool esSocket;                          ///< Modo socket Unix
+    int intervaloMs;                        ///< Periodo de escritura del archivo
+    int descriptorSocket;                   ///< Socket en escucha (-1 si no hay)
+    bool iniciado;                          ///< El hilo esta corriendo
+
+    std::thread hilo;                       ///< Hilo de publicacion
+    std::atomic<bool> terminar;             ///< Pide terminar al hilo
+    std::mutex mutexAviso;                  ///< Protege la espera del modo archivo
+    std::condition_variable aviso;          ///< Despierta al hilo al detener
+
+    /**
+     * @brief Cuerpo del hilo en modo archivo
+     */
+    void publicarEnArchivo();
+
+    /**
+     * @brief Cuerpo del hilo en modo socket
+     */
+    void atenderSocket();
+
+    /**
+     * @brief Escribe una instantanea en el archivo
+     * @return false si no se pudo escribir
+     */
+    bool escribirArchivo();
+
+public:
+    static const int INTERVALO_POR_DEFECTO_MS = 1000;   ///< Periodo de escritura por defecto
+
+    /**
+     * @brief Constructor
+     * @param metricas Metricas a publicar
+     * @param destino Ruta del archivo o "unix:RUTA"
+     * @param intervaloMs Periodo de escritura del archivo en milisegundos
+     */
+    ExportadorMetricas(const MetricasDecodificador* metricas, const char* destino,
+                       int intervaloMs = INTERVALO_POR_DEFECTO_MS);
+
+    /**
+     * @brief Destructor - Detiene el hilo y cierra el socket
+     */
+    ~ExportadorMetricas();
+
+    /**
+     * @brief Abre el destino y arranca el hilo
+     * @return false si no se pudo crear el archivo o el socket
+     */
+    bool iniciar();
+
+    /**
+     * @brief Detiene el hilo; en modo archivo deja escrita la instantanea final
+     */
+    void detener();
+
+    /**
+     * @brief Indica si el destino es valido en esta plataforma ("unix:" solo en POSIX)
+     */
+    static bool esDestinoValido(const char* destino);
+
+private:
+    ExportadorMetricas(const ExportadorMetricas&);
+    ExportadorMetricas& operator=(const ExportadorMetricas&);
+};
+
+#endif // EXPORTADOR_METRICAS_H
@@ -0,0 +1,106 @@
+/**
+ * @file FuenteArchivo.h
+ * @brief Lectura de tramas desde un archivo o la entrada estandar
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef FUENTE_ARCHIVO_H
+#define FUENTE_ARCHIVO_H
+
+#include "FuenteDeTramas.h"
+
+/**
+ * @class FuenteArchivo
+ * @brief Lee un descriptor (archivo regular, tuberia o stdin) en bloques de 64 KB
+ *
+ * Usa read() y no fread(): en una tuberia read() regresa con lo que haya,
+ * de modo que "cat /dev/ttyUSB0 | DecodificadorPRT7 --fuente=stdin" no
+ * espera a juntar 64 KB para mostrar la siguiente trama.
+ *
+ * En una tuberia, una FIFO o una terminal la espera se hace con poll() de
+ * a lo sumo ESPERA_MAXIMA_MS: si no llega nada, leerLinea() devuelve 0 y
+ * sigue conectada, como el timeout del puerto serial, asi el hilo lector
+ * de la tuberia puede ver que debe terminar aunque el emisor calle.
+ */
+class FuenteArchivo : public FuenteDeTramas {
+private:
+    static const int TAMANIO_BLOQUE = 65536;   ///< Bytes por llamada a read()
+    static const int ESPERA_MAXIMA_MS = 100;   ///< Espera por llamada en tuberias y terminales
+
+    /**
+     * @enum ResultadoLectura
+     * @brief Lo que obtuvo llenarBloque()
+     */
+    enum ResultadoLectura {
+        LECTURA_DATOS,      ///< Llegaron bytes
+        LECTURA_VACIA,      ///< No llego nada en ESPERA_MAXIMA_MS o llego una senal (sigue conectada)
+        LECTURA_FIN         ///< Fin del archivo o error
+    };
+
+    int fd;                     ///< Descriptor de lectura
+    bool propio;                ///< true si hay que cerrar fd (no es stdin)
+    bool conEspera;             ///< fd puede bloquear (no es un archivo regular): esperar con poll()
+    bool conectado;             ///< false al llegar al final o tras un error
+    bool finDeArchivo;          ///< read() ya devolvio 0
+    char* bloque;               ///< Bytes leidos aun no entregados
+    int inicio;                 ///< Primer byte pendiente en bloque
+    int fin;                    ///< Fin de los bytes validos en bloque
+    unsigned long long bytesLeidos;   ///< Bytes entregados por read()
+
+    /**
+     * @brief Copia n bytes pendientes al buffer (sin '\r') y los consume
+     */
+    int extraerLinea(char* buffer, int bufferSize, int n, int separador);
+
+    /**
+     * @brief Compacta los bytes pendientes y lee el siguiente bloque
+     * @return LECTURA_VACIA si no llego nada a tiempo o una senal interrumpio read(),
+     *         LECTURA_FIN si no se puede leer nada mas
+     */
+    ResultadoLectura llenarBloque();
+
+public:
+    /**
+     * @brief Constructor - Abre el archivo
+     * @param ruta Ruta del archivo, o nullptr para la entrada estandar
+     */
+    FuenteArchivo(const char* ruta);
+
+    /**
+     * @brief Destructor - Cierra el archivo
+     */
+    ~FuenteArchivo();
+
+    /**
+     * @brief Lee la siguiente linea
+     *
+     * Al final del archivo entrega la ultima linea aunque no termine en '\n'.
+     *
+     * @param buffer Buffer para almacenar la linea
+     * @param bufferSize Tamanio del buffer
+     * @return Numero de caracteres leidos (0 al terminar o si no llego nada a tiempo)
+     */
+    int leerLinea(char* buffer, int bufferSize) override;
+
+    /**
+     * @brief Indica si quedan lineas por leer
+     */
+    bool estaConectado() const override;
+
+    /**
+     * @brief Bytes consumidos de la captura
+     */
+    unsigned long long getBytesLeidos() const override;
+
+    /**
+     * @brief Cierra la fuente
+     */
+    void cerrar() override;
+
+private:
+    FuenteArchivo(const FuenteArchivo&);
+    FuenteArchivo& operator=(const FuenteArchivo&);
+};
+
+#endif // FUENTE_ARCHIVO_H
@@ -0,0 +1,135 @@
+/**
+ * @file FuenteCaptura.h
+ * @brief Reproduccion de una captura binaria con sus tiempos originales
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef FUENTE_CAPTURA_H
+#define FUENTE_CAPTURA_H
+
+#include "FuenteDeTramas.h"
+#include <chrono>
+
+/**
+ * @class FuenteCaptura
+ * @brief Entrega las lineas de una captura de --grabar (--fuente=captura:RUTA)
+ *
+ * Cada linea sale cuando le toca segun los deltas grabados, divididos
+ * entre la velocidad: 1 repite el ritmo original, 10 lo hace diez veces
+ * mas rapido y 0 entrega todo sin esperar. La primera linea sale de
+ * inmediato y los segmentos se encadenan sin pausa entre uno y otro.
+ *
+ * Mientras espera, leerLinea() duerme a lo sumo ESPERA_MAXIMA_MS y
+ * devuelve 0, como el timeout del puerto serial, para que el bucle
+ * atienda senales y metricas durante los silencios largos.
+ *
+ * Las lineas se leen del archivo con read() en bloques de 64 KB; getBytesLeidos()
+ * cuenta los bytes de las lineas mas un '\n' por linea, como si la captura
+ * fuera de texto, para que --rendimiento sea comparable con archivo:RUTA.
+ */
+class FuenteCaptura : public FuenteDeTramas {
+public:
+    static const int TAMANIO_BLOQUE = 65536;   ///< Bytes por llamada a read()
+    static const int ESPERA_MAXIMA_MS = 100;   ///< Sueno maximo por llamada
+
+private:
+    int fd;                         ///< Descriptor de la captura
+    bool conectado;                 ///< false al terminar o ante una captura danada
+    bool finDeArchivo;              ///< read() ya devolvio 0
+    unsigned char* bloque;          ///< Bytes leidos aun no interpretados
+    int inicio;                     ///< Primer byte pendiente en bloque
+    int fin;                        ///< Fin de los bytes validos en bloque
+    double velocidad;               ///< Factor sobre el ritmo original (0 = sin esperas)
+
+    bool hayRegistro;               ///< Hay un registro interpretado sin entregar completo
+    int largoRegistro;              ///< Bytes del registro pendientes de entregar
+    unsigned long long relojCaptura;    ///< Instante del registro en la captura (us acumulados)
+    bool inicioDeSegmento;          ///< El proximo registro es el primero de su segmento
+    bool reproduciendo;             ///< Ya se entrego la primera linea
+    std::chrono::steady_clock::time_point origen;   ///< Instante real del relojCaptura 0
+
+    unsigned long long lineas;      ///< Registros entregados
+    unsigned long long bytesLeidos; ///< Bytes de las lineas entregadas (+1 por linea)
+    unsigned long long retrasoMaximo;   ///< Mayor atraso al entregar una linea (us)
+
+    /**
+     * @brief Garantiza n bytes pendientes en el bloque
+     * @return false si el archivo se acabo antes
+     */
+    bool asegurar(int n);
+
+    /**
+     * @brief Interpreta un varint desde inicio
+     * @return false si esta incompleto o es demasiado largo
+     */
+    bool leerVarint(unsigned long long* valor);
+
+    /**
+     * @brief Interpreta el siguiente registro (saltando cabeceras de segmento)
+     * @return false al final de la captura o si esta danada
+     */
+    bool siguienteRegistro();
+
+    /**
+     * @brief Da la captura por terminada con un aviso
+     */
+    void terminar(const char* motivo);
+
+public:
+    /**
+     * @brief Constructor - Abre la captura y verifica su cabecera
+     * @param ruta Archivo escrito con --grabar
+     */
+    explicit FuenteCaptura(const char* ruta);
+
+    /**
+     * @brief Destructor - Cierra la captura
+     */
+    ~FuenteCaptura();
+
+    /**
+     * @brief Cambia la velocidad de reproduccion
+     * @param factor 1 = ritmo original, N = N veces mas rapido, 0 = sin esperas
+     */
+    void setVelocidad(double factor);
+
+    /**
+     * @brief Entrega la siguiente linea cuando le toca
+     * @return Caracteres copiados (0 si aun no toca o se acabo la captura)
+     */
+    int leerLinea(char* buffer, int bufferSize) override;
+
+    /**
+     * @brief Indica si quedan lineas
+     */
+    bool estaConectado() const override;
+
+    /**
+     * @brief Bytes de las lineas entregadas mas un '\n' por linea
+     */
+    unsigned long long getBytesLeidos() const override;
+
+    /**
+     * @brief Cierra la captura
+     */
+    void cerrar() override;
+
+    /**
+     * @brief Lineas entregadas
+     */
+    unsigned long long getLineas() const;
+
+    /**
+     * @brief Mayor atraso de una linea respecto a su instante (us)
+     *
+     * Con velocidad > 0 mide si el decodificador siguio el ritmo pedido.
+     */
+    unsigned long long getRetrasoMaximo() const;
+
+private:
+    FuenteCaptura(const FuenteCaptura&);
+    FuenteCaptura& operator=(const FuenteCaptura&);
+};
+
+#endif // FUENTE_CAPTURA_H
@@ -0,0 +1,99 @@
+/**
+ * @file FuenteDeTramas.h
+ * @brief Clase base abstracta para los origenes de lineas PRT-7
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Define la interfaz comun para leer el flujo de tramas desde el puerto
+ * serial, la entrada estandar o una captura guardada en disco.
+ */
+
+#ifndef FUENTE_DE_TRAMAS_H
+#define FUENTE_DE_TRAMAS_H
+
+/**
+ * @class FuenteDeTramas
+ * @brief Origen de lineas de texto para parsearTrama()
+ *
+ * Todas las fuentes entregan lineas con la misma semantica que
+ * SerialPort::leerLinea(): sin '\r' ni '\n', y en trozos de bufferSize - 1
+ * si la linea no cabe. Asi el camino parsearTrama -> procesarTrama es el
+ * mismo para el ESP32 en vivo y para una captura.
+ */
+class FuenteDeTramas {
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~FuenteDeTramas() {}
+
+    /**
+     * @brief Lee la siguiente linea completa
+     * @param buffer Buffer para almacenar la linea
+     * @param bufferSize Tamanio del buffer
+     * @return Numero de caracteres leidos (0 si no hay linea por ahora o se acabo el flujo)
+     */
+    virtual int leerLinea(char* buffer, int bufferSize) = 0;
+
+    /**
+     * @brief Indica si la fuente todavia puede entregar lineas
+     * @return false tras un error o al llegar al final de una captura
+     */
+    virtual bool estaConectado() const = 0;
+
+    /**
+     * @brief Bytes consumidos de la fuente hasta ahora
+     */
+    virtual unsigned long long getBytesLeidos() const = 0;
+
+    /**
+     * @brief Pide al emisor que cambie al modo binario compacto
+     *
+     * Solo el puerto serial puede negociarlo; las capturas y stdin siempre
+     * son texto.
+     *
+     * @return true si la solicitud se envio
+     */
+    virtual bool solicitarModoBinario() { return false; }
+
+    /**
+     * @brief Pide al emisor que anteponga su marca de tiempo a cada trama
+     *
+     * Las capturas y stdin ya traen (o no) las marcas que escribio quien las
+     * genero.
+     *
+     * @return true si la solicitud se envio
+     */
+    virtual bool solicitarMarcasDeTiempo() { return false; }
+
+    /**
+     * @brief Cierra la fuente
+     */
+    virtual void cerrar() = 0;
+};
+
+/**
+ * @brief Verifica la sintaxis de una especificacion de fuente (sin abrir nada)
+ * @param especificacion Texto de --fuente=
+ * @return true si crearFuenteDeTramas() la acepta
+ */
+bool esFuenteValida(const char* especificacion);
+
+/**
+ * @brief Crea una fuente a partir de su especificacion de linea de comandos
+ *
+ * Especificaciones aceptadas:
+ * - "serial": el puerto indicado en @p puerto
+ * - "stdin": la entrada estandar
+ * - "archivo:RUTA": captura leida con read() en bloques
+ * - "mmap:RUTA": captura mapeada en memoria
+ * - "captura:RUTA": captura binaria de --grabar, con sus tiempos (FuenteCaptura)
+ *
+ * @param especificacion Texto de --fuente=
+ * @param puerto Puerto serial a usar con "serial"
+ * @return Fuente creada con new (el llamador la libera), o nullptr si la
+ *         especificacion no es valida
+ */
+FuenteDeTramas* crearFuenteDeTramas(const char* especificacion, const char* puerto);
+
+#endif // FUENTE_DE_TRAMAS_H
@@ -0,0 +1,91 @@
+/**
+ * @file FuenteGrabada.h
+ * @brief Fuente que copia cada linea leida a una captura binaria
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef FUENTE_GRABADA_H
+#define FUENTE_GRABADA_H
+
+#include "FuenteDeTramas.h"
+#include "GrabadorDeCaptura.h"
+
+/**
+ * @class FuenteGrabada
+ * @brief Envuelve otra fuente y graba lo que entrega (--grabar=RUTA)
+ *
+ * Cada linea que devuelve la fuente interna pasa a GrabadorDeCaptura con
+ * el instante en que salio de leerLinea(); el llamador la recibe igual que
+ * sin grabar. Sirve con el bucle secuencial y con la tuberia (graba el
+ * hilo lector). En modo binario se graba la trama ya traducida a texto.
+ */
+class FuenteGrabada : public FuenteDeTramas {
+private:
+    FuenteDeTramas* interna;        ///< Fuente real (propiedad de esta clase)
+    GrabadorDeCaptura grabador;     ///< Captura de salida
+
+public:
+    /**
+     * @brief Constructor - Toma la fuente y abre la captura
+     * @param interna Fuente creada con new (se libera en el destructor)
+     * @param ruta Archivo de captura
+     */
+    FuenteGrabada(FuenteDeTramas* interna, const char* ruta);
+
+    /**
+     * @brief Destructor - Cierra la captura y libera la fuente interna
+     */
+    ~FuenteGrabada();
+
+    /**
+     * @brief Lee de la fuente interna y graba la linea
+     */
+    int leerLinea(char* buffer, int bufferSize) override;
+
+    /**
+     * @brief Estado de la fuente interna
+     */
+    bool estaConectado() const override;
+
+    /**
+     * @brief Bytes consumidos de la fuente interna
+     */
+    unsigned long long getBytesLeidos() const override;
+
+    /**
+     * @brief Reenvia la solicitud a la fuente interna
+     */
+    bool solicitarModoBinario() override;
+
+    /**
+     * @brief Reenvia la solicitud a la fuente interna
+     */
+    bool solicitarMarcasDeTiempo() override;
+
+    /**
+     * @brief Cierra la fuente interna y la captura
+     */
+    void cerrar() override;
+
+    /**
+     * @brief Indica si se esta grabando (la captura abrio y no hubo errores)
+     */
+    bool estaGrabando() const;
+
+    /**
+     * @brief Lineas grabadas
+     */
+    unsigned long long getLineasGrabadas() const;
+
+    /**
+     * @brief Bytes escritos en la captura
+     */
+    unsigned long long getBytesGrabados() const;
+
+private:
+    FuenteGrabada(const FuenteGrabada&);
+    FuenteGrabada& operator=(const FuenteGrabada&);
+};
+
+#endif // FUENTE_GRABADA_H
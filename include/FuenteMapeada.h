@@ -0,0 +1,113 @@
+/**
+ * @file FuenteMapeada.h
+ * @brief Lectura de tramas desde una captura mapeada en memoria
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef FUENTE_MAPEADA_H
+#define FUENTE_MAPEADA_H
+
+#include "FuenteDeTramas.h"
+
+#ifdef WINDOWS_BUILD
+#include <windows.h>
+#endif
+
+/**
+ * @class FuenteMapeada
+ * @brief Recorre una captura completa mapeada con mmap() / MapViewOfFile()
+ *
+ * No hay llamadas al sistema por bloque ni copia intermedia: las lineas se
+ * buscan con memchr() directamente sobre las paginas del archivo.
+ */
+class FuenteMapeada : public FuenteDeTramas {
+private:
+#ifdef WINDOWS_BUILD
+    HANDLE hArchivo;            ///< Handle del archivo
+    HANDLE hMapeo;              ///< Handle del objeto de mapeo
+#endif
+
+    const char* datos;          ///< Inicio de la captura mapeada (nullptr si esta vacia)
+    unsigned long long tamanio; ///< Bytes de la captura
+    unsigned long long posicion;///< Primer byte aun no entregado
+    bool abierto;               ///< Se pudo abrir la captura
+    bool conectado;             ///< false al llegar al final
+
+public:
+    /**
+     * @brief Constructor - Abre y mapea la captura
+     * @param ruta Ruta del archivo
+     */
+    FuenteMapeada(const char* ruta);
+
+    /**
+     * @brief Destructor - Libera el mapeo
+     */
+    ~FuenteMapeada();
+
+    /**
+     * @brief Extrae una linea de un bloque de memoria
+     *
+     * Es el separador de lineas de leerLinea(), expuesto para recorrer
+     * trozos de la captura desde varios hilos con exactamente las mismas
+     * lineas que veria la lectura secuencial.
+     *
+     * @param datos Inicio del bloque
+     * @param tamanio Fin del bloque (bytes desde datos)
+     * @param posicion Entrada: primer byte de la linea; salida: inicio de la siguiente
+     * @param buffer Destino de la linea (sin '\r' ni '\n')
+     * @param bufferSize Tamanio del buffer (al menos 2)
+     * @return Caracteres copiados al buffer
+     */
+    static int extraerLinea(const char* datos, unsigned long long tamanio,
+                            unsigned long long* posicion, char* buffer, int bufferSize);
+
+    /**
+     * @brief Inicio de la captura mapeada (nullptr si esta vacia)
+     */
+    const char* getDatos() const;
+
+    /**
+     * @brief Tamanio de la captura en bytes
+     */
+    unsigned long long getTamanio() const;
+
+    /**
+     * @brief Marca como consumidos los bytes hasta la posicion dada
+     * @param nuevaPosicion Siguiente byte a leer
+     */
+    void setPosicion(unsigned long long nuevaPosicion);
+
+    /**
+     * @brief Lee la siguiente linea
+     *
+     * Al final de la captura entrega la ultima linea aunque no termine en '\n'.
+     *
+     * @param buffer Buffer para almacenar la linea
+     * @param bufferSize Tamanio del buffer
+     * @return Numero de caracteres leidos (0 al terminar)
+     */
+    int leerLinea(char* buffer, int bufferSize) override;
+
+    /**
+     * @brief Indica si quedan lineas por leer
+     */
+    bool estaConectado() const override;
+
+    /**
+     * @brief Bytes consumidos de la captura
+     */
+    unsigned long long getBytesLeidos() const override;
+
+    /**
+     * @brief Cierra la fuente
+     */
+    void cerrar() override;
+
+private:
+    FuenteMapeada(const FuenteMapeada&);
+    FuenteMapeada& operator=(const FuenteMapeada&);
+};
+
+#endif // FUENTE_MAPEADA_H
@@ -0,0 +1,129 @@
+/**
+ * @file GeneradorDeTramas.h
+ * @brief Trafico PRT-7 sintetico con su mensaje esperado
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Sustituto del ESP32 para pruebas de carga: genera lineas como las de
+ * Serial.println() con una mezcla configurable de LOAD (de un caracter o
+ * en rafaga), MAP y lineas de banner, y al mismo tiempo decodifica lo que
+ * genera con un RotorDeMapeo de referencia para conocer el mensaje que el
+ * decodificador debe armar.
+ */
+
+#ifndef GENERADOR_DE_TRAMAS_H
+#define GENERADOR_DE_TRAMAS_H
+
+#include "RotorDeMapeo.h"
+
+/**
+ * @struct ConfiguracionTrafico
+ * @brief Parametros del trafico sintetico
+ */
+struct ConfiguracionTrafico {
+    long long caracteres;   ///< Largo del mensaje (caracteres en tramas LOAD)
+    int porcentajeMap;      ///< Probabilidad (0-100) de un MAP antes de cada LOAD
+    int rotacionMaxima;     ///< Los MAP rotan entre -rotacionMaxima y +rotacionMaxima
+    int rafagaMaxima;       ///< Caracteres por LOAD, al azar entre 1 y este valor (1 = "L,X")
+    int porcentajeBasura;   ///< Probabilidad (0-100) de una linea de banner antes de cada trama
+    unsigned int semilla;   ///< Semilla del generador pseudoaleatorio
+    bool conFin;            ///< Terminar con la trama FIN
+
+    /**
+     * @brief Valores por defecto: 1M caracteres, 10% MAP de -30..30, sin rafagas ni basura
+     */
+    ConfiguracionTrafico();
+};
+
+/**
+ * @class GeneradorDeTramas
+ * @brief Produce el flujo de lineas y el mensaje que debe decodificarse
+ *
+ * Las lineas de basura son texto del banner del ESP32 (sin coma en la
+ * segunda posicion, ninguna empieza con "FIN"), que parsearTrama() ignora
+ * en silencio. El mensaje esperado se guarda completo en memoria.
+ */
+class GeneradorDeTramas {
+public:
+    static const int RAFAGA_MAXIMA = 250;   ///< Tope de rafaga: la linea cabe en el buffer de 256 del decodificador
+    static const int LINEA_MAXIMA = RAFAGA_MAXIMA + 8;  ///< Bytes de la linea mas larga ("L," + rafaga + "\r\n")
+
+private:
+    ConfiguracionTrafico configuracion;     ///< Parametros (con la rafaga ya acotada)
+    unsigned int estado;                    ///< Estado del generador congruencial
+    RotorDeMapeo rotor;                     ///< Rotor de referencia (sin trazas)
+
+    char* esperado;                 ///< Mensaje decodificado de lo generado
+    long long longitudEsperada;     ///< Caracteres en esperado
+    long long capacidadEsperada;    ///< Capacidad de esperado
+
+    bool terminado;                 ///< Ya se entrego la ultima linea
+    unsigned long long tramas;      ///< Tramas LOAD, MAP y FIN generadas
+    unsigned long long lineasBasura;    ///< Lineas de banner generadas
+    unsigned long long bytes;       ///< Bytes generados
+
+    /**
+     * @brief Siguiente numero pseudoaleatorio de 15 bits
+     */
+    unsigned int azar();
+
+    /**
+     * @brief Agrega caracteres decodificados al mensaje esperado
+     */
+    void agregarEsperado(const char* datos, int n);
+
+public:
+    /**
+     * @brief Constructor
+     * @param configuracion Parametros del trafico
+     */
+    GeneradorDeTramas(const ConfiguracionTrafico& configuracion);
+
+    /**
+     * @brief Destructor - Libera el mensaje esperado
+     */
+    ~GeneradorDeTramas();
+
+    /**
+     * @brief Escribe la siguiente linea, terminada en "\r\n"
+     * @param destino Al menos LINEA_MAXIMA bytes
+     * @return Bytes escritos (0 cuando ya no hay mas lineas)
+     */
+    int siguienteLinea(char* destino);
+
+    /**
+     * @brief Indica si ya se generaron todas las lineas
+     */
+    bool estaTerminado() const;
+
+    /**
+     * @brief Mensaje que el decodificador debe armar con lo generado hasta ahora
+     */
+    const char* getEsperado() const;
+
+    /**
+     * @brief Caracteres del mensaje esperado
+     */
+    long long getLongitudEsperada() const;
+
+    /**
+     * @brief Tramas LOAD, MAP y FIN generadas
+     */
+    unsigned long long getTramas() const;
+
+    /**
+     * @brief Lineas de banner generadas
+     */
+    unsigned long long getLineasBasura() const;
+
+    /**
+     * @brief Bytes generados
+     */
+    unsigned long long getBytes() const;
+
+private:
+    GeneradorDeTramas(const GeneradorDeTramas&);
+    GeneradorDeTramas& operator=(const GeneradorDeTramas&);
+};
+
+#endif // GENERADOR_DE_TRAMAS_H
@@ -0,0 +1,129 @@
+/**
+ * @file GrabadorDeCaptura.h
+ * @brief Captura binaria con marcas de tiempo de las lineas recibidas
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Con --grabar=RUTA cada linea que entrega la fuente se agrega al final de
+ * RUTA junto con el instante en que llego, para volver a pasarla por
+ * parsearTrama() con --fuente=captura:RUTA (ver FuenteCaptura).
+ *
+ * Formato (enteros en varint LEB128 sin signo):
+ *
+ * | Bytes                         | Contenido                                  |
+ * |-------------------------------|--------------------------------------------|
+ * | "\0PRT7CAP" + version (1)     | Cabecera de segmento (una por grabacion)   |
+ * | 8 bytes little-endian         | Inicio del segmento, us desde 1970 (UTC)   |
+ * | varint largo + 1              | Registro: largo de la linea mas uno        |
+ * | varint delta                  | us desde el registro anterior (o el inicio)|
+ * | largo bytes                   | La linea tal como la entrego leerLinea()   |
+ *
+ * Ningun registro empieza con 0, asi que el byte 0 anuncia otra cabecera:
+ * grabar dos veces en la misma ruta agrega un segmento nuevo sin tocar lo
+ * anterior. Los deltas salen del reloj monotono (steady_clock); la hora
+ * UTC de la cabecera solo sirve para ubicar la captura. Una LOAD ocupa 6
+ * bytes a ritmo de 115200 baudios (delta de 2 bytes), uno mas que en el
+ * cable.
+ *
+ * Los registros se juntan en un bloque de 64 KB y se escriben con un solo
+ * write() cuando se llena o cuando lleva mas de INTERVALO_VACIADO_US sin
+ * escribirse, de modo que en un enlace lento lo grabado llega al disco a
+ * lo sumo un segundo tarde y en una captura rapida no hay una llamada al
+ * sistema por linea.
+ */
+
+#ifndef GRABADOR_DE_CAPTURA_H
+#define GRABADOR_DE_CAPTURA_H
+
+/// Inicio de cada cabecera de segmento (8 bytes, el primero es '\0')
+#define CABECERA_CAPTURA "\0PRT7CAP"
+
+const int LARGO_CABECERA_CAPTURA = 8;           ///< Bytes de CABECERA_CAPTURA
+const unsigned char VERSION_CAPTURA = 1;        ///< Version del formato
+const int BYTES_CABECERA_SEGMENTO = LARGO_CABECERA_CAPTURA + 1 + 8;     ///< Cabecera + version + inicio
+const int LINEA_CAPTURA_MAXIMA = 4096;          ///< Linea mas larga que se graba (mas larga = captura danada)
+
+/**
+ * @class GrabadorDeCaptura
+ * @brief Agrega registros a una captura en lotes de un write()
+ *
+ * Solo lo usa un hilo (el que llama a leerLinea()).
+ */
+class GrabadorDeCaptura {
+public:
+    static const int TAMANIO_LOTE = 65536;                      ///< Bytes por write()
+    static const long long INTERVALO_VACIADO_US = 1000000;      ///< Antiguedad maxima de lo pendiente
+
+private:
+    int fd;                         ///< Descriptor de la captura (-1 si no abrio)
+    unsigned char* lote;            ///< Registros aun no escritos
+    int usados;                     ///< Bytes en lote
+    unsigned long long anterior;    ///< Instante del ultimo registro (us, reloj monotono)
+    unsigned long long ultimoVaciado;   ///< Instante del ultimo write() (us)
+    unsigned long long lineas;      ///< Registros grabados
+    unsigned long long bytesEscritos;   ///< Bytes que ya llegaron al archivo
+    bool fallo;                     ///< Algun write() fallo (se deja de grabar)
+
+    /**
+     * @brief Escribe el lote pendiente
+     * @return false si write() fallo
+     */
+    bool escribirLote();
+
+public:
+    /**
+     * @brief Constructor - Abre RUTA para agregar y escribe la cabecera del segmento
+     * @param ruta Archivo de captura (se crea si no existe)
+     */
+    explicit GrabadorDeCaptura(const char* ruta);
+
+    /**
+     * @brief Destructor - Escribe lo pendiente y cierra
+     */
+    ~GrabadorDeCaptura();
+
+    /**
+     * @brief Indica si la captura esta abierta y sin errores
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Agrega una linea
+     * @param linea Texto de la linea (sin '\r' ni '\n')
+     * @param largo Bytes de la linea (mayor que 0)
+     * @param instante ahora() al recibirla
+     */
+    void grabar(const char* linea, int largo, unsigned long long instante);
+
+    /**
+     * @brief Escribe lo pendiente si lleva mas de INTERVALO_VACIADO_US en el lote
+     * @param instante ahora()
+     */
+    void vaciarSiVencido(unsigned long long instante);
+
+    /**
+     * @brief Escribe lo pendiente y cierra el archivo
+     */
+    void cerrar();
+
+    /**
+     * @brief Registros grabados
+     */
+    unsigned long long getLineas() const;
+
+    /**
+     * @brief Bytes escritos en la captura (cabecera incluida)
+     */
+    unsigned long long getBytesEscritos() const;
+
+    /**
+     * @brief Reloj monotono en microsegundos (steady_clock)
+     */
+    static unsigned long long ahora();
+
+private:
+    GrabadorDeCaptura(const GrabadorDeCaptura&);
+    GrabadorDeCaptura& operator=(const GrabadorDeCaptura&);
+};
+
+#endif // GRABADOR_DE_CAPTURA_H
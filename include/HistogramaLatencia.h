@@ -0,0 +1,80 @@
+/**
+ * @file HistogramaLatencia.h
+ * @brief Histograma log-lineal de memoria fija para latencias
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cuenta valores de 64 bits en cubetas log-lineales
+ *
+ * Cada potencia de dos se parte en SUBCUBETAS cubetas del mismo ancho, asi
+ * que el error relativo de un percentil es a lo sumo 1/SUBCUBETAS (6.25%)
+ * para cualquier magnitud, de ciclos a minutos. Los valores menores que
+ * SUBCUBETAS se cuentan exactos. Registrar es O(1) sin memoria dinamica:
+ * todas las cubetas viven dentro del objeto (unos 8 KB).
+ */
+class HistogramaLatencia {
+public:
+    static const int BITS_SUBCUBETA = 4;                                    ///< log2 de las subcubetas por potencia de dos
+    static const int SUBCUBETAS = 1 << BITS_SUBCUBETA;                      ///< Subcubetas por potencia de dos
+    static const int NUM_CUBETAS = (64 - BITS_SUBCUBETA + 1) * SUBCUBETAS;  ///< Cubetas para todo el rango de 64 bits
+
+private:
+    unsigned long long cubetas[NUM_CUBETAS];    ///< Cuentas por cubeta
+    unsigned long long muestras;                ///< Valores registrados
+    unsigned long long maximo;                  ///< Mayor valor registrado (exacto)
+
+public:
+    /**
+     * @brief Constructor - Histograma vacio
+     */
+    HistogramaLatencia();
+
+    /**
+     * @brief Cuenta un valor
+     */
+    void registrar(unsigned long long valor);
+
+    /**
+     * @brief Vacia el histograma
+     */
+    void reiniciar();
+
+    /**
+     * @brief Valor bajo el cual cae la fraccion pedida de las muestras
+     *
+     * Devuelve el limite superior de la cubeta que contiene el percentil
+     * (acotado al maximo registrado), nunca un valor menor que el real.
+     *
+     * @param fraccion Entre 0 y 1 (0.5 = p50, 0.999 = p999)
+     * @return Valor del percentil, o 0 si no hay muestras
+     */
+    unsigned long long percentil(double fraccion) const;
+
+    /**
+     * @brief Valores registrados
+     */
+    unsigned long long getMuestras() const;
+
+    /**
+     * @brief Mayor valor registrado
+     */
+    unsigned long long getMaximo() const;
+
+    /**
+     * @brief Cubeta de un valor
+     */
+    static int indiceCubeta(unsigned long long valor);
+
+    /**
+     * @brief Mayor valor que cae en una cubeta
+     */
+    static unsigned long long limiteSuperior(int indice);
+};
+
+#endif // HISTOGRAMA_LATENCIA_H
@@ -0,0 +1,104 @@
+/**
+ * @file LatenciaEnlace.h
+ * @brief Latencia de extremo a extremo (ESP32 -> ListaDeCarga) con las marcas de tiempo del firmware
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Con --latencia-enlace el host envia SOLICITUD_MARCAS y el firmware
+ * antepone a cada trama de texto su micros() al momento del println:
+ * "@81234567,L,H". Por cada trama con marca se guardan la marca (reloj del
+ * ESP32), el instante en que leerLinea() la entrego (recepcion) y, para
+ * las LOAD, el instante en que el caracter quedo en ListaDeCarga
+ * (insercion), ambos en el reloj del host.
+ *
+ * Los relojes no comparten origen y derivan unas decenas de ppm, asi que
+ * al terminar se estima la diferencia entre ambos con el envolvente
+ * inferior: en cada mitad de la captura, la trama mas rapida se supone
+ * que solo tardo lo que cuesta transmitir sus bytes (a 115200 baudios con
+ * el puerto serial; nada con stdin o una captura), y la recta entre esas
+ * dos tramas da el desfase y la deriva. La latencia de cada trama es lo
+ * que se aleja de esa recta; la fluctuacion es el estimador de RFC 3550
+ * (media movil 1/16 de la diferencia entre latencias consecutivas).
+ */
+
+#ifndef LATENCIA_ENLACE_H
+#define LATENCIA_ENLACE_H
+
+/// Linea que pide al firmware las marcas de tiempo
+#define SOLICITUD_MARCAS "PRT7?TS"
+
+/// Respuesta del firmware (el parser la ignora como texto de banner)
+#define CONFIRMACION_MARCAS "PRT7:TS"
+
+/**
+ * @struct MuestraEnlace
+ * @brief Tiempos de una trama con marca
+ */
+struct MuestraEnlace {
+    unsigned long long emision;     ///< Reloj del ESP32 en us, sin vueltas
+    unsigned long long recepcion;   ///< Reloj del host en ns al salir de leerLinea()
+    unsigned long long insercion;   ///< Reloj del host en ns con el caracter en la lista (0 si no es LOAD)
+    int bytes;                      ///< Bytes de la linea en el cable (con "\r\n")
+};
+
+/**
+ * @class LatenciaEnlace
+ * @brief Acumula muestras por trama y reporta latencia de un sentido y fluctuacion
+ */
+class LatenciaEnlace {
+public:
+    static const int CAPACIDAD_POR_DEFECTO = 1 << 20;   ///< Muestras guardadas (24 MB)
+    static const int BAUDIOS = 115200;                  ///< Velocidad del enlace (8N1: 10 bits por byte)
+
+private:
+    MuestraEnlace* muestras;        ///< Muestras en orden de llegada
+    int capacidad;                  ///< Tamanio de muestras
+    int baudios;                    ///< Velocidad para el tiempo de transmision (0 = sin contarlo)
+    int usadas;                     ///< Muestras guardadas
+    unsigned long long perdidas;    ///< Tramas con marca que no cupieron
+    unsigned int ultimaMarca;       ///< Ultima marca recibida (para contar las vueltas de 2^32)
+    unsigned long long relojEmisor; ///< Marca sin vueltas de la ultima trama
+
+public:
+    /**
+     * @brief Constructor - Reserva las muestras
+     * @param baudios Velocidad del enlace (BAUDIOS con el puerto; 0 si no hay UART de por medio)
+     * @param capacidad Muestras a guardar
+     */
+    explicit LatenciaEnlace(int baudios, int capacidad = CAPACIDAD_POR_DEFECTO);
+
+    /**
+     * @brief Destructor
+     */
+    ~LatenciaEnlace();
+
+    /**
+     * @brief Guarda una trama con marca
+     * @param marca Trama::marca
+     * @param bytes Largo de la linea sin "\r\n"
+     * @param recepcion ahora() al salir de leerLinea()
+     * @param insercion ahora() despues de aplicar la trama (0 si no agrega caracteres)
+     */
+    void registrar(unsigned int marca, int bytes, unsigned long long recepcion, unsigned long long insercion);
+
+    /**
+     * @brief Tramas con marca registradas
+     */
+    int getMuestras() const;
+
+    /**
+     * @brief Imprime desfase, deriva, percentiles de latencia y fluctuacion (en stderr)
+     */
+    void imprimir() const;
+
+    /**
+     * @brief Reloj del host en nanosegundos (steady_clock)
+     */
+    static unsigned long long ahora();
+
+private:
+    LatenciaEnlace(const LatenciaEnlace&);
+    LatenciaEnlace& operator=(const LatenciaEnlace&);
+};
+
+#endif // LATENCIA_ENLACE_H
@@ -0,0 +1,130 @@
+/**
+ * @file LatenciaPorEtapa.h
+ * @brief Latencias por etapa del bucle principal (lectura, parseo, decodificacion, insercion)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * El bucle secuencial toma una muestra cada N tramas (--latencias[=N]) y
+ * registra en un HistogramaLatencia por etapa el tiempo que paso esa trama
+ * en cada una:
+ *
+ * - lectura: FuenteDeTramas::leerLinea() (en el puerto serial incluye la
+ *   espera a que lleguen los bytes)
+ * - parseo: parsearTrama(), con su traza "Trama recibida"
+ * - decodificacion: RotorDeMapeo::getMapeo(), decodificarBloque() o rotar()
+ * - insercion: ListaDeCarga::insertarAlFinal() / insertarBloque() con el eco
+ *   de consola
+ *
+ * Las marcas se leen del contador de ciclos (rdtsc en x86, steady_clock en
+ * el resto) y se pasan a nanosegundos al imprimir. Las tramas no muestreadas
+ * solo pagan un contador y una comparacion; compilando sin PRT7_LATENCIAS
+ * (opcion de CMake) las macros LATENCIA_* desaparecen por completo.
+ */
+
+#ifndef LATENCIA_POR_ETAPA_H
+#define LATENCIA_POR_ETAPA_H
+
+#include "HistogramaLatencia.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LATENCIA_CON_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+
+/**
+ * @enum EtapaLatencia
+ * @brief Etapas medidas por trama
+ */
+enum EtapaLatencia {
+    ETAPA_LECTURA,          ///< FuenteDeTramas::leerLinea
+    ETAPA_PARSEO,           ///< parsearTrama
+    ETAPA_DECODIFICACION,   ///< Mapeo o rotacion del rotor
+    ETAPA_INSERCION,        ///< Insercion en la lista con su eco
+    NUM_ETAPAS_LATENCIA     ///< Cantidad de etapas
+};
+
+/// Tramas por muestra (0 = sin medir). Solo lo escribe habilitarLatencias()
+extern unsigned int periodoMuestreoLatencia;
+
+/// Tramas desde la ultima muestra (solo el bucle secuencial la avanza)
+extern unsigned int cuentaMuestreoLatencia;
+
+/// La trama en curso del bucle secuencial se esta midiendo
+extern bool muestraLatenciaEnCurso;
+
+/**
+ * @brief Empieza a medir
+ * @param periodo Una muestra cada periodo tramas (1 = todas)
+ */
+void habilitarLatencias(unsigned int periodo);
+
+/**
+ * @brief Indica si se estan midiendo latencias
+ */
+bool latenciasHabilitadas();
+
+/**
+ * @brief Registra el tiempo de una etapa
+ * @param etapa Etapa medida
+ * @param desde Marca al entrar en la etapa
+ * @param hasta Marca al salir
+ */
+void registrarLatencia(EtapaLatencia etapa, unsigned long long desde, unsigned long long hasta);
+
+/**
+ * @brief Histograma de una etapa (en ticks de marcaLatencia)
+ */
+const HistogramaLatencia& obtenerHistogramaLatencia(EtapaLatencia etapa);
+
+/**
+ * @brief Imprime p50/p99/p999/max de cada etapa en nanosegundos (en stderr)
+ */
+void imprimirLatencias();
+
+/**
+ * @brief Marca de tiempo en ticks (ciclos en x86, nanosegundos en el resto)
+ */
+inline unsigned long long marcaLatencia() {
+#ifdef LATENCIA_CON_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Decide si la trama que empieza se mide
+ * @return true una vez cada periodoMuestreoLatencia llamadas
+ */
+inline bool comenzarMuestraLatencia() {
+    bool muestra = periodoMuestreoLatencia != 0 && ++cuentaMuestreoLatencia >= periodoMuestreoLatencia;
+    if (muestra) cuentaMuestreoLatencia = 0;
+    muestraLatenciaEnCurso = muestra;
+    return muestra;
+}
+
+#ifdef PRT7_LATENCIAS
+/// Decide si se mide la trama que empieza (bucle secuencial)
+#define LATENCIA_MUESTRA(muestra) bool muestra = comenzarMuestraLatencia()
+/// Consulta si se esta midiendo la trama en curso (dentro del despacho)
+#define LATENCIA_EN_CURSO(muestra) bool muestra = muestraLatenciaEnCurso
+/// Toma una marca de tiempo solo si se mide
+#define LATENCIA_MARCA(muestra, marca) unsigned long long marca = (muestra) ? marcaLatencia() : 0
+/// Registra hasta - desde en el histograma de la etapa
+#define LATENCIA_ETAPA(muestra, etapa, desde, hasta) \
+    do { if (muestra) registrarLatencia((etapa), (desde), (hasta)); } while (0)
+#else
+#define LATENCIA_MUESTRA(muestra)
+#define LATENCIA_EN_CURSO(muestra)
+#define LATENCIA_MARCA(muestra, marca)
+#define LATENCIA_ETAPA(muestra, etapa, desde, hasta) do { } while (0)
+#endif
+
+#endif // LATENCIA_POR_ETAPA_H
@@ -8,36 +8,39 @@
 #ifndef LISTA_DE_CARGA_H
 #define LISTA_DE_CARGA_H
 
-/**
- * @struct NodoCarga
- * @brief Nodo de la lista doblemente enlazada
- */
-struct NodoCarga {
-    char dato;              ///< Caracter decodificado almacenado
-    NodoCarga* siguiente;   ///< Puntero al siguiente nodo (nullptr si es el ultimo)
-    NodoCarga* previo;      ///< Puntero al nodo previo (nullptr si es el primero)
-    
-    /**
-     * @brief Constructor del nodo
-     * @param c Caracter a almacenar
-     */
-    NodoCarga(char c) : dato(c), siguiente(nullptr), previo(nullptr) {}
-};
+#include "PoolDeBloques.h"
 
 /**
  * @class ListaDeCarga
- * @brief Lista lineal doblemente enlazada que almacena el mensaje
+ * @brief Lista doblemente enlazada desenrollada que almacena el mensaje
+ *
+ * Cada nodo (BloqueCarga) guarda miles de caracteres contiguos y se obtiene
+ * de un PoolDeBloques, asi que insertar un caracter casi nunca pide memoria:
+ * solo se escribe en el bloque de la cola hasta que se llena.
  */
 class ListaDeCarga {
 private:
-    NodoCarga* cabeza;  ///< Puntero al primer nodo (nullptr si esta vacia)
-    NodoCarga* cola;    ///< Puntero al ultimo nodo (nullptr si esta vacia)
-    int tamanio;        ///< Numero de caracteres almacenados
+    BloqueCarga* cabeza;    ///< Puntero al primer bloque (nullptr si esta vacia)
+    BloqueCarga* cola;      ///< Puntero al ultimo bloque (nullptr si esta vacia)
+    long long tamanio;      ///< Numero de caracteres almacenados (una captura mapeada puede pasar de 2^31)
+    PoolDeBloques pool;     ///< Origen de los bloques de la lista
+
+    /**
+     * @brief Agrega un bloque vacio al final de la lista
+     */
+    void agregarBloque();
     
     /**
      * @brief Imprime el mensaje en una linea (metodo auxiliar para debug)
      */
     void imprimirMensajeEnLinea();
+
+    /**
+     * @brief Imprime solo el fragmento recien agregado y la longitud actual
+     * @param fragmento Caracteres agregados
+     * @param n Numero de caracteres agregados
+     */
+    void imprimirFragmento(const char* fragmento, int n);
     
 public:
     /**
@@ -52,10 +55,43 @@ public:
     
     /**
      * @brief Inserta un caracter al final de la lista
+     *
+     * El eco en consola depende del NivelDetalle: con DETALLE_TRAMA solo se
+     * imprime el fragmento nuevo; con DETALLE_DEMO, el mensaje completo.
+     *
      * @param dato Caracter a insertar
      */
     void insertarAlFinal(char dato);
+
+    /**
+     * @brief Inserta varios caracteres al final de la lista (un solo eco por bloque)
+     * @param datos Caracteres ya decodificados
+     * @param n Numero de caracteres
+     */
+    void insertarBloque(const char* datos, int n);
+
+    /**
+     * @brief Inserta varios caracteres al final sin eco en consola
+     *
+     * Lo usa la reanudacion desde un DiarioDeDecodificacion: el mensaje
+     * restaurado ya se mostro en la ejecucion anterior.
+     *
+     * @param datos Caracteres ya decodificados
+     * @param n Numero de caracteres
+     */
+    void insertarBloqueSinEco(const char* datos, int n);
     
+    /**
+     * @brief Reserva memoria para que los siguientes N caracteres no pidan bloques
+     * @param caracteres Caracteres adicionales que se esperan
+     */
+    void reservar(long long caracteres);
+
+    /**
+     * @brief Deja la lista vacia y devuelve sus bloques al pool para reutilizarlos
+     */
+    void vaciar();
+
     /**
      * @brief Imprime el mensaje completo almacenado
      */
@@ -65,13 +101,40 @@ public:
      * @brief Obtiene el numero de caracteres en la lista
      * @return Tamanio de la lista
      */
-    int getTamanio() const;
+    long long getTamanio() const;
     
     /**
      * @brief Verifica si la lista esta vacia
      * @return true si esta vacia, false si tiene elementos
      */
     bool estaVacia() const;
+
+    /**
+     * @brief Copia el mensaje a un buffer (terminado en '\0')
+     * @param destino Buffer de salida
+     * @param capacidad Tamanio del buffer (incluyendo el '\0')
+     * @return Numero de caracteres copiados
+     */
+    int copiarMensaje(char* destino, int capacidad) const;
+
+    /**
+     * @brief Copia un tramo del mensaje (sin '\0')
+     * @param desde Posicion del primer caracter
+     * @param destino Buffer de al menos n bytes
+     * @param n Caracteres a copiar
+     * @return Caracteres copiados (menos si el mensaje termina antes)
+     */
+    int copiarTramo(long long desde, char* destino, int n) const;
+
+    /**
+     * @brief Memoria pedida al sistema para guardar el mensaje
+     * @return Bytes reservados por el pool de bloques
+     */
+    long long getBytesReservados() const;
+
+private:
+    ListaDeCarga(const ListaDeCarga&);
+    ListaDeCarga& operator=(const ListaDeCarga&);
 };
 
 #endif // LISTA_DE_CARGA_H
@@ -0,0 +1,83 @@
+/**
+ * @file MetricasDecodificador.h
+ * @brief Contadores y medidores del decodificador, exportables en formato Prometheus
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Todos los campos son atomicos sin bloqueo, asi que ExportadorMetricas los
+ * lee desde su hilo mientras el decodificador los actualiza. Los contadores
+ * por trama los escribe un solo hilo (el que decodifica) con carga + almacen
+ * relajados, que en x86 son dos mov sin prefijo lock; los que pueden
+ * escribir varios hilos (lineas invalidas, timeouts de los puertos) usan
+ * fetch_add, pero solo se tocan en caminos que ya son lentos.
+ */
+
+#ifndef METRICAS_DECODIFICADOR_H
+#define METRICAS_DECODIFICADOR_H
+
+#include <atomic>
+#include "Trama.h"
+
+/**
+ * @struct MetricasDecodificador
+ * @brief Estado observable del decodificador
+ */
+struct MetricasDecodificador {
+    static const int NUM_TIPOS = TRAMA_FIN + 1;     ///< Entradas de 'tramas' (indice TipoTrama)
+    static const unsigned int PERIODO_PUBLICACION = 256;    ///< Lineas entre dos publicarFuente/publicarMensaje
+
+    std::atomic<unsigned long long> tramas[NUM_TIPOS];      ///< Tramas validas por tipo (un escritor)
+    std::atomic<unsigned long long> lineasCortas;           ///< "Trama invalida (muy corta)"
+    std::atomic<unsigned long long> lineasDesconocidas;     ///< "Tipo de trama desconocido"
+    std::atomic<unsigned long long> lineasIgnoradas;        ///< Texto sin "X," (banner del ESP32)
+    std::atomic<unsigned long long> timeoutsLectura;        ///< Lecturas del puerto vencidas sin linea
+    std::atomic<unsigned long long> bytesLeidos;            ///< Bytes leidos de la fuente (un escritor)
+    std::atomic<long long> longitudMensaje;                 ///< Caracteres en el mensaje (un escritor)
+    std::atomic<int> desplazamientoRotor;                   ///< Cabeza del rotor, 0-26 (un escritor)
+
+    /**
+     * @brief Constructor - Todo en cero
+     */
+    MetricasDecodificador();
+
+    /**
+     * @brief Cuenta una trama valida (solo desde el hilo que decodifica)
+     */
+    void contarTrama(TipoTrama tipo) {
+        tramas[tipo].store(tramas[tipo].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publica los bytes leidos (solo desde el hilo que lee la fuente)
+     */
+    void publicarFuente(unsigned long long bytes) {
+        bytesLeidos.store(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publica el largo del mensaje y la cabeza del rotor (solo desde el hilo que decodifica)
+     */
+    void publicarMensaje(long long longitud, int desplazamiento) {
+        longitudMensaje.store(longitud, std::memory_order_relaxed);
+        desplazamientoRotor.store(desplazamiento, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Escribe una instantanea en el formato de texto de Prometheus
+     * @param destino Buffer de salida
+     * @param capacidad Bytes disponibles (alcanza con CAPACIDAD_TEXTO)
+     * @return Bytes escritos (sin '\0')
+     */
+    int escribirTexto(char* destino, int capacidad) const;
+
+    static const int CAPACIDAD_TEXTO = 4096;    ///< Buffer suficiente para escribirTexto()
+
+private:
+    MetricasDecodificador(const MetricasDecodificador&);
+    MetricasDecodificador& operator=(const MetricasDecodificador&);
+};
+
+/// Metricas del proceso (las actualizan el bucle principal o la tuberia, parsearTrama y SerialPort)
+extern MetricasDecodificador metricas;
+
+#endif // METRICAS_DECODIFICADOR_H
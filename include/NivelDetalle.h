@@ -0,0 +1,91 @@
+/**
+ * @file NivelDetalle.h
+ * @brief Nivel de detalle de la salida por consola del decodificador
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef NIVEL_DETALLE_H
+#define NIVEL_DETALLE_H
+
+/**
+ * @enum NivelDetalle
+ * @brief Cuanto imprime el decodificador mientras procesa tramas
+ *
+ * Se elige una vez al arrancar y lo consultan el parser, el rotor y la
+ * lista de carga. Todos los niveles excepto DETALLE_DEMO cuestan tiempo
+ * lineal en el tamanio del mensaje.
+ */
+enum NivelDetalle {
+    DETALLE_SILENCIOSO, ///< Solo el mensaje final (sin banners ni trazas)
+    DETALLE_RESUMEN,    ///< Banners y mensaje final, sin trazas por trama
+    DETALLE_TRAMA,      ///< Una linea por trama con el fragmento nuevo y la longitud
+    DETALLE_DEMO        ///< Una linea por trama con el mensaje completo (O(n^2))
+};
+
+/**
+ * @brief Establece el nivel de detalle global
+ * @param nivel Nivel a usar a partir de ahora
+ */
+void establecerNivelDetalle(NivelDetalle nivel);
+
+/**
+ * @brief Obtiene el nivel de detalle global (por defecto DETALLE_TRAMA)
+ * @return Nivel actual
+ */
+NivelDetalle obtenerNivelDetalle();
+
+/**
+ * @brief Convierte un nombre ("silencioso", "resumen", "trama", "demo") en nivel
+ * @param texto Nombre del nivel
+ * @param nivel Destino del nivel reconocido
+ * @return true si el nombre es valido
+ */
+bool parsearNivelDetalle(const char* texto, NivelDetalle* nivel);
+
+/**
+ * @brief Agrupa las trazas de tramas MAP seguidas (ver RotorDeMapeo::rotar)
+ *
+ * Con trazas por trama, en lugar de una linea por MAP se imprime una sola
+ * con la rotacion neta cuando la siguiente LOAD la usa.
+ *
+ * @param diferida true para agrupar (por defecto false)
+ */
+void establecerRotacionDiferida(bool diferida);
+
+/**
+ * @brief Indica si las trazas de MAP se agrupan
+ */
+bool obtenerRotacionDiferida();
+
+/**
+ * @brief Reconoce el prefijo de sesion "#<id>," en interpretarTrama()
+ *
+ * Solo con --sesiones: sin ellas una linea que empieza con '#' es texto
+ * del banner y se ignora en silencio.
+ *
+ * @param activas true para multiplexar sesiones (por defecto false)
+ */
+void establecerSesionesMultiplexadas(bool activas);
+
+/**
+ * @brief Indica si se reconoce el prefijo de sesion
+ */
+bool obtenerSesionesMultiplexadas();
+
+/**
+ * @brief Reconoce la marca de tiempo "@<us>," en interpretarTrama()
+ *
+ * Solo con --latencia-enlace: sin ella una linea que empieza con '@' es
+ * texto del banner y se ignora en silencio.
+ *
+ * @param activas true para leer las marcas (por defecto false)
+ */
+void establecerMarcasDeTiempo(bool activas);
+
+/**
+ * @brief Indica si se reconoce la marca de tiempo
+ */
+bool obtenerMarcasDeTiempo();
+
+#endif // NIVEL_DETALLE_H
@@ -0,0 +1,106 @@
+/**
+ * @file PoolDeBloques.h
+ * @brief Pool de bloques de caracteres para la ListaDeCarga
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef POOL_DE_BLOQUES_H
+#define POOL_DE_BLOQUES_H
+
+/**
+ * @struct BloqueCarga
+ * @brief Nodo de la lista desenrollada: guarda muchos caracteres por nodo
+ *
+ * El tamanio total del bloque es de 4 KB para que el costo de los punteros
+ * y del contador se reparta entre miles de caracteres.
+ */
+struct BloqueCarga {
+    static const int CAPACIDAD = 4096 - 2 * sizeof(void*) - sizeof(int) * 2;  ///< Caracteres por bloque
+
+    BloqueCarga* siguiente;     ///< Puntero al siguiente bloque (nullptr si es el ultimo)
+    BloqueCarga* previo;        ///< Puntero al bloque previo (nullptr si es el primero)
+    int usados;                 ///< Caracteres ocupados en datos[]
+    char datos[CAPACIDAD];      ///< Caracteres decodificados, en orden de llegada
+};
+
+/**
+ * @class PoolDeBloques
+ * @brief Reparte bloques sacados de losas grandes en lugar de un new por bloque
+ *
+ * Cada losa es un arreglo contiguo de bloques; las losas crecen al doble
+ * (hasta un maximo) conforme se piden mas bloques. Los bloques devueltos se
+ * guardan en una lista libre para reutilizarse, y la memoria solo se libera
+ * al destruir el pool (una llamada a delete[] por losa).
+ */
+class PoolDeBloques {
+private:
+    /**
+     * @struct Losa
+     * @brief Arreglo de bloques pedido de una sola vez al sistema
+     */
+    struct Losa {
+        BloqueCarga* bloques;   ///< Arreglo de bloques
+        int cantidad;           ///< Bloques en el arreglo
+        Losa* siguiente;        ///< Losa anterior en la cadena
+    };
+
+    static const int LOSA_INICIAL = 1;      ///< Bloques en la primera losa
+    static const int LOSA_MAXIMA = 64;      ///< Tope de bloques por losa (256 KB)
+
+    Losa* losas;                ///< Cadena de losas pedidas
+    int siguienteLibre;         ///< Indice del proximo bloque sin usar en la losa actual
+    BloqueCarga* listaLibre;    ///< Bloques devueltos listos para reutilizarse
+    int bloquesLibres;          ///< Bloques en listaLibre
+    long long bytesReservados;  ///< Memoria total pedida al sistema
+
+    /**
+     * @brief Pide una nueva losa al sistema
+     */
+    void agregarLosa();
+
+public:
+    /**
+     * @brief Constructor - Pool vacio (no reserva memoria hasta el primer bloque)
+     */
+    PoolDeBloques();
+
+    /**
+     * @brief Destructor - Libera todas las losas
+     */
+    ~PoolDeBloques();
+
+    /**
+     * @brief Obtiene un bloque vacio
+     * @return Bloque con usados = 0 y punteros en nullptr
+     */
+    BloqueCarga* obtener();
+
+    /**
+     * @brief Devuelve un bloque al pool para reutilizarlo
+     * @param bloque Bloque obtenido previamente con obtener()
+     */
+    void devolver(BloqueCarga* bloque);
+
+    /**
+     * @brief Asegura que haya al menos N bloques disponibles sin pedir memoria
+     *
+     * Los bloques que falten se piden en una sola losa y quedan en la lista
+     * libre, de modo que los siguientes obtener() no llaman a new.
+     *
+     * @param bloques Numero de bloques que se desean tener disponibles
+     */
+    void reservar(int bloques);
+
+    /**
+     * @brief Memoria total pedida al sistema por el pool
+     * @return Bytes reservados
+     */
+    long long getBytesReservados() const;
+
+private:
+    PoolDeBloques(const PoolDeBloques&);
+    PoolDeBloques& operator=(const PoolDeBloques&);
+};
+
+#endif // POOL_DE_BLOQUES_H
@@ -0,0 +1,94 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Modo binario compacto de PRT-7 (negociado con el ESP32)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * En modo texto cada trama es una linea ("L,H\r\n" = 5 bytes, "M,-2\r\n" =
+ * 6 bytes). En modo binario cada trama empieza con un byte de etiqueta:
+ *
+ * | Bytes                 | Trama                                        |
+ * |-----------------------|----------------------------------------------|
+ * | 0x80 + i (i < 27)     | LOAD de "ABC...XYZ "[i] (etiqueta = dato)    |
+ * | 0x01 c                | LOAD de cualquier otro byte c                |
+ * | 0x02 varint           | MAP; rotacion en zigzag + varint LEB128      |
+ * | 0x03                  | FIN                                          |
+ * | 0x16 0xA5             | Marca de sincronia (no es trama)             |
+ *
+ * Una LOAD del alfabeto ocupa 1 byte y un MAP de -63..63, 2 bytes. El
+ * ESP32 envia la marca de sincronia al entrar en modo binario y cada
+ * PERIODO_SINCRONIA registros (una rafaga "L,HOLA" son cuatro); ante un
+ * byte de etiqueta desconocido el receptor descarta bytes hasta la
+ * siguiente marca.
+ *
+ * Negociacion: el host envia la linea de texto SOLICITUD_BINARIO; un
+ * firmware que la entiende contesta con la linea CONFIRMACION_BINARIO y a
+ * partir del byte siguiente transmite en binario. Un firmware que no la
+ * entiende la ignora y todo sigue en modo texto.
+ *
+ * arduino/src/main.cpp repite estas constantes (es otro proyecto).
+ */
+
+#ifndef PROTOCOLO_BINARIO_H
+#define PROTOCOLO_BINARIO_H
+
+struct Trama;
+
+/// Linea que envia el host para pedir el modo binario
+#define SOLICITUD_BINARIO "PRT7?BIN"
+
+/// Linea con que el ESP32 confirma el cambio (lo siguiente ya es binario)
+#define CONFIRMACION_BINARIO "PRT7:BIN"
+
+/**
+ * @enum EtiquetaBinaria
+ * @brief Primer byte de cada trama binaria
+ */
+enum EtiquetaBinaria {
+    BIN_CARGA_CRUDA = 0x01,     ///< LOAD seguida del byte tal cual
+    BIN_MAPA = 0x02,            ///< MAP seguida de un varint zigzag
+    BIN_FIN = 0x03,             ///< FIN
+    BIN_SINCRONIA = 0x16,       ///< Primer byte de la marca de sincronia (SYN)
+    BIN_CARGA_ALFABETO = 0x80   ///< 0x80..0x9A: LOAD de una letra del alfabeto o espacio
+};
+
+const unsigned char BIN_SINCRONIA_2 = 0xA5;     ///< Segundo byte de la marca de sincronia
+const int PERIODO_SINCRONIA = 64;               ///< Registros binarios entre marcas de sincronia
+const int TRAMA_BINARIA_MAXIMA = 6;             ///< Bytes de la trama mas larga (MAP con varint de 5)
+
+/**
+ * @enum ResultadoBinario
+ * @brief Resultado de interpretar bytes en modo binario
+ */
+enum ResultadoBinario {
+    BINARIO_TRAMA,          ///< Se obtuvo una trama
+    BINARIO_SINCRONIA,      ///< Marca de sincronia (sin trama)
+    BINARIO_INCOMPLETO,     ///< Faltan bytes para terminar la trama
+    BINARIO_INVALIDO        ///< Etiqueta desconocida o varint demasiado largo
+};
+
+/**
+ * @brief Codifica una trama LOAD, MAP o FIN en binario
+ * @param trama Trama a codificar
+ * @param destino Al menos TRAMA_BINARIA_MAXIMA bytes
+ * Una LOAD de varios caracteres ("L,HOLA") no tiene etiqueta propia: en
+ * binario cada caracter ya ocupa un byte, asi que se envia caracter por
+ * caracter.
+ *
+ * @return Bytes escritos (0 si la trama no es LOAD de un caracter, MAP ni FIN,
+ *         o si es la LOAD de '\0', que no se puede entregar como linea)
+ */
+int codificarTramaBinaria(const Trama& trama, unsigned char* destino);
+
+/**
+ * @brief Interpreta la trama binaria al inicio de un bloque de bytes
+ * @param datos Bytes recibidos
+ * @param disponibles Bytes en datos
+ * @param trama Destino de la trama (solo con BINARIO_TRAMA)
+ * @param consumidos Bytes que ocupa la trama o la marca (1 si es invalido)
+ * @return Resultado de la interpretacion
+ */
+ResultadoBinario interpretarTramaBinaria(const unsigned char* datos, int disponibles,
+                                         Trama* trama, int* consumidos);
+
+#endif // PROTOCOLO_BINARIO_H
@@ -0,0 +1,122 @@
+/**
+ * @file RegistroAsincrono.h
+ * @brief Registro de trazas en un anillo preasignado vaciado por un hilo aparte
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Las trazas por trama (parsearTrama, RotorDeMapeo::rotar, ListaDeCarga) se
+ * arman en un Registro en la pila y al terminar la expresion se copian al
+ * anillo; un hilo las saca en lotes grandes hacia std::cout / std::cerr. El
+ * decodificador ya no espera a la terminal en cada std::endl.
+ *
+ * Sin iniciarRegistro() (benchmarks, --puertos) cada Registro se escribe
+ * directo en std::cout o std::cerr, como antes.
+ */
+
+#ifndef REGISTRO_ASINCRONO_H
+#define REGISTRO_ASINCRONO_H
+
+/**
+ * @enum NivelRegistro
+ * @brief Severidad de un registro (decide el destino y si puede perderse)
+ */
+enum NivelRegistro {
+    REGISTRO_TRAZA,     ///< Traza por trama (std::cout); la unica que REGISTRO_DESCARTAR puede perder
+    REGISTRO_INFO,      ///< Aviso de estado (std::cout)
+    REGISTRO_AVISO,     ///< Algo inesperado pero recuperable (std::cerr)
+    REGISTRO_ERROR      ///< Error (std::cerr)
+};
+
+/**
+ * @enum PoliticaRegistroLleno
+ * @brief Que hace quien registra cuando el anillo esta lleno
+ */
+enum PoliticaRegistroLleno {
+    REGISTRO_ESPERAR,   ///< Esperar al hilo de escritura (no se pierde nada)
+    REGISTRO_DESCARTAR  ///< Descartar las trazas que no caben (y dejar una marca con cuantas)
+};
+
+/**
+ * @brief Arranca el hilo de escritura
+ * @param politica Comportamiento con el anillo lleno
+ * @param capacidad Bytes de cada anillo (se redondea a potencia de dos)
+ */
+void iniciarRegistro(PoliticaRegistroLleno politica, int capacidad = 1 << 20);
+
+/**
+ * @brief Espera a que todo lo registrado este escrito (y std::cout vaciado)
+ *
+ * Se llama al recibir FIN y antes de imprimir por std::cout fuera del registro.
+ */
+void vaciarRegistro();
+
+/**
+ * @brief Vacia el registro y detiene el hilo de escritura
+ */
+void detenerRegistro();
+
+/**
+ * @brief Trazas descartadas por REGISTRO_DESCARTAR
+ */
+unsigned long long getTrazasDescartadas();
+
+/**
+ * @brief Copia texto ya formateado al registro
+ * @param nivel Severidad
+ * @param texto Texto (sin '\0' obligatorio)
+ * @param n Bytes (a lo sumo Registro::CAPACIDAD)
+ * @return false si la traza se descarto por tener el anillo lleno
+ */
+bool publicarRegistro(NivelRegistro nivel, const char* texto, int n);
+
+/**
+ * @class Registro
+ * @brief Formatea un registro en la pila y lo publica al destruirse
+ *
+ * Uso: Registro(REGISTRO_TRAZA) << "Trama recibida: [" << linea << "]\n";
+ * Un registro mas largo que CAPACIDAD se publica por tramos; si un tramo de
+ * una traza se descarta, se descarta tambien el resto.
+ */
+class Registro {
+public:
+    static const int CAPACIDAD = 256;   ///< Bytes formateados antes de publicar un tramo
+
+private:
+    NivelRegistro nivel;        ///< Severidad
+    int usados;                 ///< Bytes en texto
+    bool descartado;            ///< Un tramo anterior se descarto
+    char texto[CAPACIDAD];      ///< Texto formateado
+
+    /**
+     * @brief Publica lo acumulado
+     */
+    void publicar();
+
+public:
+    /**
+     * @brief Constructor - Registro vacio
+     */
+    explicit Registro(NivelRegistro nivel);
+
+    /**
+     * @brief Destructor - Publica el registro
+     */
+    ~Registro();
+
+    /**
+     * @brief Agrega bytes
+     */
+    Registro& escribir(const char* datos, int n);
+
+    Registro& operator<<(const char* cadena);   ///< Agrega una cadena terminada en '\0'
+    Registro& operator<<(char c);               ///< Agrega un caracter
+    Registro& operator<<(int n);                ///< Agrega un entero en decimal
+    Registro& operator<<(long long n);          ///< Agrega un entero en decimal
+    Registro& operator<<(unsigned long long n); ///< Agrega un entero en decimal
+
+private:
+    Registro(const Registro&);
+    Registro& operator=(const Registro&);
+};
+
+#endif // REGISTRO_ASINCRONO_H
@@ -1,6 +1,6 @@
 /**
  * @file RotorDeMapeo.h
- * @brief Lista circular para el rotor de mapeo de caracteres
+ * @brief Rotor circular de mapeo de caracteres (alfabeto contiguo + desplazamiento)
  * @author Elias de Jesus Zuniga de Leon
  * @date 2025-11-06
  */
@@ -8,73 +8,124 @@
 #ifndef ROTOR_DE_MAPEO_H
 #define ROTOR_DE_MAPEO_H
 
-/**
- * @struct NodoRotor
- * @brief Nodo de la lista circular doblemente enlazada
- */
-struct NodoRotor {
-    char dato;              ///< Caracter almacenado (A-Z o espacio)
-    NodoRotor* siguiente;   ///< Puntero al siguiente nodo (circular)
-    NodoRotor* previo;      ///< Puntero al nodo previo (circular)
-    
-    /**
-     * @brief Constructor del nodo
-     * @param c Caracter a almacenar
-     */
-    NodoRotor(char c) : dato(c), siguiente(nullptr), previo(nullptr) {}
-};
+struct TablasRotor;
 
 /**
  * @class RotorDeMapeo
- * @brief Lista circular con 27 nodos (A-Z + espacio) para mapear caracteres
+ * @brief Anillo de 27 posiciones (A-Z + espacio) para mapear caracteres
+ *
+ * El anillo se guarda como un arreglo contiguo con el alfabeto y un entero
+ * que indica la posicion "cero" actual (la cabeza). Avanzar la cabeza es
+ * sumar modulo 27, por lo que rotar y mapear son operaciones O(1) en lugar
+ * de recorrer nodo por nodo una lista circular.
+ *
+ * Las tablas (alfabeto, posicion de cada byte y mapeo precalculado para cada
+ * uno de los 27 desplazamientos) son de solo lectura y se comparten entre
+ * todas las instancias.
  */
 class RotorDeMapeo {
+public:
+    static const int TAMANIO = 27;  ///< Posiciones del anillo (A-Z + espacio)
+
 private:
-    NodoRotor* cabeza;  ///< Puntero a la posicion "cero" actual del rotor
-    
-    /**
-     * @brief Busca un nodo que contiene un caracter especifico
-     * @param c Caracter a buscar
-     * @return Puntero al nodo que contiene el caracter, o nullptr si no existe
-     */
-    NodoRotor* buscarNodo(char c);
-    
-    /**
-     * @brief Calcula la distancia entre dos nodos en la lista circular
-     * @param desde Nodo de inicio
-     * @param hasta Nodo de destino
-     * @return Numero de pasos desde 'desde' hasta 'hasta'
-     */
-    int calcularDistancia(NodoRotor* desde, NodoRotor* hasta);
-    
+    const TablasRotor* tablas;  ///< Tablas compartidas del anillo
+    int cabeza;                 ///< Posicion "cero" actual del rotor (0..26)
+    int rotacionPendiente;      ///< Rotacion neta de los MAP aun sin traza (rotacion diferida)
+    int mapasPendientes;        ///< Tramas MAP aun sin traza
+
 public:
     /**
-     * @brief Constructor - Crea lista circular con A-Z y espacio
+     * @brief Constructor - Crea el anillo con A-Z y espacio, cabeza en 'A'
      */
     RotorDeMapeo();
-    
+
     /**
-     * @brief Destructor - Libera toda la memoria de la lista circular
+     * @brief Destructor
      */
     ~RotorDeMapeo();
-    
+
     /**
      * @brief Rota el rotor N posiciones
+     *
+     * Con trazas por trama imprime la nueva posicion, salvo con rotacion
+     * diferida (establecerRotacionDiferida()): entonces solo acumula la
+     * rotacion para emitirRotacionPendiente().
+     *
      * @param n Numero de posiciones (positivo = derecha, negativo = izquierda)
      */
     void rotar(int n);
-    
+
+    /**
+     * @brief Imprime una sola traza por la rotacion neta de los MAP acumulados
+     *
+     * La llama procesarTrama() antes de mapear una LOAD, y el bucle principal
+     * al recibir FIN o al terminar el flujo; no hace nada si no hubo MAP
+     * desde la ultima traza.
+     */
+    void emitirRotacionPendiente();
+
     /**
      * @brief Obtiene el caracter mapeado segun la rotacion actual
      * @param in Caracter a mapear
-     * @return Caracter mapeado
+     * @return Caracter mapeado (o el mismo si no pertenece al alfabeto)
      */
-    char getMapeo(char in);
-    
+    char getMapeo(char in) const;
+
+    /**
+     * @brief Decodifica un bloque de bytes con la rotacion actual
+     *
+     * Equivale a aplicar getMapeo() a cada byte, pero procesa 16/32 bytes por
+     * iteracion con SSE2/AVX2 cuando estan disponibles. Util para rachas de
+     * tramas LOAD entre dos MAP, donde el desplazamiento no cambia.
+     *
+     * @param entrada Bytes recibidos
+     * @param salida Destino de los bytes decodificados (puede ser == entrada)
+     * @param n Numero de bytes
+     */
+    void decodificarBloque(const char* entrada, char* salida, int n) const;
+
+    /**
+     * @brief Cifra un caracter: la inversa de getMapeo() con la rotacion actual
+     *
+     * getMapeo(getCifrado(c)) == c para todo c. Los caracteres fuera del
+     * alfabeto se devuelven sin cambios.
+     *
+     * @param in Caracter en claro
+     * @return Caracter que hay que enviar en una LOAD
+     */
+    char getCifrado(char in) const;
+
+    /**
+     * @brief Cifra un bloque de bytes con la rotacion actual
+     *
+     * Inversa de decodificarBloque(), con las mismas tablas y kernels SIMD.
+     *
+     * @param entrada Texto en claro
+     * @param salida Destino de los bytes cifrados (puede ser == entrada)
+     * @param n Numero de bytes
+     */
+    void codificarBloque(const char* entrada, char* salida, int n) const;
+
+    /**
+     * @brief Desplazamiento neto acumulado (posicion de la cabeza, 0..26)
+     */
+    int getDesplazamiento() const;
+
+    /**
+     * @brief Coloca la cabeza directamente, sin trazas
+     *
+     * Equivale a partir de un rotor nuevo y rotar d posiciones; lo usa la
+     * decodificacion paralela para arrancar cada trozo con su desplazamiento.
+     * Descarta la traza pendiente de la rotacion diferida.
+     *
+     * @param d Desplazamiento (se normaliza modulo 27)
+     */
+    void setDesplazamiento(int d);
+
     /**
      * @brief Imprime el estado actual del rotor (debug)
      */
-    void imprimirRotor();
+    void imprimirRotor() const;
 };
 
 #endif // ROTOR_DE_MAPEO_H
@@ -1,6 +1,6 @@
 /**
  * @file SerialPort.h
- * @brief Comunicacion serial con Arduino/ESP32 usando Win32 API
+ * @brief Comunicacion serial con Arduino/ESP32 (Win32 API o termios POSIX)
  * @author Elias de Jesus Zuniga de Leon
  * @date 2025-11-06
  */
@@ -8,55 +8,204 @@
 #ifndef SERIAL_PORT_H
 #define SERIAL_PORT_H
 
+#include "FuenteDeTramas.h"
+#include <chrono>
+
 #ifdef WINDOWS_BUILD
 #include <windows.h>
 #endif
 
 /**
  * @class SerialPort
- * @brief Maneja la lectura del puerto COM (115200 baudios)
+ * @brief Maneja la lectura del puerto serial (115200 baudios, 8N1)
+ *
+ * En Windows usa la API Win32 (COMx); en Linux/macOS usa termios sobre un
+ * dispositivo como /dev/ttyUSB0, /dev/ttyACM0 o el esclavo de una
+ * pseudo-terminal. En ambos casos lee en bloques grandes a un buffer
+ * circular interno y separa las lineas desde ahi, en lugar de hacer una
+ * llamada al sistema por byte.
+ *
+ * Tras solicitarModoBinario() y la confirmacion del ESP32, el anillo se
+ * interpreta como tramas binarias (ver ProtocoloBinario.h) y leerLinea()
+ * las entrega reescritas como lineas de texto, de modo que el resto del
+ * decodificador no cambia.
  */
-class SerialPort {
+class SerialPort : public FuenteDeTramas {
 private:
+    static const int TAMANIO_ANILLO = 8192;     ///< Capacidad del buffer circular (potencia de 2)
+    static const int INTENTOS_BINARIO = 10;     ///< Solicitudes de modo binario antes de rendirse
+    static const int PAUSA_SOLICITUD_MS = 1000; ///< Espera entre solicitudes sin confirmacion
+
 #ifdef WINDOWS_BUILD
     HANDLE hSerial;         ///< Handle del puerto serial
     DCB dcbSerialParams;    ///< Parametros de configuracion serial
     COMMTIMEOUTS timeouts;  ///< Configuracion de timeouts
+#else
+    int fd;                 ///< Descriptor del dispositivo serial
 #endif
-    
+
     bool conectado;         ///< Estado de la conexion
-    char* puerto;           ///< Nombre del puerto (ej: "COM9")
-    
+    char* puerto;           ///< Nombre del puerto (ej: "COM9" o "/dev/ttyUSB0")
+    int timeoutLecturaMs;   ///< Espera maxima de leerLinea() sin datos
+
+    char anillo[TAMANIO_ANILLO];    ///< Bytes recibidos aun no entregados como linea
+    unsigned int lectura;           ///< Contador de bytes consumidos del anillo
+    unsigned int escritura;         ///< Contador de bytes escritos en el anillo
+    unsigned int escaneado;         ///< Hasta donde ya se busco '\n' sin encontrarlo
+    unsigned long long bytesLeidos; ///< Bytes recibidos desde que se abrio el puerto
+
+    bool modoBinario;               ///< El ESP32 confirmo el modo binario
+    bool sincronizado;              ///< Se vio la marca de sincronia desde el ultimo error
+    int solicitudesRestantes;       ///< Reintentos de la solicitud de modo binario
+    std::chrono::steady_clock::time_point ultimaSolicitud;  ///< Momento de la ultima solicitud
+    unsigned long long bytesDescartados;    ///< Bytes binarios descartados al resincronizar
+
+    /**
+     * @brief Espera a que lleguen bytes y los lee al espacio libre contiguo del anillo
+     *
+     * Bloquea sin consumir CPU (poll() en POSIX, timeouts de ReadFile en
+     * Windows) hasta que hay datos o vence la espera.
+     *
+     * @param esperaMs Espera maxima en milisegundos
+     * @return Bytes leidos (0 si vencio la espera, -1 si hubo error)
+     */
+    int llenarAnillo(int esperaMs);
+
+    /**
+     * @brief Entrega como linea los primeros n bytes del anillo y descarta el separador
+     * @param buffer Destino de la linea (sin '\r' ni '\n')
+     * @param bufferSize Tamanio del buffer
+     * @param n Bytes de la linea dentro del anillo
+     * @param separador Bytes extra a descartar despues de la linea ('\n')
+     * @return Caracteres copiados al buffer
+     */
+    int extraerLinea(char* buffer, int bufferSize, unsigned int n, unsigned int separador);
+
+    /**
+     * @brief Escribe bytes en el puerto
+     * @return true si se escribieron todos
+     */
+    bool escribir(const char* datos, int n);
+
+    /**
+     * @brief Reenvia la solicitud de modo binario si ya paso la pausa sin confirmacion
+     */
+    void reintentarSolicitud();
+
+    /**
+     * @brief Version binaria de leerLinea(): una trama del anillo como linea de texto
+     *
+     * Descarta bytes hasta la marca de sincronia tras una etiqueta
+     * desconocida.
+     *
+     * @param buffer Destino de la linea
+     * @param bufferSize Tamanio del buffer
+     * @param esperaMs Espera maxima si la trama esta incompleta
+     * @return Caracteres escritos (0 si no hay trama completa)
+     */
+    int leerTramaBinaria(char* buffer, int bufferSize, int esperaMs);
+
 public:
     /**
      * @brief Constructor
-     * @param portName Nombre del puerto COM (ej: "COM9")
+     * @param portName Nombre del puerto (ej: "COM9", "/dev/ttyUSB0" o "ttyACM0")
      */
     SerialPort(const char* portName);
-    
+
     /**
      * @brief Destructor - Cierra el puerto automaticamente
      */
     ~SerialPort();
-    
+
     /**
      * @brief Verifica si el puerto esta conectado
      * @return true si esta conectado, false si no
      */
-    bool estaConectado() const;
-    
+    bool estaConectado() const override;
+
     /**
      * @brief Lee una linea del puerto serial
+     *
+     * Devuelve solo lineas completas (terminadas en '\n', sin '\r'). Si no hay
+     * una linea completa, bloquea hasta que llegue o hasta que pase el
+     * timeout de lectura (ver setTimeoutLectura); en ese caso los bytes de la
+     * linea incompleta se conservan en el anillo y se devuelve 0. Una linea
+     * mas larga que el buffer se entrega en trozos de bufferSize - 1.
+     *
      * @param buffer Buffer para almacenar la linea
      * @param bufferSize Tamanio del buffer
-     * @return Numero de caracteres leidos
+     * @return Numero de caracteres leidos (0 si no hay linea completa)
+     */
+    int leerLinea(char* buffer, int bufferSize) override;
+
+    /**
+     * @brief Bytes recibidos por el puerto
+     */
+    unsigned long long getBytesLeidos() const override;
+
+    /**
+     * @brief Envia al ESP32 la solicitud de modo binario
+     *
+     * No espera la respuesta: las lineas de texto siguen llegando por
+     * leerLinea(), que reenvia la solicitud cada PAUSA_SOLICITUD_MS (hasta
+     * INTENTOS_BINARIO veces) y cambia a binario al recibir la linea
+     * CONFIRMACION_BINARIO. Un firmware sin modo binario la ignora.
+     *
+     * @return true si se pudo enviar la solicitud
+     */
+    bool solicitarModoBinario() override;
+
+    /**
+     * @brief Envia al ESP32 la solicitud de marcas de tiempo (SOLICITUD_MARCAS)
+     *
+     * No hace falta esperar la respuesta: el parser acepta las tramas con y
+     * sin marca, y la confirmacion se ignora como texto de banner.
+     *
+     * @return true si se pudo enviar la solicitud
      */
-    int leerLinea(char* buffer, int bufferSize);
-    
+    bool solicitarMarcasDeTiempo() override;
+
+    /**
+     * @brief Indica si el puerto ya recibe tramas binarias
+     */
+    bool esModoBinario() const;
+
+    /**
+     * @brief Bytes descartados por etiquetas binarias desconocidas
+     */
+    unsigned long long getBytesDescartados() const;
+
+    /**
+     * @brief Indica si el anillo ya contiene una linea completa sin entregar
+     *
+     * Permite distinguir una linea vacia (leerLinea() devuelve 0) de la
+     * falta de datos cuando se lee sin espera. En modo binario indica si hay
+     * una trama completa.
+     */
+    bool hayLineaCompleta();
+
+#ifndef WINDOWS_BUILD
+    /**
+     * @brief Descriptor del dispositivo, para esperar varios puertos con poll()
+     * @return Descriptor, o -1 si el puerto esta cerrado
+     */
+    int getDescriptor() const;
+#endif
+
+    /**
+     * @brief Cambia la espera maxima de leerLinea() cuando no llegan datos
+     * @param ms Milisegundos (0 = no esperar)
+     */
+    void setTimeoutLectura(int ms);
+
     /**
      * @brief Cierra el puerto serial
      */
-    void cerrar();
+    void cerrar() override;
+
+private:
+    SerialPort(const SerialPort&);
+    SerialPort& operator=(const SerialPort&);
 };
 
 #endif // SERIAL_PORT_H
@@ -0,0 +1,165 @@
+/**
+ * @file TablaDeSesiones.h
+ * @brief Tabla hash de sesiones para tramas multiplexadas ("#id,L,X")
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef TABLA_DE_SESIONES_H
+#define TABLA_DE_SESIONES_H
+
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+struct Trama;
+
+/**
+ * @struct Sesion
+ * @brief Mensaje independiente dentro de un enlace multiplexado
+ */
+struct Sesion {
+    static const int TAMANIO_PENDIENTE = 32;    ///< Caracteres que se juntan antes de ir a la lista
+
+    unsigned int id;                ///< Id del prefijo "#id,"
+    RotorDeMapeo rotor;             ///< Rotor propio de la sesion
+    ListaDeCarga carga;             ///< Mensaje propio de la sesion (sin lo pendiente)
+    unsigned long long tramas;      ///< Tramas LOAD y MAP recibidas
+    int numPendiente;               ///< Caracteres en pendiente[]
+    char pendiente[TAMANIO_PENDIENTE];  ///< Caracteres ya decodificados aun no agregados a carga
+    Sesion* anterior;               ///< Sesion abierta anterior (orden de llegada)
+    Sesion* siguiente;              ///< Sesion abierta siguiente (o siguiente libre)
+};
+
+/**
+ * @class TablaDeSesiones
+ * @brief Sesiones abiertas indexadas por id
+ *
+ * Direccionamiento abierto con sondeo lineal sobre un arreglo de punteros
+ * de tamanio potencia de 2 (hash multiplicativo de Fibonacci); se duplica
+ * al pasar del 50% de ocupacion. Al borrar se recorren hacia atras las
+ * entradas siguientes del grupo, asi que no hay lapidas. Ademas se
+ * recuerda la ultima sesion usada, porque las tramas de una sesion suelen
+ * llegar seguidas.
+ *
+ * Con miles de sesiones intercaladas cada trama cae en el bloque de una
+ * lista distinta; para no tocar un bloque de 4 KB por caracter, cada
+ * sesion junta sus caracteres decodificados en un arreglo pequenio dentro
+ * de su nodo y los pasa a su ListaDeCarga de TAMANIO_PENDIENTE en
+ * TAMANIO_PENDIENTE (o antes de imprimir). Con trazas por trama se aplica
+ * procesarTrama() directamente para conservar el eco.
+ *
+ * Las sesiones abiertas forman una lista doble en orden de llegada. Al
+ * cerrar una sesion su nodo (con el rotor y los bloques de su ListaDeCarga)
+ * se guarda en una lista libre y se reutiliza para la siguiente sesion
+ * nueva: con miles de sesiones de vida corta casi no se pide memoria.
+ */
+class TablaDeSesiones {
+private:
+    static const int BITS_INICIALES = 6;    ///< 64 ranuras al inicio
+
+    Sesion** ranuras;           ///< Arreglo de la tabla (nullptr = vacia)
+    int bits;                   ///< log2 del numero de ranuras
+    int activas;                ///< Sesiones abiertas
+    int maximoActivas;          ///< Mayor numero de sesiones abiertas a la vez
+    unsigned long long creadas;     ///< Sesiones abiertas desde el inicio
+    unsigned long long cerradas;    ///< Sesiones cerradas con cerrar()
+    Sesion* primera;            ///< Sesion abierta mas antigua
+    Sesion* ultima;             ///< Sesion abierta mas reciente
+    Sesion* libres;             ///< Nodos listos para reutilizarse
+    Sesion* ultimaUsada;        ///< Cache de la ultima busqueda
+
+    /**
+     * @brief Ranura inicial de un id
+     */
+    unsigned int ranuraDe(unsigned int id) const;
+
+    /**
+     * @brief Duplica el numero de ranuras y reubica las sesiones
+     */
+    void crecer();
+
+public:
+    /**
+     * @brief Constructor - Tabla vacia
+     */
+    TablaDeSesiones();
+
+    /**
+     * @brief Destructor - Libera todas las sesiones
+     */
+    ~TablaDeSesiones();
+
+    /**
+     * @brief Busca una sesion abierta
+     * @param id Id de la sesion
+     * @return Sesion, o nullptr si no esta abierta
+     */
+    Sesion* buscar(unsigned int id);
+
+    /**
+     * @brief Busca una sesion y la abre si no existe
+     * @param id Id de la sesion
+     * @return Sesion (rotor en 'A' y mensaje vacio si es nueva)
+     */
+    Sesion* obtener(unsigned int id);
+
+    /**
+     * @brief Quita una sesion de la tabla y recicla su nodo
+     *
+     * El puntero deja de ser valido; el id puede volver a abrirse.
+     *
+     * @param sesion Sesion abierta
+     */
+    void cerrar(Sesion* sesion);
+
+    /**
+     * @brief Sesion abierta mas antigua (para recorrer con Sesion::siguiente)
+     */
+    Sesion* getPrimera() const;
+
+    /**
+     * @brief Sesiones abiertas
+     */
+    int getActivas() const;
+
+    /**
+     * @brief Mayor numero de sesiones abiertas a la vez
+     */
+    int getMaximoActivas() const;
+
+    /**
+     * @brief Sesiones abiertas desde el inicio
+     */
+    unsigned long long getCreadas() const;
+
+    /**
+     * @brief Sesiones cerradas
+     */
+    unsigned long long getCerradas() const;
+
+    /**
+     * @brief Aplica una trama LOAD o MAP al rotor y al mensaje de la sesion
+     * @param sesion Sesion de la trama
+     * @param trama Trama LOAD o MAP
+     */
+    static void aplicar(Sesion* sesion, const Trama& trama);
+
+    /**
+     * @brief Pasa a la ListaDeCarga los caracteres pendientes de la sesion
+     * @param sesion Sesion abierta
+     */
+    static void completar(Sesion* sesion);
+
+    /**
+     * @brief Imprime el mensaje de una sesion, etiquetado con su id
+     * @param sesion Sesion a imprimir
+     * @param completa true si termino con su FIN
+     */
+    static void imprimirSesion(Sesion* sesion, bool completa);
+
+private:
+    TablaDeSesiones(const TablaDeSesiones&);
+    TablaDeSesiones& operator=(const TablaDeSesiones&);
+};
+
+#endif // TABLA_DE_SESIONES_H
@@ -0,0 +1,160 @@
+/**
+ * @file Trama.h
+ * @brief Representacion por valor de las tramas PRT-7 y su parser
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * El bucle principal parsea cada linea en una Trama (struct con etiqueta)
+ * reutilizable y la despacha con un switch: sin new/delete ni llamadas
+ * virtuales por trama. La jerarquia TramaBase sigue disponible mediante
+ * crearTramaPolimorfica() y la version de parsearTrama() que devuelve
+ * TramaBase*.
+ */
+
+#ifndef TRAMA_H
+#define TRAMA_H
+
+// Forward declarations
+class ListaDeCarga;
+class RotorDeMapeo;
+class TramaBase;
+
+/**
+ * @enum TipoTrama
+ * @brief Etiqueta que indica que campo de Trama es valido
+ */
+enum TipoTrama {
+    TRAMA_NINGUNA,  ///< Linea vacia, invalida o ignorada
+    TRAMA_LOAD,     ///< L,<caracter> o L,<caracteres>
+    TRAMA_MAP,      ///< M,<numero>
+    TRAMA_FIN       ///< FIN (fin del flujo)
+};
+
+/**
+ * @struct Trama
+ * @brief Trama ya parseada (tipo + dato), sin memoria dinamica
+ */
+struct Trama {
+    TipoTrama tipo;     ///< Tipo de trama
+    char caracter;      ///< Primer caracter recibido (solo TRAMA_LOAD)
+    const char* texto;  ///< Caracteres recibidos, dentro de la linea (solo TRAMA_LOAD con longitud > 1)
+    int longitud;       ///< Caracteres de la LOAD (1 en "L,H", 10 en "L,HOLA MUNDO")
+    int rotacion;       ///< Posiciones a rotar (solo TRAMA_MAP)
+    unsigned int sesion;    ///< Sesion del prefijo "#id," (0 si la linea no lo trae)
+    bool conMarca;          ///< La linea trae el prefijo "@us," del emisor
+    unsigned int marca;     ///< micros() del ESP32 al enviar (solo con conMarca; da la vuelta cada ~71 min)
+};
+
+/**
+ * @enum ResultadoLinea
+ * @brief Clasificacion de una linea hecha por interpretarTrama()
+ */
+enum ResultadoLinea {
+    LINEA_VALIDA,       ///< LOAD, MAP o FIN
+    LINEA_VACIA,        ///< Linea vacia
+    LINEA_CORTA,        ///< Menos de 3 caracteres ("Trama invalida")
+    LINEA_IGNORADA,     ///< Sin coma en la segunda posicion (banner del ESP32)
+    LINEA_DESCONOCIDA   ///< Tipo distinto de L y M
+};
+
+/**
+ * @brief Clasifica y parsea una linea sin escribir nada en consola
+ *
+ * Es el nucleo de parsearTrama(); la decodificacion paralela la usa desde
+ * varios hilos y reporta los errores al final.
+ *
+ * Una trama puede llevar el prefijo opcional "#<id>," (ej: "#17,L,H",
+ * "#17,FIN") para multiplexar varios mensajes en un enlace; el id queda en
+ * Trama::sesion. Un prefijo sin digitos o sin coma es LINEA_DESCONOCIDA.
+ * El prefijo solo se reconoce con establecerSesionesMultiplexadas(true);
+ * si no, la linea sigue siendo LINEA_IGNORADA como cualquier banner.
+ *
+ * Antes de todo puede ir la marca de tiempo del emisor "@<us>," (ej:
+ * "@81234567,L,H", "@81234567,#17,M,3"), que el firmware agrega en modo
+ * con marcas (ver LatenciaEnlace); queda en Trama::marca. escribirTrama()
+ * no la reproduce. La marca solo se reconoce con
+ * establecerMarcasDeTiempo(true), y una mal formada es LINEA_IGNORADA: en
+ * ambos casos la linea se trata como banner.
+ *
+ * Con LINEA_DESCONOCIDA, Trama::caracter es el tipo leido despues de los
+ * prefijos (o '#' si el prefijo de sesion esta mal formado).
+ *
+ * Una LOAD puede traer una rafaga de caracteres ("L,HOLA MUNDO"): todo lo
+ * que sigue a la coma. Trama::texto apunta dentro de la linea, asi que solo
+ * es valido mientras la linea no se sobrescriba.
+ *
+ * @param linea Linea del puerto (ej: "L,H" o "M,2")
+ * @param trama Destino de la trama parseada
+ * @return LINEA_VALIDA si la linea es LOAD, MAP o FIN
+ */
+ResultadoLinea interpretarTrama(const char* linea, Trama* trama);
+
+/**
+ * @brief Parsea una linea en una Trama por valor
+ *
+ * Acepta "L,<c>", "L,<caracteres>", "M,<n>" y "FIN", con o sin marca de
+ * tiempo "@<us>," y prefijo de sesion "#<id>,".
+ * Las lineas sin coma en la segunda posicion (banner del ESP32) se ignoran
+ * en silencio.
+ *
+ * @param linea Linea del puerto (ej: "L,H" o "M,2")
+ * @param trama Destino de la trama parseada
+ * @return true si la linea es LOAD, MAP o FIN
+ */
+bool parsearTrama(const char* linea, Trama* trama);
+
+/**
+ * @brief Escribe una trama como linea de texto (inversa de interpretarTrama)
+ *
+ * Produce "L,<caracteres>", "M,<n>" o "FIN", con el prefijo "#<id>," si
+ * la trama tiene sesion. La linea se trunca si no cabe en el buffer.
+ *
+ * @param trama Trama LOAD, MAP o FIN
+ * @param destino Buffer para la linea (terminada en '\0')
+ * @param capacidad Tamanio del buffer
+ * @return Caracteres escritos (0 si la trama es TRAMA_NINGUNA)
+ */
+int escribirTrama(const Trama& trama, char* destino, int capacidad);
+
+/**
+ * @brief Parsea una linea y crea el objeto trama correspondiente (adaptador)
+ * @param linea Linea del puerto (ej: "L,H" o "M,2")
+ * @return Puntero a TramaBase (TramaLoad o TramaMap) o nullptr; el llamador hace delete
+ */
+TramaBase* parsearTrama(char* linea);
+
+/**
+ * @brief Aplica una trama LOAD o MAP al decodificador
+ *
+ * Una LOAD con varios caracteres se decodifica de una vez con
+ * RotorDeMapeo::decodificarBloque() y se agrega con
+ * ListaDeCarga::insertarBloque().
+ *
+ * @param trama Trama parseada
+ * @param carga Lista donde se almacena el mensaje
+ * @param rotor Rotor de mapeo
+ */
+void procesarTrama(const Trama& trama, ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+/**
+ * @brief Decodifica una rafaga de caracteres LOAD y la agrega como bloque
+ *
+ * Una pasada de RotorDeMapeo::decodificarBloque() por tramos de 256
+ * caracteres y un ListaDeCarga::insertarBloque() por tramo, en lugar de
+ * getMapeo() + insertarAlFinal() por caracter.
+ *
+ * @param texto Caracteres recibidos
+ * @param longitud Numero de caracteres
+ * @param carga Lista donde se almacena el mensaje
+ * @param rotor Rotor de mapeo
+ */
+void cargarRafaga(const char* texto, int longitud, ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+/**
+ * @brief Crea el objeto polimorfico equivalente a una trama por valor
+ * @param trama Trama LOAD (de uno o varios caracteres) o MAP
+ * @return Nuevo TramaLoad/TramaMap (el llamador hace delete), o nullptr
+ */
+TramaBase* crearTramaPolimorfica(const Trama& trama);
+
+#endif // TRAMA_H
@@ -12,11 +12,13 @@
 
 /**
  * @class TramaLoad
- * @brief Trama de carga - decodifica y almacena un caracter
+ * @brief Trama de carga - decodifica y almacena un caracter o una rafaga
  */
 class TramaLoad : public TramaBase {
 private:
-    char dato;  ///< Caracter a decodificar
+    char dato;      ///< Caracter a decodificar
+    char* rafaga;   ///< Copia de los caracteres de "L,<caracteres>" (nullptr si es uno solo)
+    int longitud;   ///< Caracteres en rafaga
     
 public:
     /**
@@ -24,6 +26,13 @@ public:
      * @param c Caracter recibido en la trama
      */
     TramaLoad(char c);
+
+    /**
+     * @brief Constructor para una rafaga de caracteres
+     * @param texto Caracteres recibidos en la trama (se copian)
+     * @param n Numero de caracteres
+     */
+    TramaLoad(const char* texto, int n);
     
     /**
      * @brief Destructor
@@ -36,6 +45,10 @@ public:
      * @param rotor Rotor para decodificar
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+
+private:
+    TramaLoad(const TramaLoad&);
+    TramaLoad& operator=(const TramaLoad&);
 };
 
 #endif // TRAMA_LOAD_H
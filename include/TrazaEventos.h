@@ -0,0 +1,87 @@
+/**
+ * @file TrazaEventos.h
+ * @brief Linea de tiempo por trama en formato trace-event de Chrome/Perfetto
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ *
+ * Con --traza=RUTA cada trama deja tramos (eventos "X") con su hilo y sus
+ * tiempos en microsegundos:
+ *
+ * - lectura: FuenteDeTramas::leerLinea() (incluye la espera en el puerto)
+ * - parseo: parsearTrama()
+ * - rotor: RotorDeMapeo::rotar() de una trama MAP
+ * - insercion: decodificacion e insercion de una trama LOAD
+ *
+ * Cada hilo guarda sus eventos en un buffer propio preasignado (sin
+ * bloqueos ni E/S mientras se decodifica) y el JSON se escribe al terminar;
+ * se abre en chrome://tracing o ui.perfetto.dev. Sin trazar, cada marca
+ * cuesta una comparacion; compilando sin PRT7_TRAZA_EVENTOS (opcion de
+ * CMake) las macros TRAZA_* desaparecen por completo.
+ */
+
+#ifndef TRAZA_EVENTOS_H
+#define TRAZA_EVENTOS_H
+
+#include <chrono>
+
+/// Se estan registrando eventos. Solo lo escribe habilitarTrazaEventos()
+extern bool trazandoEventos;
+
+/// Eventos por hilo; los que no caben se cuentan como perdidos
+const int CAPACIDAD_TRAZA_POR_HILO = 1 << 20;
+
+/**
+ * @brief Empieza a registrar (el origen de tiempos es este instante)
+ * @param capacidadPorHilo Eventos que caben en el buffer de cada hilo
+ */
+void habilitarTrazaEventos(int capacidadPorHilo = CAPACIDAD_TRAZA_POR_HILO);
+
+/**
+ * @brief Nombra el hilo llamador en la traza y le asigna su buffer
+ *
+ * Conviene llamarla al arrancar el hilo: asi el buffer se reserva (y se
+ * tocan sus paginas) antes de medir. Sin trazar no hace nada.
+ */
+void nombrarHiloTraza(const char* nombre);
+
+/**
+ * @brief Registra un tramo del hilo llamador
+ * @param nombre Nombre del tramo (cadena estatica, sin comillas)
+ * @param desde Marca al entrar
+ * @param hasta Marca al salir
+ */
+void registrarTramo(const char* nombre, unsigned long long desde, unsigned long long hasta);
+
+/**
+ * @brief Escribe todos los eventos en RUTA como JSON trace-event
+ * @return false si no se pudo escribir el archivo
+ *
+ * Se llama con los hilos que trazan ya detenidos.
+ */
+bool escribirTrazaEventos(const char* ruta);
+
+/**
+ * @brief Eventos que no cupieron en el buffer de su hilo
+ */
+unsigned long long getEventosTrazaPerdidos();
+
+/**
+ * @brief Marca de tiempo en nanosegundos (steady_clock)
+ */
+inline unsigned long long marcaTraza() {
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#ifdef PRT7_TRAZA_EVENTOS
+/// Toma una marca de tiempo solo si se esta trazando
+#define TRAZA_MARCA(marca) unsigned long long marca = trazandoEventos ? marcaTraza() : 0
+/// Registra el tramo [desde, hasta] del hilo llamador
+#define TRAZA_TRAMO(nombre, desde, hasta) \
+    do { if (trazandoEventos) registrarTramo((nombre), (desde), (hasta)); } while (0)
+#else
+#define TRAZA_MARCA(marca)
+#define TRAZA_TRAMO(nombre, desde, hasta) do { } while (0)
+#endif
+
+#endif // TRAZA_EVENTOS_H
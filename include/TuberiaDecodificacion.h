@@ -0,0 +1,170 @@
+/**
+ * @file TuberiaDecodificacion.h
+ * @brief Decodificacion en dos etapas: hilo de lectura + hilo decodificador
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#ifndef TUBERIA_DECODIFICACION_H
+#define TUBERIA_DECODIFICACION_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "ColaSPSC.h"
+
+class FuenteDeTramas;
+class ListaDeCarga;
+class RotorDeMapeo;
+
+/**
+ * @struct LineaRecibida
+ * @brief Ranura de la cola: una linea tal como la entrego FuenteDeTramas::leerLinea
+ */
+struct LineaRecibida {
+    static const int TAMANIO = 256;     ///< Tamanio maximo de linea (incluye '\0')
+
+    int longitud;                       ///< Caracteres en texto (sin '\0')
+    char texto[TAMANIO];                ///< Linea sin '\r' ni '\n'
+};
+
+/**
+ * @enum PoliticaColaLlena
+ * @brief Que hace el hilo de E/S cuando la cola esta llena
+ */
+enum PoliticaColaLlena {
+    COLA_ESPERAR,       ///< Esperar a que el decodificador libere una ranura (el driver retiene los bytes)
+    COLA_DESCARTAR      ///< Descartar la linea y seguir leyendo (FIN nunca se descarta)
+};
+
+/**
+ * @class TuberiaDecodificacion
+ * @brief Separa la lectura de la fuente de la decodificacion y la consola
+ *
+ * Un hilo de E/S llena lineas directamente en las ranuras de una ColaSPSC;
+ * el hilo que llama a ejecutar() las parsea y aplica al rotor y a la
+ * ListaDeCarga. Asi una escritura lenta en consola no detiene la lectura
+ * del UART. Cuando la cola se llena se aplica la PoliticaColaLlena y se
+ * cuenta, para poder observar la contrapresion en rafagas.
+ */
+class TuberiaDecodificacion {
+public:
+    static const unsigned int CAPACIDAD_COLA = 1024;  ///< Lineas en vuelo como maximo
+
+private:
+    FuenteDeTramas* fuente;     ///< Fuente de la que lee el hilo de E/S
+    ListaDeCarga* carga;        ///< Destino del mensaje
+    RotorDeMapeo* rotor;        ///< Rotor de mapeo
+    PoliticaColaLlena politica; ///< Comportamiento con la cola llena
+    unsigned long long tramasProcesadas;    ///< Tramas validas aplicadas (solo el decodificador)
+
+    ColaSPSC<LineaRecibida, CAPACIDAD_COLA> cola;   ///< Lineas leidas pendientes de decodificar
+    char descarte[LineaRecibida::TAMANIO];          ///< Destino de lectura cuando la cola esta llena
+
+    std::thread hiloLectura;                ///< Etapa de E/S
+    std::atomic<bool> detener;              ///< El decodificador pide terminar (FIN)
+    std::atomic<bool> lecturaTerminada;     ///< El hilo de E/S ya no producira mas lineas
+    std::atomic<bool> consumidorDormido;    ///< El decodificador espera en 'avisoLineas'
+    std::atomic<bool> productorDormido;     ///< El hilo de E/S espera en 'avisoEspacio'
+    std::atomic<unsigned long long> lineasLeidas;   ///< Lineas completas leidas de la fuente
+    std::atomic<unsigned long long> colaLlena;      ///< Veces que la cola estaba llena al llegar una linea
+    std::mutex mutexAviso;                  ///< Protege las esperas de ambos hilos
+    std::condition_variable avisoLineas;    ///< Despierta al decodificador cuando hay lineas
+    std::condition_variable avisoEspacio;   ///< Despierta al hilo de E/S cuando hay ranuras libres
+
+    /**
+     * @brief Cuerpo del hilo de E/S
+     */
+    void leerFuente();
+
+    /**
+     * @brief (E/S) Consigue una ranura para una linea que llego con la cola llena
+     * @param obligatoria true si la linea no puede descartarse (FIN)
+     * @return Ranura, o nullptr si la linea se descarta
+     */
+    LineaRecibida* ranuraConColaLlena(bool obligatoria);
+
+    /**
+     * @brief (Decodificador) Duerme hasta que haya lineas o termine la lectura
+     */
+    void esperarLineas();
+
+    /**
+     * @brief (E/S) Duerme hasta que el decodificador libere una ranura
+     */
+    void esperarEspacio();
+
+    /**
+     * @brief (E/S) Despierta al decodificador si esta dormido
+     */
+    void despertarDecodificador();
+
+    /**
+     * @brief (Decodificador) Despierta al hilo de E/S si espera espacio
+     */
+    void despertarLector();
+
+public:
+    /**
+     * @brief Constructor
+     * @param fuente Fuente ya abierta (puerto, stdin o captura)
+     * @param carga Lista donde se arma el mensaje
+     * @param rotor Rotor de mapeo
+     * @param politica Comportamiento cuando la cola esta llena
+     */
+    TuberiaDecodificacion(FuenteDeTramas* fuente, ListaDeCarga* carga, RotorDeMapeo* rotor,
+                          PoliticaColaLlena politica = COLA_ESPERAR);
+
+    /**
+     * @brief Destructor - Detiene el hilo de E/S si sigue activo
+     */
+    ~TuberiaDecodificacion();
+
+    /**
+     * @brief Ejecuta la tuberia hasta recibir FIN o agotar la fuente
+     * @return true si se recibio FIN
+     */
+    bool ejecutar();
+
+    /**
+     * @brief Lineas completas leidas de la fuente (incluye las descartadas)
+     */
+    unsigned long long getLineasLeidas() const;
+
+    /**
+     * @brief Tramas validas decodificadas (incluye FIN)
+     */
+    unsigned long long getTramasProcesadas() const;
+
+    /**
+     * @brief Lineas perdidas porque la cola estaba llena
+     */
+    unsigned long long getLineasDescartadas() const;
+
+    /**
+     * @brief Veces que llego una linea con la cola llena (esperas + descartes)
+     */
+    unsigned long long getVecesColaLlena() const;
+
+    /**
+     * @brief Lineas esperando en la cola en este momento
+     */
+    unsigned int getProfundidadCola() const;
+
+    /**
+     * @brief Mayor numero de lineas que llego a haber en la cola
+     */
+    unsigned int getProfundidadMaxima() const;
+
+    /**
+     * @brief Imprime los contadores de la tuberia
+     */
+    void imprimirEstadisticas() const;
+
+private:
+    TuberiaDecodificacion(const TuberiaDecodificacion&);
+    TuberiaDecodificacion& operator=(const TuberiaDecodificacion&);
+};
+
+#endif // TUBERIA_DECODIFICACION_H
@@ -9,7 +9,7 @@
  * 
  * @section features Caracteristicas Principales
  * 
- * - Comunicacion serial via puerto COM con ESP32
+ * - Comunicacion serial con ESP32 (COM en Windows, termios en Linux)
  * - POO con herencia, polimorfismo y clases abstractas
  * - Lista doblemente enlazada para almacenar el mensaje
  * - Lista circular para el rotor de mapeo (cifrado)
@@ -26,17 +26,119 @@
  * 
  * El protocolo usa dos tipos de tramas:
  * 
- * - **LOAD (L,X):** Carga un caracter a decodificar
+ * - **LOAD (L,X):** Carga un caracter a decodificar; "L,HOLA MUNDO" carga una
+ *   rafaga que se decodifica de una vez y se agrega como bloque
  * - **MAP (M,N):** Rota el rotor N posiciones
+ *
+ * Cualquier trama puede llevar el prefijo de sesion "#id," (ej: "#17,L,H",
+ * "#17,FIN") para enviar varios mensajes intercalados por el mismo enlace.
+ *
+ * Con --binario el host pide al ESP32 el modo binario compacto (ver
+ * ProtocoloBinario.h): una etiqueta de un byte por trama, la rotacion como
+ * varint y una marca de sincronia periodica. Una LOAD pasa de 5 bytes a 1 y
+ * un MAP de 6 a 2, unas 4 veces mas tramas por segundo a 115200 baudios.
  * 
+ * @section uso Uso
+ *
+ * @code
+ * DecodificadorPRT7 [--fuente=FUENTE] [--puerto=NOMBRE] [--tuberia[=descartar]] [--paralelo[=N]]
+ *                   [--puertos=A,B,...] [--sesiones] [--rotacion-diferida] [--binario] [--rendimiento]
+ *                   [--latencias[=N]] [--metricas=RUTA|unix:RUTA] [--metricas-intervalo=MS]
+ *                   [--registro=esperar|descartar] [--traza=RUTA] [--latencia-enlace]
+ *                   [--grabar=RUTA] [--velocidad=N|max] [--diario=RUTA] [--diario-intervalo=MS]
+ *                   [--detalle=silencioso|resumen|trama|demo]
+ * @endcode
+ *
+ * - **--fuente:** serial (por defecto), stdin, archivo:RUTA, mmap:RUTA o captura:RUTA;
+ *   las capturas de texto se decodifican sin el limite de 115200 baudios y
+ *   captura:RUTA repite una grabacion de --grabar con sus tiempos
+ * - **--puerto:** COM9 (Windows), /dev/ttyUSB0, ttyACM0, /dev/pts/N (Linux)
+ * - **--tuberia:** lee el puerto en un hilo aparte (TuberiaDecodificacion); con
+ *   =descartar pierde lineas en vez de frenar la lectura si la cola se llena
+ * - **--paralelo:** decodifica una captura mmap:RUTA repartida en N hilos
+ *   (DecodificadorParalelo); mismo mensaje que la lectura secuencial
+ * - **--puertos:** atiende varios ESP32 a la vez, cada puerto con su rotor y su
+ *   mensaje, en un grupo de hilos del tamanio del numero de nucleos
+ *   (DecodificadorMultipuerto); los mensajes se etiquetan con el puerto
+ * - **--sesiones:** separa las tramas con prefijo "#id," en un mensaje por
+ *   sesion (TablaDeSesiones); cada sesion termina con su "#id,FIN" y un FIN
+ *   sin prefijo termina el enlace. Sin esta opcion el prefijo se ignora
+ * - **--rotacion-diferida:** con trazas por trama, una rafaga de MAP seguidos
+ *   deja una sola linea con la rotacion neta cuando la usa la siguiente LOAD
+ * - **--binario:** negocia el modo binario con el ESP32; si el firmware no
+ *   contesta, la lectura sigue en modo texto
+ * - **--rendimiento:** al terminar reporta tramas/s y MB/s en stderr
+ * - **--latencias:** mide una trama de cada N (64 por defecto) y reporta en
+ *   stderr p50/p99/p999/max de lectura, parseo, decodificacion e insercion
+ *   al terminar, con SIGUSR1 (sin parar) y con SIGINT/SIGTERM (terminando
+ *   con el mensaje parcial). Compilando con -DPRT7_LATENCIAS=OFF la
+ *   instrumentacion desaparece del bucle
+ * - **--metricas:** publica contadores atomicos (tramas por tipo, lineas
+ *   rechazadas, bytes, timeouts de lectura, largo del mensaje, cabeza del
+ *   rotor) en formato de texto Prometheus: RUTA se reescribe cada
+ *   --metricas-intervalo ms (1000 por defecto) y unix:RUTA entrega una
+ *   instantanea a cada conexion
+ * - **--registro:** las trazas por trama y los avisos del parser se copian a
+ *   un anillo preasignado y un hilo los escribe en lotes (RegistroAsincrono),
+ *   con todo vaciado al recibir FIN o al terminar. Si la salida no da abasto,
+ *   =esperar (por defecto) frena la decodificacion y =descartar pierde trazas
+ *   (nunca avisos ni el mensaje) dejando una marca con cuantas se perdieron
+ * - **--traza:** guarda en memoria, por hilo, un tramo por etapa de cada
+ *   trama (lectura, parseo, rotor, insercion) y al terminar escribe RUTA en
+ *   formato trace-event para chrome://tracing o ui.perfetto.dev
+ *   (TrazaEventos); con --tuberia se ven el lector y el decodificador por
+ *   separado. Compilando con -DPRT7_TRAZA_EVENTOS=OFF las marcas desaparecen
+ * - **--latencia-enlace:** pide al ESP32 que anteponga su micros() a cada
+ *   trama ("@81234567,L,H") y al terminar reporta p50/p99/p999/max de la
+ *   latencia desde su println hasta la recepcion y hasta ListaDeCarga, y la
+ *   fluctuacion, con el desfase y la deriva de los relojes estimados de las
+ *   tramas mas rapidas (LatenciaEnlace). bench/EmuladorESP32.cpp con
+ *   --marcas --baudios=115200 reemplaza a la placa
+ * - **--grabar:** agrega cada linea recibida a RUTA con su instante en un
+ *   formato binario compacto (GrabadorDeCaptura), en lotes de un write()
+ *   por 64 KB o por segundo; grabar otra vez en la misma ruta agrega un
+ *   segmento. Sirve para reproducir un fallo visto en campo
+ * - **--velocidad:** con --fuente=captura:RUTA entrega las lineas al ritmo
+ *   grabado (1, por defecto), N veces mas rapido o sin esperas (max), para
+ *   pruebas de regresion y de carga; con --rendimiento reporta el mayor
+ *   retraso respecto al ritmo pedido
+ * - **--diario:** cada --diario-intervalo ms (100 por defecto) agrega a RUTA
+ *   los caracteres nuevos del mensaje y un punto de control (largo, rotor,
+ *   tramas) con un solo write() y un fdatasync() (DiarioDeDecodificacion).
+ *   Si el proceso muere, la siguiente ejecucion con la misma RUTA restaura
+ *   mensaje y rotor del ultimo punto en milisegundos y sigue decodificando;
+ *   un diario que ya llego a FIN se reinicia con el mensaje siguiente
+ * - **silencioso:** solo el mensaje final
+ * - **resumen:** banners y mensaje final, sin trazas por trama
+ * - **trama (por defecto):** una linea por trama con el fragmento nuevo y la longitud
+ * - **demo:** una linea por trama con el mensaje completo (costo O(n^2))
+ *
  * @section classes Clases Principales
  * 
- * - TramaBase: Clase base abstracta
+ * - Trama: Trama por valor (parser y despacho sin memoria dinamica)
+ * - TramaBase: Clase base abstracta (adaptador polimorfico)
  * - TramaLoad: Procesa tramas de carga
  * - TramaMap: Procesa tramas de mapeo
- * - ListaDeCarga: Lista doble para el mensaje
- * - RotorDeMapeo: Lista circular para cifrado
- * - SerialPort: Comunicacion serial Windows
+ * - ListaDeCarga: Lista doble desenrollada (bloques de un PoolDeBloques) para el mensaje
+ * - RotorDeMapeo: Anillo circular (alfabeto + desplazamiento) para cifrado
+ * - FuenteDeTramas: Interfaz comun de las fuentes de lineas
+ * - SerialPort: Comunicacion serial (Win32 o termios) con buffer circular y modo binario
+ * - FuenteArchivo / FuenteMapeada: Capturas desde stdin, archivo o mmap
+ * - GrabadorDeCaptura / FuenteGrabada / FuenteCaptura: Captura binaria con marcas
+ *   de tiempo escrita por lotes y su reproduccion a N veces el ritmo original
+ * - DiarioDeDecodificacion: Diario de solo agregar con puntos de control para reanudar
+ * - DecodificadorParalelo: Captura en trozos por hilo + suma prefija de rotaciones
+ * - DecodificadorMultipuerto: Varios puertos con estado propio sobre un grupo de hilos
+ * - TablaDeSesiones: Hash abierto de sesiones multiplexadas, cada una con rotor y mensaje
+ * - TuberiaDecodificacion: Hilo lector + decodificador unidos por una ColaSPSC
+ * - CodificadorDeTramas: Texto en claro + calendario de rotaciones -> tramas (inversa del rotor)
+ * - GeneradorDeTramas: Trafico sintetico con su mensaje esperado (lo usa
+ *   bench/EmuladorESP32.cpp para pruebas de carga por pseudo-terminal o tuberia)
+ * - HistogramaLatencia: Histograma log-lineal de memoria fija (LatenciaPorEtapa)
+ * - MetricasDecodificador / ExportadorMetricas: Contadores atomicos y su hilo de publicacion
+ * - RegistroAsincrono: Trazas en anillos de bytes con un hilo de escritura por lotes
+ * - TrazaEventos: Tramos por trama en buffers por hilo, exportados como trace-event JSON
+ * - LatenciaEnlace: Latencia de un sentido y fluctuacion con las marcas de tiempo del ESP32
  * 
  * @section author Autor
  * 
@@ -0,0 +1,123 @@
+/**
+ * @file CodificadorDeTramas.cpp
+ * @brief Implementacion del codificador de tramas PRT-7
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "CodificadorDeTramas.h"
+#include "Trama.h"
+
+/**
+ * @brief Constructor - Rotor en 'A'
+ */
+CodificadorDeTramas::CodificadorDeTramas(int rafaga)
+    : rafagaMaxima(rafaga < 1 ? 1 : (rafaga > RAFAGA_MAXIMA ? RAFAGA_MAXIMA : rafaga)), tramas(0) {
+}
+
+/**
+ * @brief Escribe el texto como tramas LOAD
+ */
+long long CodificadorDeTramas::escribirCarga(const char* texto, long long n, char* destino) {
+    long long escritos = 0;
+
+    for (long long hecho = 0; hecho < n; hecho += rafagaMaxima) {
+        int tramo = n - hecho < rafagaMaxima ? static_cast<int>(n - hecho) : rafagaMaxima;
+
+        // "L," + texto cifrado en su lugar + "\r\n"
+        char* linea = destino + escritos;
+        linea[0] = 'L';
+        linea[1] = ',';
+        rotor.codificarBloque(texto + hecho, linea + 2, tramo);
+        linea[2 + tramo] = '\r';
+        linea[3 + tramo] = '\n';
+
+        escritos += tramo + 4;
+        tramas++;
+    }
+    return escritos;
+}
+
+/**
+ * @brief Escribe una trama MAP
+ */
+int CodificadorDeTramas::escribirMapa(int rotacion, char* destino) {
+    Trama trama;
+    trama.tipo = TRAMA_MAP;
+    trama.rotacion = rotacion;
+    trama.sesion = 0;
+    int n = escribirTrama(trama, destino, 14);
+    destino[n++] = '\r';
+    destino[n++] = '\n';
+
+    // Igual que RotorDeMapeo::rotar(), sin trazas
+    rotor.setDesplazamiento(rotor.getDesplazamiento() + rotacion % RotorDeMapeo::TAMANIO);
+    tramas++;
+    return n;
+}
+
+/**
+ * @brief Escribe la trama FIN
+ */
+int CodificadorDeTramas::escribirFin(char* destino) {
+    destino[0] = 'F';
+    destino[1] = 'I';
+    destino[2] = 'N';
+    destino[3] = '\r';
+    destino[4] = '\n';
+    tramas++;
+    return 5;
+}
+
+/**
+ * @brief Codifica un mensaje completo con su calendario de rotaciones
+ */
+long long CodificadorDeTramas::codificar(const char* texto, long long n, const RotacionProgramada* calendario,
+                                         int numRotaciones, bool conFin, char* destino) {
+    long long escritos = 0;
+    long long enviado = 0;
+
+    for (int i = 0; i < numRotaciones; i++) {
+        long long hasta = calendario[i].posicion;
+        if (hasta > n) hasta = n;
+        if (hasta > enviado) {
+            escritos += escribirCarga(texto + enviado, hasta - enviado, destino + escritos);
+            enviado = hasta;
+        }
+        escritos += escribirMapa(calendario[i].rotacion, destino + escritos);
+    }
+    if (n > enviado) {
+        escritos += escribirCarga(texto + enviado, n - enviado, destino + escritos);
+    }
+    if (conFin) {
+        escritos += escribirFin(destino + escritos);
+    }
+    return escritos;
+}
+
+/**
+ * @brief Cota de bytes para un mensaje
+ *
+ * Peor caso: "L,X\r\n" (5 bytes) por caracter, "M,-2147483648\r\n" (16) por
+ * rotacion y "FIN\r\n" (5).
+ */
+long long CodificadorDeTramas::capacidadNecesaria(long long n, int numRotaciones, int rafaga) {
+    if (rafaga < 1) rafaga = 1;
+    if (rafaga > RAFAGA_MAXIMA) rafaga = RAFAGA_MAXIMA;
+    long long lineasCarga = (n + rafaga - 1) / rafaga + numRotaciones;
+    return n + 4 * lineasCarga + 16LL * numRotaciones + 5;
+}
+
+/**
+ * @brief Tramas escritas
+ */
+unsigned long long CodificadorDeTramas::getTramas() const {
+    return tramas;
+}
+
+/**
+ * @brief Desplazamiento actual del rotor de cifrado
+ */
+int CodificadorDeTramas::getDesplazamiento() const {
+    return rotor.getDesplazamiento();
+}
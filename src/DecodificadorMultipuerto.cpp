@@ -0,0 +1,363 @@
+/**
+ * @file DecodificadorMultipuerto.cpp
+ * @brief Implementacion de la decodificacion simultanea de varios puertos
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "DecodificadorMultipuerto.h"
+#include "SerialPort.h"
+#include "Trama.h"
+#include "NivelDetalle.h"
+#include <iostream>
+#include <chrono>
+
+#ifndef WINDOWS_BUILD
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Mismo buffer de linea que el bucle principal
+const int TAMANIO_LINEA = 256;
+
+}
+
+/**
+ * @brief Constructor - Abre los puertos y prepara el grupo de hilos
+ */
+DecodificadorMultipuerto::DecodificadorMultipuerto(char* const* nombres, int cantidad, int hilos)
+    : numCanales(cantidad), numHilos(hilos), trabajadores(nullptr),
+      inicioCola(0), cuentaCola(0), canalesActivos(0), detener(false) {
+    canales = new Canal[numCanales];
+    colaTrabajo = new int[numCanales];
+
+    for (int i = 0; i < numCanales; i++) {
+        canales[i].nombre = nombres[i];
+        canales[i].puerto = new SerialPort(nombres[i]);
+        canales[i].ocupado = false;
+        canales[i].terminado = false;
+        canales[i].finRecibido = false;
+        canales[i].tramas = 0;
+        canales[i].invalidas = 0;
+
+        // Los hilos leen sin esperar: la espera la hace el despachador
+        canales[i].puerto->setTimeoutLectura(0);
+    }
+
+    // Uno por nucleo, pero nunca mas hilos que canales
+    if (numHilos <= 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+        if (numHilos <= 0) numHilos = 1;
+    }
+    if (numHilos > numCanales) numHilos = numCanales;
+    if (numHilos <= 0) numHilos = 1;
+
+#ifndef WINDOWS_BUILD
+    avisoDespachador[0] = -1;
+    avisoDespachador[1] = -1;
+    if (pipe(avisoDespachador) == 0) {
+        fcntl(avisoDespachador[0], F_SETFL, O_NONBLOCK);
+        fcntl(avisoDespachador[1], F_SETFL, O_NONBLOCK);
+    }
+#endif
+}
+
+/**
+ * @brief Destructor - Cierra los puertos
+ */
+DecodificadorMultipuerto::~DecodificadorMultipuerto() {
+    for (int i = 0; i < numCanales; i++) {
+        canales[i].puerto->cerrar();
+        delete canales[i].puerto;
+    }
+    delete[] canales;
+    delete[] colaTrabajo;
+
+#ifndef WINDOWS_BUILD
+    if (avisoDespachador[0] >= 0) close(avisoDespachador[0]);
+    if (avisoDespachador[1] >= 0) close(avisoDespachador[1]);
+#endif
+}
+
+/**
+ * @brief Indica si todos los puertos se abrieron
+ */
+bool DecodificadorMultipuerto::estanConectados() const {
+    for (int i = 0; i < numCanales; i++) {
+        if (!canales[i].puerto->estaConectado()) return false;
+    }
+#ifndef WINDOWS_BUILD
+    if (avisoDespachador[0] < 0) return false;
+#endif
+    return true;
+}
+
+/**
+ * @brief Pone un canal en la cola de trabajo (mutexTrabajo tomado)
+ */
+void DecodificadorMultipuerto::encolar(int indice) {
+    // Cada canal esta en la cola a lo mas una vez: numCanales basta
+    colaTrabajo[(inicioCola + cuentaCola) % numCanales] = indice;
+    cuentaCola++;
+    canales[indice].ocupado = true;
+}
+
+/**
+ * @brief Devuelve un canal tras un turno
+ */
+void DecodificadorMultipuerto::devolverCanal(int indice, bool pendiente) {
+    {
+        std::lock_guard<std::mutex> candado(mutexTrabajo);
+        Canal& canal = canales[indice];
+        if (canal.terminado) {
+            canalesActivos--;
+        } else if (pendiente) {
+            // Quedaron lineas en el anillo: otro turno sin pasar por poll()
+            encolar(indice);
+            hayTrabajo.notify_one();
+            return;
+        }
+        canal.ocupado = false;
+    }
+
+    // El despachador debe volver a vigilar este canal (o notar que termino)
+#ifndef WINDOWS_BUILD
+    char aviso = 1;
+    ssize_t escrito = write(avisoDespachador[1], &aviso, 1);
+    (void)escrito;
+#else
+    canalDevuelto.notify_one();
+#endif
+}
+
+/**
+ * @brief Procesa las lineas completas disponibles de un canal
+ */
+bool DecodificadorMultipuerto::atenderCanal(int indice) {
+    Canal& canal = canales[indice];
+    char linea[TAMANIO_LINEA];
+    Trama trama;
+
+    for (int atendidas = 0; atendidas < LINEAS_POR_TURNO; atendidas++) {
+        int n = canal.puerto->leerLinea(linea, TAMANIO_LINEA);
+        if (n == 0) {
+            if (!canal.puerto->estaConectado()) {
+                canal.terminado = true;
+                std::lock_guard<std::mutex> candado(mutexConsola);
+                std::cerr << "[" << canal.nombre << "] Error: Se perdio la conexion" << std::endl;
+                return false;
+            }
+            // Linea vacia o sin datos: solo seguir si hay otra linea lista
+            if (!canal.puerto->hayLineaCompleta()) return false;
+            continue;
+        }
+
+        ResultadoLinea resultado = interpretarTrama(linea, &trama);
+        if (resultado != LINEA_VALIDA) {
+            if (resultado == LINEA_CORTA || resultado == LINEA_DESCONOCIDA) {
+                canal.invalidas++;
+            }
+            continue;
+        }
+
+        canal.tramas++;
+        if (trama.tipo == TRAMA_FIN) {
+            canal.terminado = true;
+            canal.finRecibido = true;
+            if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+                std::lock_guard<std::mutex> candado(mutexConsola);
+                std::cout << "[" << canal.nombre << "] FIN recibido: " << canal.tramas << " tramas, "
+                          << canal.carga.getTamanio() << " caracteres" << std::endl;
+            }
+            return false;
+        }
+        procesarTrama(trama, &canal.carga, &canal.rotor);
+    }
+
+    // Tope del turno: puede quedar mas en el anillo
+    return true;
+}
+
+/**
+ * @brief Cuerpo de cada hilo de trabajo
+ */
+void DecodificadorMultipuerto::trabajar() {
+    while (true) {
+        int indice;
+        {
+            std::unique_lock<std::mutex> candado(mutexTrabajo);
+            while (cuentaCola == 0 && !detener) {
+                hayTrabajo.wait(candado);
+            }
+            if (cuentaCola == 0) return;
+            indice = colaTrabajo[inicioCola];
+            inicioCola = (inicioCola + 1) % numCanales;
+            cuentaCola--;
+        }
+
+        bool pendiente = atenderCanal(indice);
+        devolverCanal(indice, pendiente);
+    }
+}
+
+/**
+ * @brief Espera datos en los canales libres y encola los listos
+ */
+void DecodificadorMultipuerto::despachar() {
+#ifndef WINDOWS_BUILD
+    struct pollfd* esperas = new struct pollfd[numCanales + 1];
+    int* indices = new int[numCanales + 1];
+
+    while (true) {
+        // Vigilar solo los canales que no estan en manos de un hilo
+        int n = 0;
+        esperas[n].fd = avisoDespachador[0];
+        esperas[n].events = POLLIN;
+        indices[n++] = -1;
+        {
+            std::lock_guard<std::mutex> candado(mutexTrabajo);
+            if (canalesActivos == 0) break;
+            for (int i = 0; i < numCanales; i++) {
+                if (!canales[i].ocupado && !canales[i].terminado) {
+                    esperas[n].fd = canales[i].puerto->getDescriptor();
+                    esperas[n].events = POLLIN;
+                    indices[n++] = i;
+                }
+            }
+        }
+
+        if (poll(esperas, static_cast<nfds_t>(n), 100) <= 0) continue;
+
+        if (esperas[0].revents != 0) {
+            char basura[64];
+            while (read(avisoDespachador[0], basura, sizeof(basura)) > 0) {
+            }
+        }
+
+        std::lock_guard<std::mutex> candado(mutexTrabajo);
+        for (int k = 1; k < n; k++) {
+            if (esperas[k].revents != 0) {
+                encolar(indices[k]);
+                hayTrabajo.notify_one();
+            }
+        }
+    }
+
+    delete[] esperas;
+    delete[] indices;
+#else
+    // Sin poll() para COM: ofrecer cada milisegundo los canales libres
+    std::unique_lock<std::mutex> candado(mutexTrabajo);
+    while (canalesActivos > 0) {
+        for (int i = 0; i < numCanales; i++) {
+            if (!canales[i].ocupado && !canales[i].terminado) {
+                encolar(i);
+                hayTrabajo.notify_one();
+            }
+        }
+        canalDevuelto.wait_for(candado, std::chrono::milliseconds(1));
+    }
+#endif
+}
+
+/**
+ * @brief Atiende todos los canales hasta que cada uno termine
+ */
+void DecodificadorMultipuerto::ejecutar() {
+    canalesActivos = 0;
+    for (int i = 0; i < numCanales; i++) {
+        canales[i].terminado = !canales[i].puerto->estaConectado();
+        if (!canales[i].terminado) canalesActivos++;
+    }
+
+    detener = false;
+    trabajadores = new std::thread[numHilos];
+    for (int i = 0; i < numHilos; i++) {
+        trabajadores[i] = std::thread(&DecodificadorMultipuerto::trabajar, this);
+    }
+
+    despachar();
+
+    {
+        std::lock_guard<std::mutex> candado(mutexTrabajo);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (int i = 0; i < numHilos; i++) {
+        trabajadores[i].join();
+    }
+    delete[] trabajadores;
+    trabajadores = nullptr;
+}
+
+/**
+ * @brief Imprime el mensaje de cada canal, etiquetado con su puerto
+ */
+void DecodificadorMultipuerto::imprimirMensajes() {
+    bool conMarco = obtenerNivelDetalle() != DETALLE_SILENCIOSO;
+
+    for (int i = 0; i < numCanales; i++) {
+        Canal& canal = canales[i];
+        if (conMarco) {
+            std::cout << std::endl << "[" << canal.nombre << "] " << canal.tramas << " tramas";
+            if (canal.invalidas > 0) std::cout << ", " << canal.invalidas << " invalidas";
+            std::cout << (canal.finRecibido ? "" : " (sin FIN)") << std::endl;
+        } else {
+            std::cout << canal.nombre << ": ";
+        }
+        canal.carga.imprimirMensaje();
+    }
+}
+
+/**
+ * @brief Numero de canales
+ */
+int DecodificadorMultipuerto::getCanales() const {
+    return numCanales;
+}
+
+/**
+ * @brief Hilos de trabajo
+ */
+int DecodificadorMultipuerto::getHilos() const {
+    return numHilos;
+}
+
+/**
+ * @brief Tramas validas de todos los canales
+ */
+unsigned long long DecodificadorMultipuerto::getTramasTotales() const {
+    unsigned long long total = 0;
+    for (int i = 0; i < numCanales; i++) {
+        total += canales[i].tramas;
+    }
+    return total;
+}
+
+/**
+ * @brief Bytes recibidos en todos los canales
+ */
+unsigned long long DecodificadorMultipuerto::getBytesTotales() const {
+    unsigned long long total = 0;
+    for (int i = 0; i < numCanales; i++) {
+        total += canales[i].puerto->getBytesLeidos();
+    }
+    return total;
+}
+
+/**
+ * @brief Mensaje de un canal
+ */
+const ListaDeCarga& DecodificadorMultipuerto::getCarga(int indice) const {
+    return canales[indice].carga;
+}
+
+/**
+ * @brief Indica si el canal termino con FIN
+ */
+bool DecodificadorMultipuerto::recibioFin(int indice) const {
+    return canales[indice].finRecibido;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file DecodificadorParalelo.cpp
+ * @brief Implementacion de la decodificacion paralela de capturas
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "DecodificadorParalelo.h"
+#include "FuenteMapeada.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include <cstring>
+#include <thread>
+
+namespace {
+
+/// Mayor bloque que aceptan las funciones con tamanio int
+const unsigned long long PEDAZO_MAXIMO = 1ULL << 30;
+
+}
+
+/**
+ * @brief Constructor - Reserva un trozo por hilo
+ */
+DecodificadorParalelo::DecodificadorParalelo(int hilos)
+    : hilos(hilos), trozosActivos(0), datos(nullptr), tramasProcesadas(0), lineasInvalidas(0) {
+    if (this->hilos <= 0) {
+        this->hilos = static_cast<int>(std::thread::hardware_concurrency());
+        if (this->hilos <= 0) this->hilos = 1;
+    }
+    trozos = new Trozo[this->hilos];
+    for (int i = 0; i < this->hilos; i++) {
+        trozos[i].salida = nullptr;
+    }
+}
+
+/**
+ * @brief Destructor - Libera los mensajes parciales
+ */
+DecodificadorParalelo::~DecodificadorParalelo() {
+    for (int i = 0; i < hilos; i++) {
+        delete[] trozos[i].salida;
+    }
+    delete[] trozos;
+}
+
+/**
+ * @brief Pasada 1: recorre el trozo con un rotor local que empieza en 'A'
+ */
+void DecodificadorParalelo::decodificarTrozo(int indice) {
+    Trozo& trozo = trozos[indice];
+    trozo.cargas = 0;
+    trozo.tramas = 0;
+    trozo.invalidas = 0;
+    trozo.tieneFin = false;
+
+    delete[] trozo.salida;
+    // Cota de caracteres: "L,X\n" da 1 de 4 bytes, pero una rafaga "L,HOLA\n" casi 1 por byte
+    trozo.salida = new char[trozo.fin - trozo.inicio + 1];
+
+    RotorDeMapeo rotor;
+    char linea[TAMANIO_LINEA];
+    Trama trama;
+    unsigned long long posicion = trozo.inicio;
+
+    while (posicion < trozo.fin) {
+        FuenteMapeada::extraerLinea(datos, trozo.fin, &posicion, linea, TAMANIO_LINEA);
+
+        ResultadoLinea resultado = interpretarTrama(linea, &trama);
+        if (resultado != LINEA_VALIDA) {
+            if (resultado == LINEA_CORTA || resultado == LINEA_DESCONOCIDA) {
+                trozo.invalidas++;
+            }
+            continue;
+        }
+
+        trozo.tramas++;
+        if (trama.tipo == TRAMA_FIN) {
+            trozo.tieneFin = true;
+            break;
+        }
+        if (trama.tipo == TRAMA_LOAD && trama.longitud > 1) {
+            rotor.decodificarBloque(trama.texto, trozo.salida + trozo.cargas, trama.longitud);
+            trozo.cargas += static_cast<unsigned long long>(trama.longitud);
+        } else if (trama.tipo == TRAMA_LOAD) {
+            trozo.salida[trozo.cargas++] = rotor.getMapeo(trama.caracter);
+        } else {
+            // Igual que rotar(), sin trazas
+            rotor.setDesplazamiento(rotor.getDesplazamiento() + trama.rotacion % RotorDeMapeo::TAMANIO);
+        }
+    }
+
+    trozo.consumido = posicion;
+    trozo.rotacion = rotor.getDesplazamiento();
+}
+
+/**
+ * @brief Pasada 2: desplaza las letras del trozo segun su cabeza real
+ */
+void DecodificadorParalelo::corregirTrozo(int indice) {
+    if (indice >= trozosActivos) return;
+
+    Trozo& trozo = trozos[indice];
+    if (trozo.desplazamiento == 0) return;
+
+    RotorDeMapeo rotor;
+    rotor.setDesplazamiento(trozo.desplazamiento);
+
+    for (unsigned long long hecho = 0; hecho < trozo.cargas; hecho += PEDAZO_MAXIMO) {
+        unsigned long long n = trozo.cargas - hecho;
+        if (n > PEDAZO_MAXIMO) n = PEDAZO_MAXIMO;
+        rotor.decodificarBloque(trozo.salida + hecho, trozo.salida + hecho, static_cast<int>(n));
+    }
+}
+
+/**
+ * @brief Ejecuta una pasada: el trozo 0 en este hilo, el resto en hilos nuevos
+ */
+void DecodificadorParalelo::ejecutarPasada(void (DecodificadorParalelo::*pasada)(int)) {
+    std::thread* trabajadores = hilos > 1 ? new std::thread[hilos - 1] : nullptr;
+
+    for (int i = 1; i < hilos; i++) {
+        trabajadores[i - 1] = std::thread(pasada, this, i);
+    }
+    (this->*pasada)(0);
+    for (int i = 1; i < hilos; i++) {
+        trabajadores[i - 1].join();
+    }
+
+    delete[] trabajadores;
+}
+
+/**
+ * @brief Decodifica el resto de la captura en paralelo
+ */
+bool DecodificadorParalelo::decodificar(FuenteMapeada* captura, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    datos = captura->getDatos();
+    unsigned long long base = captura->getBytesLeidos();
+    unsigned long long total = captura->getTamanio();
+    tramasProcesadas = 0;
+    lineasInvalidas = 0;
+
+    if (datos == nullptr || base >= total) {
+        captura->setPosicion(total);
+        return false;
+    }
+
+    // Cortar en trozos de tamanio parecido, cada uno justo despues de un '\n'
+    // (ahi empieza una linea tambien en la lectura secuencial)
+    unsigned long long paso = (total - base) / hilos;
+    trozos[0].inicio = base;
+    for (int i = 1; i < hilos; i++) {
+        unsigned long long corte = base + paso * i;
+        if (corte < trozos[i - 1].inicio) corte = trozos[i - 1].inicio;
+
+        const char* salto = static_cast<const char*>(std::memchr(datos + corte, '\n', total - corte));
+        corte = salto ? static_cast<unsigned long long>(salto - datos) + 1 : total;
+
+        trozos[i - 1].fin = corte;
+        trozos[i].inicio = corte;
+    }
+    trozos[hilos - 1].fin = total;
+
+    // Pasada 1: decodificar cada trozo desde 'A'
+    ejecutarPasada(&DecodificadorParalelo::decodificarTrozo);
+
+    // Suma prefija exclusiva de las rotaciones, hasta el primer trozo con FIN
+    bool finRecibido = false;
+    int desplazamiento = rotor->getDesplazamiento();
+    trozosActivos = hilos;
+    for (int i = 0; i < hilos; i++) {
+        trozos[i].desplazamiento = desplazamiento;
+        desplazamiento = (desplazamiento + trozos[i].rotacion) % RotorDeMapeo::TAMANIO;
+        tramasProcesadas += trozos[i].tramas;
+        lineasInvalidas += trozos[i].invalidas;
+
+        if (trozos[i].tieneFin) {
+            finRecibido = true;
+            trozosActivos = i + 1;
+            break;
+        }
+    }
+
+    // Pasada 2: aplicar a cada trozo su desplazamiento real
+    ejecutarPasada(&DecodificadorParalelo::corregirTrozo);
+
+    // Agregar los trozos en orden
+    unsigned long long mensaje = 0;
+    for (int i = 0; i < trozosActivos; i++) {
+        mensaje += trozos[i].cargas;
+    }
+    carga->reservar(static_cast<long long>(mensaje));
+    for (int i = 0; i < trozosActivos; i++) {
+        for (unsigned long long hecho = 0; hecho < trozos[i].cargas; hecho += PEDAZO_MAXIMO) {
+            unsigned long long n = trozos[i].cargas - hecho;
+            if (n > PEDAZO_MAXIMO) n = PEDAZO_MAXIMO;
+            carga->insertarBloque(trozos[i].salida + hecho, static_cast<int>(n));
+        }
+    }
+
+    // Dejar rotor y captura como los dejaria la lectura secuencial
+    rotor->setDesplazamiento(desplazamiento);
+    captura->setPosicion(trozos[trozosActivos - 1].consumido);
+
+    for (int i = 0; i < hilos; i++) {
+        delete[] trozos[i].salida;
+        trozos[i].salida = nullptr;
+    }
+    return finRecibido;
+}
+
+/**
+ * @brief Hilos de trabajo
+ */
+int DecodificadorParalelo::getHilos() const {
+    return hilos;
+}
+
+/**
+ * @brief Tramas validas de la ultima decodificacion
+ */
+unsigned long long DecodificadorParalelo::getTramasProcesadas() const {
+    return tramasProcesadas;
+}
+
+/**
+ * @brief Lineas invalidas de la ultima decodificacion
+ */
+unsigned long long DecodificadorParalelo::getLineasInvalidas() const {
+    return lineasInvalidas;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file DiarioDeDecodificacion.cpp
+ * @brief Implementacion del diario con puntos de control
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "DiarioDeDecodificacion.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+
+#ifdef WINDOWS_BUILD
+#include <io.h>
+#include <sys/stat.h>
+#define read _read
+#define write _write
+#define close _close
+#define lseek _lseek
+#else
+#include <unistd.h>
+#endif
+
+static const int LARGO_CABECERA_DIARIO = 8;                 ///< Bytes de CABECERA_DIARIO
+static const unsigned char VERSION_DIARIO = 1;              ///< Version del formato
+static const int BYTES_CABECERA_DIARIO = LARGO_CABECERA_DIARIO + 1;
+static const int BYTES_PUNTO_SIN_HASH = 1 + 8 + 4 + 8 + 1;  ///< 'P', largo, rotor, tramas, completo
+static const int BYTES_PUNTO = BYTES_PUNTO_SIN_HASH + 4;
+static const unsigned int FNV_INICIAL = 2166136261u;
+static const unsigned int FNV_PRIMO = 16777619u;
+
+/**
+ * @brief Acumula bytes en un hash FNV-1a de 32 bits
+ */
+static unsigned int acumularHash(unsigned int hash, const unsigned char* datos, int n) {
+    for (int i = 0; i < n; i++) {
+        hash ^= datos[i];
+        hash *= FNV_PRIMO;
+    }
+    return hash;
+}
+
+/**
+ * @brief Escribe un entero de n bytes en little-endian
+ */
+static void escribirEntero(unsigned long long valor, unsigned char* destino, int n) {
+    for (int i = 0; i < n; i++) {
+        destino[i] = static_cast<unsigned char>(valor >> (8 * i));
+    }
+}
+
+/**
+ * @brief Lee un entero de n bytes en little-endian
+ */
+static unsigned long long leerEntero(const unsigned char* origen, int n) {
+    unsigned long long valor = 0;
+    for (int i = 0; i < n; i++) {
+        valor |= static_cast<unsigned long long>(origen[i]) << (8 * i);
+    }
+    return valor;
+}
+
+/**
+ * @brief Escribe la cabecera del diario
+ * @return Bytes escritos
+ */
+static int escribirCabecera(unsigned char* destino) {
+    std::memcpy(destino, CABECERA_DIARIO, LARGO_CABECERA_DIARIO);
+    destino[LARGO_CABECERA_DIARIO] = VERSION_DIARIO;
+    return BYTES_CABECERA_DIARIO;
+}
+
+/**
+ * @brief Reloj monotono en milisegundos
+ */
+static long long ahoraMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Lleva al disco lo escrito (solo los datos si el sistema lo permite)
+ */
+static bool sincronizar(int fd) {
+#ifdef WINDOWS_BUILD
+    return _commit(fd) == 0;
+#elif defined(__linux__)
+    return fdatasync(fd) == 0;
+#else
+    return fsync(fd) == 0;
+#endif
+}
+
+/**
+ * @brief Recorta el archivo a n bytes y deja el cursor al final
+ */
+static bool recortar(int fd, long long n) {
+#ifdef WINDOWS_BUILD
+    if (_chsize_s(fd, n) != 0) return false;
+#else
+    if (ftruncate(fd, static_cast<off_t>(n)) != 0) return false;
+#endif
+    return lseek(fd, 0, SEEK_END) >= 0;
+}
+
+/**
+ * @brief Constructor
+ */
+DiarioDeDecodificacion::DiarioDeDecodificacion(const char* ruta, int intervaloMs)
+    : fd(-1), ruta(new char[std::strlen(ruta) + 1]), lote(new unsigned char[TAMANIO_LOTE]), usados(0),
+      hash(FNV_INICIAL), intervaloMs(intervaloMs), ultimoPuntoMs(ahoraMs()), largoDiario(0),
+      desplazamientoDiario(0), tramasPrevias(0), tramasDiario(0), completoDiario(false),
+      largoRestaurado(0), puntos(0), fallo(false) {
+    std::strcpy(this->ruta, ruta);
+}
+
+/**
+ * @brief Destructor - Cierra el diario
+ */
+DiarioDeDecodificacion::~DiarioDeDecodificacion() {
+    if (fd >= 0) {
+        if (usados > 0 && !fallo) escribirLote();
+        close(fd);
+    }
+    delete[] lote;
+    delete[] ruta;
+}
+
+/**
+ * @brief Abre (o crea) el diario y reanuda desde su ultimo punto
+ */
+bool DiarioDeDecodificacion::abrir(ListaDeCarga* lista, RotorDeMapeo* rotor) {
+#ifdef WINDOWS_BUILD
+    fd = _open(ruta, _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd = open(ruta, O_RDWR | O_CREAT, 0644);
+#endif
+    if (fd < 0) {
+        std::cerr << "Error: No se pudo abrir el diario " << ruta
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    if (!reanudar(lista, rotor)) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    ultimoPuntoMs = ahoraMs();
+    return true;
+}
+
+/**
+ * @brief Lee el diario completo y restaura el ultimo punto valido
+ *
+ * Primera pasada: validar registros y hashes hasta el ultimo punto bueno.
+ * Segunda pasada: insertar en la lista los 'D' hasta ese punto. Lo que
+ * quede despues se recorta del archivo para seguir agregando desde ahi.
+ */
+bool DiarioDeDecodificacion::reanudar(ListaDeCarga* lista, RotorDeMapeo* rotor) {
+    long long tamanio = lseek(fd, 0, SEEK_END);
+    if (tamanio < 0 || lseek(fd, 0, SEEK_SET) < 0) {
+        std::cerr << "Error: No se pudo leer el diario " << ruta << std::endl;
+        return false;
+    }
+
+    if (tamanio == 0) {
+        // Diario nuevo: la cabecera sale con el primer punto
+        usados = escribirCabecera(lote);
+        return true;
+    }
+
+    unsigned char* contenido = new unsigned char[tamanio];
+    long long leidos = 0;
+    while (leidos < tamanio) {
+        int porLeer = tamanio - leidos > (1 << 30) ? (1 << 30) : static_cast<int>(tamanio - leidos);
+        int n = static_cast<int>(read(fd, contenido + leidos, porLeer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        leidos += n;
+    }
+    if (leidos == tamanio && tamanio < BYTES_CABECERA_DIARIO
+        && std::memcmp(contenido, CABECERA_DIARIO, static_cast<size_t>(tamanio)) == 0) {
+        // La primera escritura quedo a medias: es un diario nuevo
+        delete[] contenido;
+        if (!recortar(fd, 0)) return false;
+        usados = escribirCabecera(lote);
+        return true;
+    }
+    if (leidos < tamanio || tamanio < BYTES_CABECERA_DIARIO
+        || std::memcmp(contenido, CABECERA_DIARIO, LARGO_CABECERA_DIARIO) != 0
+        || contenido[LARGO_CABECERA_DIARIO] != VERSION_DIARIO) {
+        std::cerr << "Error: " << ruta << " no es un diario del decodificador (no se modifica)" << std::endl;
+        delete[] contenido;
+        return false;
+    }
+
+    // Primera pasada: ultimo punto de control valido
+    long long posicion = BYTES_CABECERA_DIARIO;
+    long long ultimoValido = BYTES_CABECERA_DIARIO;
+    unsigned long long largo = 0;
+    unsigned int acumulado = FNV_INICIAL;
+    while (posicion < tamanio) {
+        long long inicioRegistro = posicion;
+        if (contenido[posicion] == 'D') {
+            unsigned long long n = 0;
+            int desplazamiento = 0;
+            bool completo = false;
+            posicion++;
+            while (posicion < tamanio && desplazamiento < 35 && !completo) {
+                unsigned char byte = contenido[posicion++];
+                n |= static_cast<unsigned long long>(byte & 0x7F) << desplazamiento;
+                desplazamiento += 7;
+                completo = (byte & 0x80) == 0;
+            }
+            if (!completo || n > static_cast<unsigned long long>(tamanio - posicion)) {
+                break;
+            }
+            posicion += static_cast<long long>(n);
+            acumulado = acumularHash(acumulado, contenido + inicioRegistro,
+                                     static_cast<int>(posicion - inicioRegistro));
+            largo += n;
+        } else if (contenido[posicion] == 'P' && tamanio - posicion >= BYTES_PUNTO) {
+            const unsigned char* punto = contenido + posicion;
+            acumulado = acumularHash(acumulado, punto, BYTES_PUNTO_SIN_HASH);
+            if (leerEntero(punto + BYTES_PUNTO_SIN_HASH, 4) != acumulado || leerEntero(punto + 1, 8) != largo) {
+                break;
+            }
+            posicion += BYTES_PUNTO;
+            ultimoValido = posicion;
+            largoDiario = static_cast<long long>(largo);
+            desplazamientoDiario = static_cast<int>(leerEntero(punto + 9, 4));
+            tramasDiario = leerEntero(punto + 13, 8);
+            completoDiario = punto[21] != 0;
+            acumulado = FNV_INICIAL;
+        } else {
+            break;
+        }
+    }
+
+    if (completoDiario) {
+        // El mensaje anterior termino: empezar uno nuevo en el mismo archivo
+        std::cerr << "Diario: el mensaje de " << ruta << " ya tenia FIN; se empieza uno nuevo" << std::endl;
+        ultimoValido = BYTES_CABECERA_DIARIO;
+        largoDiario = 0;
+        desplazamientoDiario = 0;
+        tramasDiario = 0;
+        completoDiario = false;
+    } else if (largoDiario > 0 || tramasDiario > 0) {
+        // Segunda pasada: los 'D' hasta el ultimo punto
+        lista->reservar(largoDiario);
+        posicion = BYTES_CABECERA_DIARIO;
+        while (posicion < ultimoValido) {
+            if (contenido[posicion] == 'P') {
+                posicion += BYTES_PUNTO;
+                continue;
+            }
+            unsigned long long n = 0;
+            int desplazamiento = 0;
+            posicion++;
+            while (true) {
+                unsigned char byte = contenido[posicion++];
+                n |= static_cast<unsigned long long>(byte & 0x7F) << desplazamiento;
+                desplazamiento += 7;
+                if ((byte & 0x80) == 0) break;
+            }
+            lista->insertarBloqueSinEco(reinterpret_cast<const char*>(contenido + posicion), static_cast<int>(n));
+            posicion += static_cast<long long>(n);
+        }
+        rotor->setDesplazamiento(desplazamientoDiario);
+        tramasPrevias = tramasDiario;
+        largoRestaurado = largoDiario;
+    }
+    delete[] contenido;
+
+    // Descartar lo escrito despues del ultimo punto (y dejar el cursor al final)
+    if (!recortar(fd, ultimoValido)) {
+        std::cerr << "Error: No se pudo recortar el diario " << ruta
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Agrega bytes al lote y al hash del punto en curso
+ */
+void DiarioDeDecodificacion::agregar(const unsigned char* datos, int n) {
+    if (usados + n > TAMANIO_LOTE && !escribirLote()) return;
+    std::memcpy(lote + usados, datos, n);
+    hash = acumularHash(hash, datos, n);
+    usados += n;
+}
+
+/**
+ * @brief Escribe el lote con los write() que hagan falta
+ */
+bool DiarioDeDecodificacion::escribirLote() {
+    int escritos = 0;
+    while (escritos < usados) {
+        int n = static_cast<int>(write(fd, lote + escritos, usados - escritos));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            std::cerr << "Error: Fallo la escritura del diario (" << std::strerror(errno)
+                      << "); se dejan de guardar puntos de control" << std::endl;
+            fallo = true;
+            usados = 0;
+            return false;
+        }
+        escritos += n;
+    }
+    usados = 0;
+    return true;
+}
+
+/**
+ * @brief Agrega los caracteres nuevos y un punto de control, y sincroniza
+ */
+void DiarioDeDecodificacion::puntoDeControl(const ListaDeCarga* lista, const RotorDeMapeo* rotor,
+                                            unsigned long long tramas, bool completo) {
+    ultimoPuntoMs = ahoraMs();
+    if (fd < 0 || fallo) return;
+
+    long long largo = lista->getTamanio();
+    int desplazamiento = rotor->getDesplazamiento();
+    unsigned long long total = tramasPrevias + tramas;
+    if (largo == largoDiario && desplazamiento == desplazamientoDiario && total == tramasDiario
+        && completo == completoDiario) {
+        // Nada nuevo: sin fsync en un enlace en reposo
+        return;
+    }
+
+    // Caracteres nuevos, copiados de la lista directo al lote
+    while (largoDiario < largo && !fallo) {
+        const int MAXIMO_VARINT = 5;
+        if (usados + 1 + MAXIMO_VARINT + 1 > TAMANIO_LOTE && !escribirLote()) return;
+        int n = TAMANIO_LOTE - usados - 1 - MAXIMO_VARINT;
+        if (largo - largoDiario < n) n = static_cast<int>(largo - largoDiario);
+
+        unsigned char encabezado[1 + MAXIMO_VARINT];
+        int bytes = 0;
+        encabezado[bytes++] = 'D';
+        unsigned int valor = static_cast<unsigned int>(n);
+        while (valor >= 0x80) {
+            encabezado[bytes++] = static_cast<unsigned char>(valor | 0x80);
+            valor >>= 7;
+        }
+        encabezado[bytes++] = static_cast<unsigned char>(valor);
+        agregar(encabezado, bytes);
+
+        unsigned char* destino = lote + usados;
+        lista->copiarTramo(largoDiario, reinterpret_cast<char*>(destino), n);
+        hash = acumularHash(hash, destino, n);
+        usados += n;
+        largoDiario += n;
+    }
+
+    unsigned char punto[BYTES_PUNTO];
+    punto[0] = 'P';
+    escribirEntero(static_cast<unsigned long long>(largo), punto + 1, 8);
+    escribirEntero(static_cast<unsigned long long>(desplazamiento), punto + 9, 4);
+    escribirEntero(total, punto + 13, 8);
+    punto[21] = completo ? 1 : 0;
+    agregar(punto, BYTES_PUNTO_SIN_HASH);
+    escribirEntero(hash, punto, 4);
+    if (usados + 4 > TAMANIO_LOTE && !escribirLote()) return;
+    std::memcpy(lote + usados, punto, 4);
+    usados += 4;
+
+    if (!escribirLote()) return;
+    if (!sincronizar(fd)) {
+        std::cerr << "Error: Fallo la sincronizacion del diario (" << std::strerror(errno)
+                  << "); se dejan de guardar puntos de control" << std::endl;
+        fallo = true;
+        return;
+    }
+    hash = FNV_INICIAL;
+    desplazamientoDiario = desplazamiento;
+    tramasDiario = total;
+    completoDiario = completo;
+    puntos++;
+}
+
+/**
+ * @brief Punto de control si ya paso el intervalo desde el anterior
+ */
+void DiarioDeDecodificacion::puntoDeControlSiVencido(const ListaDeCarga* lista, const RotorDeMapeo* rotor,
+                                                     unsigned long long tramas) {
+    if (ahoraMs() - ultimoPuntoMs >= intervaloMs) {
+        puntoDeControl(lista, rotor, tramas, false);
+    }
+}
+
+/**
+ * @brief Caracteres restaurados
+ */
+long long DiarioDeDecodificacion::getLargoRestaurado() const {
+    return largoRestaurado;
+}
+
+/**
+ * @brief Tramas de ejecuciones anteriores
+ */
+unsigned long long DiarioDeDecodificacion::getTramasPrevias() const {
+    return tramasPrevias;
+}
+
+/**
+ * @brief Puntos escritos en esta ejecucion
+ */
+unsigned long long DiarioDeDecodificacion::getPuntos() const {
+    return puntos;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file ExportadorMetricas.cpp
+ * @brief Implementacion del exportador de metricas (archivo o socket Unix)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "ExportadorMetricas.h"
+#include "MetricasDecodificador.h"
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+
+#ifndef WINDOWS_BUILD
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+/**
+ * @brief Copia una cadena en memoria nueva
+ */
+static char* copiarCadena(const char* texto, const char* sufijo) {
+    size_t largo = std::strlen(texto);
+    size_t largoSufijo = std::strlen(sufijo);
+    char* copia = new char[largo + largoSufijo + 1];
+    std::memcpy(copia, texto, largo);
+    std::memcpy(copia + largo, sufijo, largoSufijo + 1);
+    return copia;
+}
+
+/**
+ * @brief Constructor - Separa el modo del destino
+ */
+ExportadorMetricas::ExportadorMetricas(const MetricasDecodificador* metricas, const char* destino, int intervalo)
+    : origen(metricas), esSocket(std::strncmp(destino, "unix:", 5) == 0),
+      intervaloMs(intervalo > 0 ? intervalo : INTERVALO_POR_DEFECTO_MS), descriptorSocket(-1),
+      iniciado(false), terminar(false) {
+    ruta = copiarCadena(esSocket ? destino + 5 : destino, "");
+    rutaTemporal = copiarCadena(ruta, ".tmp");
+}
+
+/**
+ * @brief Destructor
+ */
+ExportadorMetricas::~ExportadorMetricas() {
+    detener();
+    delete[] ruta;
+    delete[] rutaTemporal;
+}
+
+/**
+ * @brief Indica si el destino es valido en esta plataforma
+ */
+bool ExportadorMetricas::esDestinoValido(const char* destino) {
+    if (std::strncmp(destino, "unix:", 5) == 0) {
+#ifdef WINDOWS_BUILD
+        return false;
+#else
+        return destino[5] != '\0' && std::strlen(destino + 5) < sizeof(((sockaddr_un*)0)->sun_path);
+#endif
+    }
+    return destino[0] != '\0';
+}
+
+/**
+ * @brief Abre el destino y arranca el hilo
+ */
+bool ExportadorMetricas::iniciar() {
+    if (iniciado) return true;
+
+    if (esSocket) {
+#ifdef WINDOWS_BUILD
+        return false;
+#else
+        descriptorSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descriptorSocket < 0) return false;
+
+        sockaddr_un direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sun_family = AF_UNIX;
+        std::strncpy(direccion.sun_path, ruta, sizeof(direccion.sun_path) - 1);
+
+        // Un socket viejo de una ejecucion anterior impediria el bind
+        unlink(ruta);
+        if (bind(descriptorSocket, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) != 0
+            || listen(descriptorSocket, 8) != 0) {
+            close(descriptorSocket);
+            descriptorSocket = -1;
+            return false;
+        }
+        hilo = std::thread(&ExportadorMetricas::atenderSocket, this);
+#endif
+    } else {
+        // Primera instantanea ya, para detectar una ruta invalida al arrancar
+        if (!escribirArchivo()) return false;
+        hilo = std::thread(&ExportadorMetricas::publicarEnArchivo, this);
+    }
+    iniciado = true;
+    return true;
+}
+
+/**
+ * @brief Detiene el hilo
+ */
+void ExportadorMetricas::detener() {
+    if (!iniciado) return;
+
+    {
+        std::lock_guard<std::mutex> bloqueo(mutexAviso);
+        terminar.store(true);
+    }
+    aviso.notify_one();
+    hilo.join();
+    iniciado = false;
+
+    if (esSocket) {
+#ifndef WINDOWS_BUILD
+        close(descriptorSocket);
+        descriptorSocket = -1;
+        unlink(ruta);
+#endif
+    } else {
+        escribirArchivo();
+    }
+}
+
+/**
+ * @brief Escribe una instantanea en RUTA.tmp y la renombra a RUTA
+ */
+bool ExportadorMetricas::escribirArchivo() {
+    char texto[MetricasDecodificador::CAPACIDAD_TEXTO];
+    int n = origen->escribirTexto(texto, sizeof(texto));
+
+    FILE* archivo = std::fopen(rutaTemporal, "wb");
+    if (!archivo) return false;
+    bool correcto = std::fwrite(texto, 1, static_cast<size_t>(n), archivo) == static_cast<size_t>(n);
+    correcto = std::fclose(archivo) == 0 && correcto;
+    if (!correcto) return false;
+
+#ifdef WINDOWS_BUILD
+    // rename() de Windows no reemplaza un archivo existente
+    std::remove(ruta);
+#endif
+    return std::rename(rutaTemporal, ruta) == 0;
+}
+
+/**
+ * @brief Hilo en modo archivo: una instantanea por intervalo
+ */
+void ExportadorMetricas::publicarEnArchivo() {
+    std::unique_lock<std::mutex> bloqueo(mutexAviso);
+    while (!terminar.load()) {
+        aviso.wait_for(bloqueo, std::chrono::milliseconds(intervaloMs));
+        if (terminar.load()) break;
+
+        bloqueo.unlock();
+        escribirArchivo();
+        bloqueo.lock();
+    }
+}
+
+/**
+ * @brief Hilo en modo socket: una instantanea por conexion
+ *
+ * Espera conexiones con poll() en pasos cortos para notar 'terminar' sin
+ * necesitar otro descriptor de aviso.
+ */
+void ExportadorMetricas::atenderSocket() {
+#ifndef WINDOWS_BUILD
+    const int PASO_MS = 100;
+    char texto[MetricasDecodificador::CAPACIDAD_TEXTO];
+
+    while (!terminar.load()) {
+        pollfd espera;
+        espera.fd = descriptorSocket;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        int listos = poll(&espera, 1, PASO_MS);
+        if (listos <= 0) continue;
+
+        int cliente = accept(descriptorSocket, nullptr, nullptr);
+        if (cliente < 0) continue;
+
+        int n = origen->escribirTexto(texto, sizeof(texto));
+        int enviado = 0;
+        while (enviado < n) {
+#ifdef MSG_NOSIGNAL
+            ssize_t escritos = send(cliente, texto + enviado, static_cast<size_t>(n - enviado), MSG_NOSIGNAL);
+#else
+            ssize_t escritos = send(cliente, texto + enviado, static_cast<size_t>(n - enviado), 0);
+#endif
+            if (escritos < 0 && errno == EINTR) continue;
+            if (escritos <= 0) break;
+            enviado += static_cast<int>(escritos);
+        }
+        close(cliente);
+    }
+#endif
+}
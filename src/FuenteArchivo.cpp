@@ -0,0 +1,196 @@
+/**
+ * @file FuenteArchivo.cpp
+ * @brief Implementacion de la lectura de tramas desde archivo o stdin
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "FuenteArchivo.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef WINDOWS_BUILD
+#include <io.h>
+#define read _read
+#define close _close
+#else
+#include <unistd.h>
+#include <poll.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Constructor - Abre el archivo (o toma stdin)
+ */
+FuenteArchivo::FuenteArchivo(const char* ruta)
+    : fd(-1), propio(false), conEspera(false), conectado(false), finDeArchivo(false),
+      bloque(new char[TAMANIO_BLOQUE]), inicio(0), fin(0), bytesLeidos(0) {
+    if (ruta == nullptr) {
+        fd = 0;
+#ifdef WINDOWS_BUILD
+        _setmode(0, _O_BINARY);
+#endif
+    } else {
+#ifdef WINDOWS_BUILD
+        fd = _open(ruta, _O_RDONLY | _O_BINARY);
+#else
+        fd = open(ruta, O_RDONLY);
+#endif
+        if (fd < 0) {
+            std::cerr << "Error: No se pudo abrir la captura " << ruta
+                      << " (" << std::strerror(errno) << ")" << std::endl;
+            return;
+        }
+        propio = true;
+    }
+
+#ifndef WINDOWS_BUILD
+    // Un archivo regular nunca bloquea; stdin puede ser una tuberia o una terminal
+    struct stat estado;
+    conEspera = fstat(fd, &estado) == 0 && !S_ISREG(estado.st_mode);
+#endif
+    conectado = true;
+}
+
+/**
+ * @brief Destructor - Cierra el archivo y libera el bloque
+ */
+FuenteArchivo::~FuenteArchivo() {
+    cerrar();
+    delete[] bloque;
+}
+
+/**
+ * @brief Compacta los pendientes al inicio del bloque y lee mas bytes
+ */
+FuenteArchivo::ResultadoLectura FuenteArchivo::llenarBloque() {
+    if (finDeArchivo || fd < 0) return LECTURA_FIN;
+
+    int pendientes = fin - inicio;
+    if (inicio > 0) {
+        std::memmove(bloque, bloque + inicio, pendientes);
+        inicio = 0;
+        fin = pendientes;
+    }
+
+#ifndef WINDOWS_BUILD
+    if (conEspera) {
+        // Dormir en poll() con limite: un emisor callado no deja colgado al lector
+        struct pollfd espera;
+        espera.fd = fd;
+        espera.events = POLLIN;
+        espera.revents = 0;
+        int listo = poll(&espera, 1, ESPERA_MAXIMA_MS);
+        if (listo == 0 || (listo < 0 && errno == EINTR)) {
+            return LECTURA_VACIA;
+        }
+    }
+#endif
+
+    int n = static_cast<int>(read(fd, bloque + fin, TAMANIO_BLOQUE - fin));
+    if (n > 0) {
+        fin += n;
+        bytesLeidos += static_cast<unsigned long long>(n);
+        return LECTURA_DATOS;
+    }
+    if (n < 0 && errno == EINTR) {
+        // Una senal: volver sin linea para que el bucle la atienda
+        return LECTURA_VACIA;
+    }
+    if (n < 0) {
+        std::cerr << "Error: Fallo la lectura de la captura (" << std::strerror(errno) << ")" << std::endl;
+    }
+    finDeArchivo = true;
+    return LECTURA_FIN;
+}
+
+/**
+ * @brief Copia n bytes pendientes al buffer (omitiendo '\r') y los consume
+ */
+int FuenteArchivo::extraerLinea(char* buffer, int bufferSize, int n, int separador) {
+    int posicion = 0;
+    const char* origen = bloque + inicio;
+
+    for (int i = 0; i < n && posicion < bufferSize - 1; i++) {
+        // Ignorar \r
+        if (origen[i] == '\r') {
+            continue;
+        }
+        buffer[posicion++] = origen[i];
+    }
+
+    buffer[posicion] = '\0';
+    inicio += n + separador;
+    return posicion;
+}
+
+/**
+ * @brief Lee la siguiente linea del archivo
+ */
+int FuenteArchivo::leerLinea(char* buffer, int bufferSize) {
+    if (bufferSize <= 0) return 0;
+    buffer[0] = '\0';
+    if (bufferSize == 1 || !conectado) return 0;
+
+    int revisado = 0;
+    while (true) {
+        // Buscar '\n' solo en los bytes que aun no se revisaron y solo hasta el
+        // trozo maximo mas su separador, como FuenteMapeada::extraerLinea()
+        int pendientes = fin - inicio;
+        int busqueda = (pendientes < bufferSize ? pendientes : bufferSize) - revisado;
+        const char* salto = static_cast<const char*>(
+            std::memchr(bloque + inicio + revisado, '\n', busqueda));
+        if (salto) {
+            return extraerLinea(buffer, bufferSize, static_cast<int>(salto - (bloque + inicio)), 1);
+        }
+
+        // Linea mas larga que el buffer (o que el bloque): entregar un trozo
+        if (pendientes >= bufferSize || pendientes == TAMANIO_BLOQUE) {
+            int trozo = bufferSize - 1 < pendientes ? bufferSize - 1 : pendientes;
+            return extraerLinea(buffer, bufferSize, trozo, 0);
+        }
+        revisado = pendientes;
+
+        ResultadoLectura resultado = llenarBloque();
+        if (resultado == LECTURA_VACIA) {
+            // Nada a tiempo: los bytes de una linea a medias siguen pendientes
+            return 0;
+        }
+        if (resultado == LECTURA_FIN) {
+            // Fin del archivo: la ultima linea puede no tener '\n'
+            if (pendientes > 0) {
+                return extraerLinea(buffer, bufferSize, pendientes, 0);
+            }
+            conectado = false;
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Indica si quedan lineas
+ */
+bool FuenteArchivo::estaConectado() const {
+    return conectado;
+}
+
+/**
+ * @brief Bytes leidos del descriptor
+ */
+unsigned long long FuenteArchivo::getBytesLeidos() const {
+    return bytesLeidos;
+}
+
+/**
+ * @brief Cierra el archivo (stdin no se cierra)
+ */
+void FuenteArchivo::cerrar() {
+    if (propio && fd >= 0) {
+        close(fd);
+    }
+    fd = -1;
+    propio = false;
+    conectado = false;
+}
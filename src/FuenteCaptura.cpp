@@ -0,0 +1,259 @@
+/**
+ * @file FuenteCaptura.cpp
+ * @brief Implementacion de la reproduccion de capturas binarias
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "FuenteCaptura.h"
+#include "GrabadorDeCaptura.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+#include <fcntl.h>
+
+#ifdef WINDOWS_BUILD
+#include <io.h>
+#define read _read
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Constructor - Abre la captura y verifica la primera cabecera
+ */
+FuenteCaptura::FuenteCaptura(const char* ruta)
+    : fd(-1), conectado(false), finDeArchivo(false), bloque(new unsigned char[TAMANIO_BLOQUE]),
+      inicio(0), fin(0), velocidad(1.0), hayRegistro(false), largoRegistro(0), relojCaptura(0),
+      inicioDeSegmento(true), reproduciendo(false), lineas(0), bytesLeidos(0), retrasoMaximo(0) {
+#ifdef WINDOWS_BUILD
+    fd = _open(ruta, _O_RDONLY | _O_BINARY);
+#else
+    fd = open(ruta, O_RDONLY);
+#endif
+    if (fd < 0) {
+        std::cerr << "Error: No se pudo abrir la captura " << ruta
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    if (!asegurar(BYTES_CABECERA_SEGMENTO)
+        || std::memcmp(bloque, CABECERA_CAPTURA, LARGO_CABECERA_CAPTURA) != 0) {
+        std::cerr << "Error: " << ruta << " no es una captura de --grabar" << std::endl;
+        return;
+    }
+    conectado = true;
+}
+
+/**
+ * @brief Destructor - Cierra la captura y libera el bloque
+ */
+FuenteCaptura::~FuenteCaptura() {
+    cerrar();
+    delete[] bloque;
+}
+
+/**
+ * @brief Cambia la velocidad (0 o negativa = sin esperas)
+ */
+void FuenteCaptura::setVelocidad(double factor) {
+    velocidad = factor > 0.0 ? factor : 0.0;
+}
+
+/**
+ * @brief Compacta lo pendiente y lee hasta tener n bytes
+ */
+bool FuenteCaptura::asegurar(int n) {
+    while (fin - inicio < n) {
+        if (finDeArchivo || fd < 0) return false;
+
+        if (inicio > 0) {
+            std::memmove(bloque, bloque + inicio, fin - inicio);
+            fin -= inicio;
+            inicio = 0;
+        }
+        int leidos = static_cast<int>(read(fd, bloque + fin, TAMANIO_BLOQUE - fin));
+        if (leidos > 0) {
+            fin += leidos;
+        } else if (leidos < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (leidos < 0) {
+                std::cerr << "Error: Fallo la lectura de la captura (" << std::strerror(errno) << ")" << std::endl;
+            }
+            finDeArchivo = true;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta un varint LEB128 (a lo sumo 10 bytes)
+ */
+bool FuenteCaptura::leerVarint(unsigned long long* valor) {
+    unsigned long long resultado = 0;
+    for (int i = 0; i < 10; i++) {
+        if (!asegurar(i + 1)) return false;
+        unsigned char byte = bloque[inicio + i];
+        resultado |= static_cast<unsigned long long>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            inicio += i + 1;
+            *valor = resultado;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Termina la reproduccion con un aviso
+ */
+void FuenteCaptura::terminar(const char* motivo) {
+    std::cerr << "Aviso: captura danada tras " << lineas << " lineas (" << motivo
+              << "); se reproduce hasta ahi" << std::endl;
+    conectado = false;
+}
+
+/**
+ * @brief Deja en el bloque el siguiente registro completo
+ *
+ * El delta del primer registro de cada segmento se ignora: es lo que tardo
+ * en llegar la primera linea desde que se empezo a grabar.
+ */
+bool FuenteCaptura::siguienteRegistro() {
+    while (true) {
+        if (!asegurar(1)) {
+            // Fin limpio: el ultimo registro quedo completo
+            conectado = false;
+            return false;
+        }
+
+        if (bloque[inicio] == 0) {
+            if (!asegurar(BYTES_CABECERA_SEGMENTO)
+                || std::memcmp(bloque + inicio, CABECERA_CAPTURA, LARGO_CABECERA_CAPTURA) != 0) {
+                terminar("cabecera de segmento invalida");
+                return false;
+            }
+            if (bloque[inicio + LARGO_CABECERA_CAPTURA] != VERSION_CAPTURA) {
+                terminar("version de formato desconocida");
+                return false;
+            }
+            inicio += BYTES_CABECERA_SEGMENTO;
+            inicioDeSegmento = true;
+            continue;
+        }
+
+        unsigned long long largo;
+        unsigned long long delta;
+        if (!leerVarint(&largo) || !leerVarint(&delta)) {
+            terminar("registro incompleto");
+            return false;
+        }
+        largo--;
+        if (largo > static_cast<unsigned long long>(LINEA_CAPTURA_MAXIMA)) {
+            terminar("registro demasiado largo");
+            return false;
+        }
+        if (!asegurar(static_cast<int>(largo))) {
+            terminar("registro incompleto");
+            return false;
+        }
+
+        relojCaptura += inicioDeSegmento ? 0 : delta;
+        inicioDeSegmento = false;
+        if (largo == 0) continue;
+
+        hayRegistro = true;
+        largoRegistro = static_cast<int>(largo);
+        return true;
+    }
+}
+
+/**
+ * @brief Entrega la siguiente linea cuando llega su instante
+ */
+int FuenteCaptura::leerLinea(char* buffer, int bufferSize) {
+    if (bufferSize <= 0) return 0;
+    buffer[0] = '\0';
+    if (bufferSize == 1 || !conectado) return 0;
+
+    if (!hayRegistro && !siguienteRegistro()) {
+        return 0;
+    }
+
+    if (velocidad > 0.0) {
+        std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+        std::chrono::microseconds desdeOrigen(static_cast<long long>(relojCaptura / velocidad));
+        if (!reproduciendo) {
+            origen = ahora - desdeOrigen;
+            reproduciendo = true;
+        }
+
+        std::chrono::steady_clock::time_point objetivo = origen + desdeOrigen;
+        if (ahora < objetivo) {
+            // Dormir en tramos cortos: un silencio largo se ve como timeouts
+            std::chrono::steady_clock::time_point despertar = ahora + std::chrono::milliseconds(ESPERA_MAXIMA_MS);
+            std::this_thread::sleep_until(objetivo < despertar ? objetivo : despertar);
+            ahora = std::chrono::steady_clock::now();
+            if (ahora < objetivo) return 0;
+        }
+        unsigned long long retraso = static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::microseconds>(ahora - objetivo).count());
+        if (retraso > retrasoMaximo) retrasoMaximo = retraso;
+    }
+
+    // Una linea mas larga que el buffer sale en trozos, el resto sin esperar
+    int n = largoRegistro < bufferSize - 1 ? largoRegistro : bufferSize - 1;
+    std::memcpy(buffer, bloque + inicio, n);
+    buffer[n] = '\0';
+    inicio += n;
+    largoRegistro -= n;
+    bytesLeidos += static_cast<unsigned long long>(n);
+    if (largoRegistro == 0) {
+        hayRegistro = false;
+        lineas++;
+        bytesLeidos++;
+    }
+    return n;
+}
+
+/**
+ * @brief Indica si quedan lineas
+ */
+bool FuenteCaptura::estaConectado() const {
+    return conectado;
+}
+
+/**
+ * @brief Bytes entregados como si la captura fuera texto
+ */
+unsigned long long FuenteCaptura::getBytesLeidos() const {
+    return bytesLeidos;
+}
+
+/**
+ * @brief Cierra la captura
+ */
+void FuenteCaptura::cerrar() {
+    if (fd >= 0) {
+        close(fd);
+    }
+    fd = -1;
+    conectado = false;
+}
+
+/**
+ * @brief Lineas entregadas
+ */
+unsigned long long FuenteCaptura::getLineas() const {
+    return lineas;
+}
+
+/**
+ * @brief Mayor atraso al entregar (us)
+ */
+unsigned long long FuenteCaptura::getRetrasoMaximo() const {
+    return retrasoMaximo;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file FuenteDeTramas.cpp
+ * @brief Seleccion de la fuente de tramas desde la linea de comandos
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "FuenteDeTramas.h"
+#include "SerialPort.h"
+#include "FuenteArchivo.h"
+#include "FuenteMapeada.h"
+#include "FuenteCaptura.h"
+#include <cstring>
+
+/**
+ * @brief Verifica la sintaxis de la especificacion
+ */
+bool esFuenteValida(const char* especificacion) {
+    return std::strcmp(especificacion, "serial") == 0
+        || std::strcmp(especificacion, "stdin") == 0
+        || (std::strncmp(especificacion, "archivo:", 8) == 0 && especificacion[8] != '\0')
+        || (std::strncmp(especificacion, "mmap:", 5) == 0 && especificacion[5] != '\0')
+        || (std::strncmp(especificacion, "captura:", 8) == 0 && especificacion[8] != '\0');
+}
+
+/**
+ * @brief Crea la fuente indicada por la especificacion
+ */
+FuenteDeTramas* crearFuenteDeTramas(const char* especificacion, const char* puerto) {
+    if (std::strcmp(especificacion, "serial") == 0) {
+        return new SerialPort(puerto);
+    }
+    if (std::strcmp(especificacion, "stdin") == 0) {
+        return new FuenteArchivo(nullptr);
+    }
+    if (std::strncmp(especificacion, "archivo:", 8) == 0 && especificacion[8] != '\0') {
+        return new FuenteArchivo(especificacion + 8);
+    }
+    if (std::strncmp(especificacion, "mmap:", 5) == 0 && especificacion[5] != '\0') {
+        return new FuenteMapeada(especificacion + 5);
+    }
+    if (std::strncmp(especificacion, "captura:", 8) == 0 && especificacion[8] != '\0') {
+        return new FuenteCaptura(especificacion + 8);
+    }
+    return nullptr;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file FuenteGrabada.cpp
+ * @brief Implementacion de la fuente que graba lo que lee
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "FuenteGrabada.h"
+
+/**
+ * @brief Constructor - Toma la fuente y abre la captura
+ */
+FuenteGrabada::FuenteGrabada(FuenteDeTramas* interna, const char* ruta)
+    : interna(interna), grabador(ruta) {
+}
+
+/**
+ * @brief Destructor - Cierra la captura y libera la fuente interna
+ */
+FuenteGrabada::~FuenteGrabada() {
+    grabador.cerrar();
+    delete interna;
+}
+
+/**
+ * @brief Lee una linea y la agrega a la captura
+ *
+ * Un timeout del puerto (0 bytes) tambien sirve para escribir lo que lleva
+ * esperando mas de un segundo en el lote.
+ */
+int FuenteGrabada::leerLinea(char* buffer, int bufferSize) {
+    int n = interna->leerLinea(buffer, bufferSize);
+    if (n > 0) {
+        grabador.grabar(buffer, n, GrabadorDeCaptura::ahora());
+    } else {
+        grabador.vaciarSiVencido(GrabadorDeCaptura::ahora());
+    }
+    return n;
+}
+
+/**
+ * @brief Estado de la fuente interna
+ */
+bool FuenteGrabada::estaConectado() const {
+    return interna->estaConectado();
+}
+
+/**
+ * @brief Bytes de la fuente interna
+ */
+unsigned long long FuenteGrabada::getBytesLeidos() const {
+    return interna->getBytesLeidos();
+}
+
+/**
+ * @brief Reenvia la solicitud de modo binario
+ */
+bool FuenteGrabada::solicitarModoBinario() {
+    return interna->solicitarModoBinario();
+}
+
+/**
+ * @brief Reenvia la solicitud de marcas de tiempo
+ */
+bool FuenteGrabada::solicitarMarcasDeTiempo() {
+    return interna->solicitarMarcasDeTiempo();
+}
+
+/**
+ * @brief Cierra la fuente y escribe lo pendiente de la captura
+ */
+void FuenteGrabada::cerrar() {
+    interna->cerrar();
+    grabador.cerrar();
+}
+
+/**
+ * @brief Indica si se esta grabando
+ */
+bool FuenteGrabada::estaGrabando() const {
+    return grabador.estaAbierto();
+}
+
+/**
+ * @brief Lineas grabadas
+ */
+unsigned long long FuenteGrabada::getLineasGrabadas() const {
+    return grabador.getLineas();
+}
+
+/**
+ * @brief Bytes escritos en la captura
+ */
+unsigned long long FuenteGrabada::getBytesGrabados() const {
+    return grabador.getBytesEscritos();
+}
@@ -0,0 +1,206 @@
+/**
+ * @file FuenteMapeada.cpp
+ * @brief Implementacion de la lectura de capturas mapeadas en memoria
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "FuenteMapeada.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#ifndef WINDOWS_BUILD
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Constructor - Abre la captura y la mapea completa (solo lectura)
+ */
+FuenteMapeada::FuenteMapeada(const char* ruta)
+    : datos(nullptr), tamanio(0), posicion(0), abierto(false), conectado(false) {
+#ifdef WINDOWS_BUILD
+    hMapeo = nullptr;
+    hArchivo = CreateFileA(ruta, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hArchivo == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error: No se pudo abrir la captura " << ruta << std::endl;
+        return;
+    }
+
+    LARGE_INTEGER bytes;
+    if (!GetFileSizeEx(hArchivo, &bytes)) {
+        std::cerr << "Error: No se pudo obtener el tamanio de " << ruta << std::endl;
+        CloseHandle(hArchivo);
+        return;
+    }
+    tamanio = static_cast<unsigned long long>(bytes.QuadPart);
+
+    // Un archivo vacio no se puede mapear: se trata como captura sin lineas
+    if (tamanio > 0) {
+        hMapeo = CreateFileMappingA(hArchivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (hMapeo != nullptr) {
+            datos = static_cast<const char*>(MapViewOfFile(hMapeo, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (datos == nullptr) {
+            std::cerr << "Error: No se pudo mapear la captura " << ruta << std::endl;
+            if (hMapeo != nullptr) CloseHandle(hMapeo);
+            CloseHandle(hArchivo);
+            return;
+        }
+    }
+#else
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: No se pudo abrir la captura " << ruta
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        std::cerr << "Error: No se pudo obtener el tamanio de " << ruta << std::endl;
+        close(fd);
+        return;
+    }
+    tamanio = static_cast<unsigned long long>(info.st_size);
+
+    // Un archivo vacio no se puede mapear: se trata como captura sin lineas
+    if (tamanio > 0) {
+        void* mapeo = mmap(nullptr, tamanio, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapeo == MAP_FAILED) {
+            std::cerr << "Error: No se pudo mapear la captura " << ruta
+                      << " (" << std::strerror(errno) << ")" << std::endl;
+            close(fd);
+            return;
+        }
+        // El recorrido es secuencial: pedir lectura anticipada agresiva
+        madvise(mapeo, tamanio, MADV_SEQUENTIAL);
+        datos = static_cast<const char*>(mapeo);
+    }
+
+    // El mapeo sigue valido sin el descriptor
+    close(fd);
+#endif
+
+    abierto = true;
+    conectado = true;
+}
+
+/**
+ * @brief Destructor - Libera el mapeo
+ */
+FuenteMapeada::~FuenteMapeada() {
+    cerrar();
+}
+
+/**
+ * @brief Extrae una linea de un bloque de memoria
+ */
+int FuenteMapeada::extraerLinea(const char* datos, unsigned long long tamanio,
+                                unsigned long long* posicion, char* buffer, int bufferSize) {
+    unsigned long long restante = tamanio - *posicion;
+
+    // Limitar la busqueda al trozo maximo que cabe en el buffer
+    const char* origen = datos + *posicion;
+    unsigned long long limite = static_cast<unsigned long long>(bufferSize - 1);
+    unsigned long long busqueda = restante < limite + 1 ? restante : limite + 1;
+    const char* salto = static_cast<const char*>(std::memchr(origen, '\n', busqueda));
+
+    unsigned long long n;
+    unsigned long long separador;
+    if (salto) {
+        n = static_cast<unsigned long long>(salto - origen);
+        separador = 1;
+    } else {
+        // Linea mas larga que el buffer, o ultima linea sin '\n'
+        n = restante < limite ? restante : limite;
+        separador = 0;
+    }
+
+    int longitud = 0;
+    for (unsigned long long i = 0; i < n; i++) {
+        // Ignorar \r
+        if (origen[i] == '\r') {
+            continue;
+        }
+        buffer[longitud++] = origen[i];
+    }
+    buffer[longitud] = '\0';
+
+    *posicion += n + separador;
+    return longitud;
+}
+
+/**
+ * @brief Lee la siguiente linea de la captura
+ */
+int FuenteMapeada::leerLinea(char* buffer, int bufferSize) {
+    if (bufferSize <= 0) return 0;
+    buffer[0] = '\0';
+    if (bufferSize == 1 || !conectado) return 0;
+
+    if (posicion == tamanio) {
+        conectado = false;
+        return 0;
+    }
+
+    return extraerLinea(datos, tamanio, &posicion, buffer, bufferSize);
+}
+
+/**
+ * @brief Inicio de la captura
+ */
+const char* FuenteMapeada::getDatos() const {
+    return datos;
+}
+
+/**
+ * @brief Tamanio de la captura
+ */
+unsigned long long FuenteMapeada::getTamanio() const {
+    return tamanio;
+}
+
+/**
+ * @brief Marca bytes como consumidos
+ */
+void FuenteMapeada::setPosicion(unsigned long long nuevaPosicion) {
+    posicion = nuevaPosicion < tamanio ? nuevaPosicion : tamanio;
+}
+
+/**
+ * @brief Indica si quedan lineas
+ */
+bool FuenteMapeada::estaConectado() const {
+    return conectado;
+}
+
+/**
+ * @brief Bytes ya recorridos de la captura
+ */
+unsigned long long FuenteMapeada::getBytesLeidos() const {
+    return posicion;
+}
+
+/**
+ * @brief Libera el mapeo
+ */
+void FuenteMapeada::cerrar() {
+    if (!abierto) return;
+
+#ifdef WINDOWS_BUILD
+    if (datos != nullptr) UnmapViewOfFile(datos);
+    if (hMapeo != nullptr) CloseHandle(hMapeo);
+    CloseHandle(hArchivo);
+#else
+    if (datos != nullptr) munmap(const_cast<char*>(datos), tamanio);
+#endif
+
+    datos = nullptr;
+    abierto = false;
+    conectado = false;
+}
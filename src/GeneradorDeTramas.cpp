@@ -0,0 +1,169 @@
+/**
+ * @file GeneradorDeTramas.cpp
+ * @brief Implementacion del generador de trafico PRT-7 sintetico
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "GeneradorDeTramas.h"
+#include <cstdio>
+#include <cstring>
+
+/// Lineas del banner del ESP32 usadas como basura
+static const char* const LINEAS_BASURA[] = {
+    "========================================",
+    "  ESP32 - Transmisor Protocolo PRT-7   ",
+    "  Sistema de Telemetria Industrial     ",
+    "Iniciando transmision de tramas...",
+    "Velocidad: 115200 baudios",
+    ""
+};
+static const int NUM_LINEAS_BASURA = sizeof(LINEAS_BASURA) / sizeof(LINEAS_BASURA[0]);
+
+/**
+ * @brief Valores por defecto
+ */
+ConfiguracionTrafico::ConfiguracionTrafico()
+    : caracteres(1000000), porcentajeMap(10), rotacionMaxima(30), rafagaMaxima(1),
+      porcentajeBasura(0), semilla(1), conFin(true) {
+}
+
+/**
+ * @brief Constructor - Acota los parametros y reserva el mensaje esperado
+ */
+GeneradorDeTramas::GeneradorDeTramas(const ConfiguracionTrafico& config)
+    : configuracion(config), estado(config.semilla), longitudEsperada(0), terminado(false),
+      tramas(0), lineasBasura(0), bytes(0) {
+    if (configuracion.caracteres < 0) configuracion.caracteres = 0;
+    if (configuracion.rafagaMaxima < 1) configuracion.rafagaMaxima = 1;
+    if (configuracion.rafagaMaxima > RAFAGA_MAXIMA) configuracion.rafagaMaxima = RAFAGA_MAXIMA;
+    if (configuracion.rotacionMaxima < 0) configuracion.rotacionMaxima = -configuracion.rotacionMaxima;
+    if (configuracion.porcentajeMap > 99) configuracion.porcentajeMap = 99;
+    if (configuracion.porcentajeBasura > 99) configuracion.porcentajeBasura = 99;
+
+    capacidadEsperada = configuracion.caracteres + 1;
+    esperado = new char[capacidadEsperada];
+    esperado[0] = '\0';
+}
+
+/**
+ * @brief Destructor
+ */
+GeneradorDeTramas::~GeneradorDeTramas() {
+    delete[] esperado;
+}
+
+/**
+ * @brief Generador congruencial (mismos parametros que el resto de los benchmarks)
+ */
+unsigned int GeneradorDeTramas::azar() {
+    estado = estado * 1103515245u + 12345u;
+    return (estado >> 16) & 0x7FFF;
+}
+
+/**
+ * @brief Agrega caracteres al mensaje esperado
+ */
+void GeneradorDeTramas::agregarEsperado(const char* datos, int n) {
+    std::memcpy(esperado + longitudEsperada, datos, n);
+    longitudEsperada += n;
+    esperado[longitudEsperada] = '\0';
+}
+
+/**
+ * @brief Escribe la siguiente linea
+ */
+int GeneradorDeTramas::siguienteLinea(char* destino) {
+    if (terminado) return 0;
+
+    int n = 0;
+    if (configuracion.porcentajeBasura > 0
+        && static_cast<int>(azar() % 100) < configuracion.porcentajeBasura) {
+        // Texto del banner: parsearTrama() lo ignora
+        const char* basura = LINEAS_BASURA[azar() % NUM_LINEAS_BASURA];
+        n = static_cast<int>(std::strlen(basura));
+        std::memcpy(destino, basura, n);
+        lineasBasura++;
+    } else if (longitudEsperada == configuracion.caracteres) {
+        if (configuracion.conFin) {
+            std::memcpy(destino, "FIN", 3);
+            n = 3;
+            tramas++;
+        }
+        terminado = true;
+        if (n == 0) return 0;
+    } else if (configuracion.porcentajeMap > 0
+               && static_cast<int>(azar() % 100) < configuracion.porcentajeMap) {
+        int rango = 2 * configuracion.rotacionMaxima + 1;
+        int rotacion = static_cast<int>(((azar() << 15) | azar()) % static_cast<unsigned int>(rango))
+                       - configuracion.rotacionMaxima;
+        n = std::sprintf(destino, "M,%d", rotacion);
+
+        // Igual que RotorDeMapeo::rotar(), sin trazas
+        rotor.setDesplazamiento(rotor.getDesplazamiento() + rotacion % RotorDeMapeo::TAMANIO);
+        tramas++;
+    } else {
+        const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+        long long restantes = configuracion.caracteres - longitudEsperada;
+        int rafaga = 1 + static_cast<int>(azar() % static_cast<unsigned int>(configuracion.rafagaMaxima));
+        if (rafaga > restantes) rafaga = static_cast<int>(restantes);
+
+        destino[n++] = 'L';
+        destino[n++] = ',';
+        for (int i = 0; i < rafaga; i++) {
+            destino[n++] = alfabeto[azar() % 27];
+        }
+
+        char decodificado[RAFAGA_MAXIMA];
+        rotor.decodificarBloque(destino + 2, decodificado, rafaga);
+        agregarEsperado(decodificado, rafaga);
+        tramas++;
+    }
+
+    destino[n++] = '\r';
+    destino[n++] = '\n';
+    bytes += static_cast<unsigned long long>(n);
+    return n;
+}
+
+/**
+ * @brief Indica si ya se generaron todas las lineas
+ */
+bool GeneradorDeTramas::estaTerminado() const {
+    return terminado;
+}
+
+/**
+ * @brief Mensaje esperado
+ */
+const char* GeneradorDeTramas::getEsperado() const {
+    return esperado;
+}
+
+/**
+ * @brief Caracteres del mensaje esperado
+ */
+long long GeneradorDeTramas::getLongitudEsperada() const {
+    return longitudEsperada;
+}
+
+/**
+ * @brief Tramas generadas
+ */
+unsigned long long GeneradorDeTramas::getTramas() const {
+    return tramas;
+}
+
+/**
+ * @brief Lineas de banner generadas
+ */
+unsigned long long GeneradorDeTramas::getLineasBasura() const {
+    return lineasBasura;
+}
+
+/**
+ * @brief Bytes generados
+ */
+unsigned long long GeneradorDeTramas::getBytes() const {
+    return bytes;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file GrabadorDeCaptura.cpp
+ * @brief Implementacion de la grabacion de capturas binarias
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "GrabadorDeCaptura.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+
+#ifdef WINDOWS_BUILD
+#include <io.h>
+#include <sys/stat.h>
+#define write _write
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Escribe un entero como varint LEB128
+ * @return Bytes escritos (a lo sumo 10)
+ */
+static int escribirVarint(unsigned long long valor, unsigned char* destino) {
+    int n = 0;
+    while (valor >= 0x80) {
+        destino[n++] = static_cast<unsigned char>(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = static_cast<unsigned char>(valor);
+    return n;
+}
+
+/**
+ * @brief Constructor - Abre la captura en modo agregar y deja la cabecera en el lote
+ */
+GrabadorDeCaptura::GrabadorDeCaptura(const char* ruta)
+    : fd(-1), lote(new unsigned char[TAMANIO_LOTE]), usados(0), anterior(ahora()),
+      ultimoVaciado(anterior), lineas(0), bytesEscritos(0), fallo(false) {
+#ifdef WINDOWS_BUILD
+    fd = _open(ruta, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd = open(ruta, O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+    if (fd < 0) {
+        std::cerr << "Error: No se pudo abrir la captura " << ruta
+                  << " para grabar (" << std::strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    unsigned long long inicio = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::memcpy(lote, CABECERA_CAPTURA, LARGO_CABECERA_CAPTURA);
+    lote[LARGO_CABECERA_CAPTURA] = VERSION_CAPTURA;
+    for (int i = 0; i < 8; i++) {
+        lote[LARGO_CABECERA_CAPTURA + 1 + i] = static_cast<unsigned char>(inicio >> (8 * i));
+    }
+    usados = BYTES_CABECERA_SEGMENTO;
+}
+
+/**
+ * @brief Destructor - Escribe lo pendiente y libera el lote
+ */
+GrabadorDeCaptura::~GrabadorDeCaptura() {
+    cerrar();
+    delete[] lote;
+}
+
+/**
+ * @brief Reloj monotono en microsegundos
+ */
+unsigned long long GrabadorDeCaptura::ahora() {
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Escribe el lote con los write() que hagan falta
+ */
+bool GrabadorDeCaptura::escribirLote() {
+    int escritos = 0;
+    while (escritos < usados) {
+        int n = static_cast<int>(write(fd, lote + escritos, usados - escritos));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            std::cerr << "Error: Fallo la escritura de la captura (" << std::strerror(errno)
+                      << "); se deja de grabar" << std::endl;
+            fallo = true;
+            usados = 0;
+            return false;
+        }
+        escritos += n;
+    }
+    bytesEscritos += static_cast<unsigned long long>(usados);
+    usados = 0;
+    return true;
+}
+
+/**
+ * @brief Agrega un registro al lote (y escribe el lote si ya no cabe)
+ */
+void GrabadorDeCaptura::grabar(const char* linea, int largo, unsigned long long instante) {
+    if (fd < 0 || fallo) return;
+    if (largo > LINEA_CAPTURA_MAXIMA) largo = LINEA_CAPTURA_MAXIMA;
+
+    // Un registro nunca queda partido entre dos write()
+    if (usados + largo + 20 > TAMANIO_LOTE || instante - ultimoVaciado > INTERVALO_VACIADO_US) {
+        if (usados > 0 && !escribirLote()) return;
+        ultimoVaciado = instante;
+    }
+
+    usados += escribirVarint(static_cast<unsigned long long>(largo) + 1, lote + usados);
+    usados += escribirVarint(instante - anterior, lote + usados);
+    std::memcpy(lote + usados, linea, largo);
+    usados += largo;
+    anterior = instante;
+    lineas++;
+}
+
+/**
+ * @brief Escribe lo pendiente si ya es viejo (lo llama la fuente en cada timeout)
+ */
+void GrabadorDeCaptura::vaciarSiVencido(unsigned long long instante) {
+    if (fd < 0 || fallo || usados == 0) return;
+    if (instante - ultimoVaciado > INTERVALO_VACIADO_US) {
+        escribirLote();
+        ultimoVaciado = instante;
+    }
+}
+
+/**
+ * @brief Escribe lo pendiente y cierra
+ */
+void GrabadorDeCaptura::cerrar() {
+    if (fd < 0) return;
+    if (usados > 0 && !fallo) {
+        escribirLote();
+    }
+    close(fd);
+    fd = -1;
+}
+
+/**
+ * @brief Indica si se puede grabar
+ */
+bool GrabadorDeCaptura::estaAbierto() const {
+    return fd >= 0 && !fallo;
+}
+
+/**
+ * @brief Registros grabados
+ */
+unsigned long long GrabadorDeCaptura::getLineas() const {
+    return lineas;
+}
+
+/**
+ * @brief Bytes escritos en el archivo
+ */
+unsigned long long GrabadorDeCaptura::getBytesEscritos() const {
+    return bytesEscritos;
+}
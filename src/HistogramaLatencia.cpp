@@ -0,0 +1,113 @@
+/**
+ * @file HistogramaLatencia.cpp
+ * @brief Implementacion del histograma log-lineal
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "HistogramaLatencia.h"
+#include <cstring>
+
+/**
+ * @brief Posicion del bit mas significativo (valor distinto de 0)
+ */
+static int bitMasAlto(unsigned long long valor) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(valor);
+#else
+    int bit = 0;
+    while (valor >>= 1) bit++;
+    return bit;
+#endif
+}
+
+/**
+ * @brief Constructor - Todas las cubetas en cero
+ */
+HistogramaLatencia::HistogramaLatencia() {
+    reiniciar();
+}
+
+/**
+ * @brief Cuenta un valor
+ */
+void HistogramaLatencia::registrar(unsigned long long valor) {
+    cubetas[indiceCubeta(valor)]++;
+    muestras++;
+    if (valor > maximo) maximo = valor;
+}
+
+/**
+ * @brief Vacia el histograma
+ */
+void HistogramaLatencia::reiniciar() {
+    std::memset(cubetas, 0, sizeof(cubetas));
+    muestras = 0;
+    maximo = 0;
+}
+
+/**
+ * @brief Percentil por recorrido acumulado de las cubetas
+ */
+unsigned long long HistogramaLatencia::percentil(double fraccion) const {
+    if (muestras == 0) return 0;
+    if (fraccion >= 1.0) return maximo;
+
+    // Rango de la muestra buscada (1..muestras)
+    unsigned long long rango = static_cast<unsigned long long>(fraccion * muestras);
+    if (static_cast<double>(rango) < fraccion * muestras) rango++;
+    if (rango == 0) rango = 1;
+
+    unsigned long long acumulado = 0;
+    for (int i = 0; i < NUM_CUBETAS; i++) {
+        acumulado += cubetas[i];
+        if (acumulado >= rango) {
+            unsigned long long limite = limiteSuperior(i);
+            return limite < maximo ? limite : maximo;
+        }
+    }
+    return maximo;
+}
+
+/**
+ * @brief Valores registrados
+ */
+unsigned long long HistogramaLatencia::getMuestras() const {
+    return muestras;
+}
+
+/**
+ * @brief Mayor valor registrado
+ */
+unsigned long long HistogramaLatencia::getMaximo() const {
+    return maximo;
+}
+
+/**
+ * @brief Cubeta de un valor
+ *
+ * Con el bit mas alto en la posicion b >= BITS_SUBCUBETA, los
+ * BITS_SUBCUBETA bits siguientes eligen la subcubeta dentro del grupo
+ * b - BITS_SUBCUBETA + 1; el grupo 0 son los valores exactos 0..SUBCUBETAS-1.
+ */
+int HistogramaLatencia::indiceCubeta(unsigned long long valor) {
+    if (valor < static_cast<unsigned long long>(SUBCUBETAS)) {
+        return static_cast<int>(valor);
+    }
+    int desplazamiento = bitMasAlto(valor) - BITS_SUBCUBETA;
+    int sub = static_cast<int>((valor >> desplazamiento) & (SUBCUBETAS - 1));
+    return (desplazamiento + 1) * SUBCUBETAS + sub;
+}
+
+/**
+ * @brief Mayor valor que cae en una cubeta
+ */
+unsigned long long HistogramaLatencia::limiteSuperior(int indice) {
+    if (indice < SUBCUBETAS) {
+        return static_cast<unsigned long long>(indice);
+    }
+    int desplazamiento = indice / SUBCUBETAS - 1;
+    unsigned long long sub = static_cast<unsigned long long>(indice % SUBCUBETAS);
+    unsigned long long inferior = (static_cast<unsigned long long>(SUBCUBETAS) + sub) << desplazamiento;
+    return inferior + ((1ULL << desplazamiento) - 1);
+}
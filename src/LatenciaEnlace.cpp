@@ -0,0 +1,163 @@
+/**
+ * @file LatenciaEnlace.cpp
+ * @brief Implementacion de la latencia de extremo a extremo
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "LatenciaEnlace.h"
+#include "HistogramaLatencia.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+/**
+ * @brief Constructor - Reserva las muestras
+ */
+LatenciaEnlace::LatenciaEnlace(int baudios, int capacidad)
+    : capacidad(capacidad > 0 ? capacidad : CAPACIDAD_POR_DEFECTO), baudios(baudios), usadas(0), perdidas(0),
+      ultimaMarca(0), relojEmisor(0) {
+    muestras = new MuestraEnlace[this->capacidad];
+}
+
+/**
+ * @brief Destructor
+ */
+LatenciaEnlace::~LatenciaEnlace() {
+    delete[] muestras;
+}
+
+/**
+ * @brief Reloj del host en nanosegundos
+ */
+unsigned long long LatenciaEnlace::ahora() {
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Guarda una trama con marca
+ *
+ * La resta en 32 bits avanza bien el reloj del emisor aunque micros() haya
+ * dado la vuelta entre dos tramas (basta con que lleguen menos de ~71 min
+ * separadas).
+ */
+void LatenciaEnlace::registrar(unsigned int marca, int bytes, unsigned long long recepcion,
+                               unsigned long long insercion) {
+    if (usadas == 0 && perdidas == 0) {
+        relojEmisor = marca;
+    } else {
+        relojEmisor += static_cast<unsigned int>(marca - ultimaMarca);
+    }
+    ultimaMarca = marca;
+
+    if (usadas == capacidad) {
+        perdidas++;
+        return;
+    }
+    MuestraEnlace& muestra = muestras[usadas++];
+    muestra.emision = relojEmisor;
+    muestra.recepcion = recepcion;
+    muestra.insercion = insercion;
+    muestra.bytes = bytes + 2;
+}
+
+/**
+ * @brief Tramas con marca registradas
+ */
+int LatenciaEnlace::getMuestras() const {
+    return usadas;
+}
+
+/**
+ * @brief Imprime el reporte
+ *
+ * Todo se lleva a nanosegundos relativos a la primera muestra: d = recepcion
+ * - emision es la latencia mas un desfase que cambia lento con la deriva.
+ * La base de cada mitad es min(d - transmision); la recta por esas dos
+ * bases se resta a cada d.
+ */
+void LatenciaEnlace::imprimir() const {
+    if (usadas == 0) {
+        std::cerr << "Latencia del enlace: ninguna trama con marca de tiempo "
+                  << "(firmware sin " SOLICITUD_MARCAS " o modo binario)" << std::endl;
+        return;
+    }
+
+    const double NS_POR_BYTE = baudios > 0 ? 10.0 * 1e9 / baudios : 0.0;
+    const MuestraEnlace& primera = muestras[0];
+
+    // Menor d - transmision de cada mitad: (instante del emisor, base)
+    double instante[2] = {0.0, 0.0};
+    double base[2] = {0.0, 0.0};
+    int mitad = usadas / 2 > 0 ? usadas / 2 : usadas;
+    for (int parte = 0; parte < 2; parte++) {
+        int desde = parte == 0 ? 0 : mitad;
+        int hasta = parte == 0 ? mitad : usadas;
+        if (desde == hasta) {
+            instante[parte] = instante[0];
+            base[parte] = base[0];
+            continue;
+        }
+        for (int i = desde; i < hasta; i++) {
+            double emision = static_cast<double>(muestras[i].emision - primera.emision) * 1000.0;
+            double d = static_cast<double>(muestras[i].recepcion - primera.recepcion) - emision
+                       - muestras[i].bytes * NS_POR_BYTE;
+            if (i == desde || d < base[parte]) {
+                instante[parte] = emision;
+                base[parte] = d;
+            }
+        }
+    }
+    double deriva = instante[1] > instante[0] ? (base[1] - base[0]) / (instante[1] - instante[0]) : 0.0;
+
+    HistogramaLatencia recepcion;
+    HistogramaLatencia insercion;
+    double fluctuacion = 0.0;
+    double anterior = 0.0;
+    for (int i = 0; i < usadas; i++) {
+        double emision = static_cast<double>(muestras[i].emision - primera.emision) * 1000.0;
+        double desfase = base[0] + deriva * (emision - instante[0]);
+
+        double latencia = static_cast<double>(muestras[i].recepcion - primera.recepcion) - emision - desfase;
+        if (latencia < 0.0) latencia = 0.0;
+        recepcion.registrar(static_cast<unsigned long long>(latencia));
+
+        if (muestras[i].insercion != 0) {
+            double hastaLista = static_cast<double>(muestras[i].insercion - primera.recepcion) - emision - desfase;
+            insercion.registrar(static_cast<unsigned long long>(hastaLista > 0.0 ? hastaLista : 0.0));
+        }
+
+        // RFC 3550: J += (|D| - J) / 16
+        if (i > 0) {
+            double diferencia = latencia > anterior ? latencia - anterior : anterior - latencia;
+            fluctuacion += (diferencia - fluctuacion) / 16.0;
+        }
+        anterior = latencia;
+    }
+
+    const double fracciones[3] = {0.5, 0.99, 0.999};
+    const char* nombres[2] = {"recepcion", "insercion"};
+    const HistogramaLatencia* histogramas[2] = {&recepcion, &insercion};
+
+    std::ios::fmtflags formato = std::cerr.flags();
+    std::streamsize precision = std::cerr.precision();
+    std::cerr << std::fixed << std::setprecision(1)
+              << "Latencia del enlace (us desde el println del ESP32, " << usadas << " tramas con marca, deriva "
+              << deriva * 1e6 << " ppm):" << std::endl;
+    std::cerr << "  hasta             muestras         p50         p99        p999         max" << std::endl;
+    for (int h = 0; h < 2; h++) {
+        std::cerr << "  " << std::left << std::setw(15) << nombres[h] << std::right
+                  << std::setw(11) << histogramas[h]->getMuestras();
+        for (int p = 0; p < 3; p++) {
+            std::cerr << std::setw(12) << histogramas[h]->percentil(fracciones[p]) / 1000;
+        }
+        std::cerr << std::setw(12) << histogramas[h]->getMaximo() / 1000 << std::endl;
+    }
+    std::cerr << "  Fluctuacion (RFC 3550): " << fluctuacion / 1000.0 << " us" << std::endl;
+    if (perdidas > 0) {
+        std::cerr << "  (" << perdidas << " tramas con marca sin guardar: capacidad " << capacidad << ")" << std::endl;
+    }
+    std::cerr.flags(formato);
+    std::cerr.precision(precision);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file LatenciaPorEtapa.cpp
+ * @brief Implementacion de los histogramas de latencia por etapa
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "LatenciaPorEtapa.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+
+unsigned int periodoMuestreoLatencia = 0;
+unsigned int cuentaMuestreoLatencia = 0;
+bool muestraLatenciaEnCurso = false;
+
+static HistogramaLatencia histogramas[NUM_ETAPAS_LATENCIA];   ///< Un histograma por etapa, en ticks
+static unsigned long long ticksInicio = 0;                    ///< marcaLatencia() al habilitar
+static std::chrono::steady_clock::time_point relojInicio;    ///< steady_clock al habilitar
+
+static const char* const NOMBRES_ETAPA[NUM_ETAPAS_LATENCIA] = {
+    "lectura", "parseo", "decodificacion", "insercion"
+};
+
+/**
+ * @brief Empieza a medir
+ */
+void habilitarLatencias(unsigned int periodo) {
+    periodoMuestreoLatencia = periodo;
+    cuentaMuestreoLatencia = 0;
+    ticksInicio = marcaLatencia();
+    relojInicio = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Indica si se estan midiendo latencias
+ */
+bool latenciasHabilitadas() {
+    return periodoMuestreoLatencia != 0;
+}
+
+/**
+ * @brief Registra el tiempo de una etapa
+ */
+void registrarLatencia(EtapaLatencia etapa, unsigned long long desde, unsigned long long hasta) {
+    // Un contador de ciclos que retrocede (cambio de nucleo) cuenta como 0
+    histogramas[etapa].registrar(hasta > desde ? hasta - desde : 0);
+}
+
+/**
+ * @brief Histograma de una etapa
+ */
+const HistogramaLatencia& obtenerHistogramaLatencia(EtapaLatencia etapa) {
+    return histogramas[etapa];
+}
+
+/**
+ * @brief Nanosegundos por tick de marcaLatencia()
+ *
+ * Con rdtsc se calibra contra steady_clock desde habilitarLatencias(); si
+ * paso muy poco tiempo se espera un momento para que el cociente sea estable.
+ */
+static double nanosegundosPorTick() {
+#ifdef LATENCIA_CON_RDTSC
+    double nanosegundos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - relojInicio).count();
+    if (nanosegundos < 20e6) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    unsigned long long ticks = marcaLatencia() - ticksInicio;
+    nanosegundos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - relojInicio).count();
+    return ticks > 0 ? nanosegundos / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+/**
+ * @brief Imprime los percentiles de cada etapa
+ */
+void imprimirLatencias() {
+    double escala = nanosegundosPorTick();
+    const double fracciones[3] = {0.5, 0.99, 0.999};
+
+    std::ios::fmtflags formato = std::cerr.flags();
+    std::cerr << "Latencias por etapa (ns, una trama de cada " << periodoMuestreoLatencia << "):" << std::endl;
+    std::cerr << "  etapa             muestras         p50         p99        p999         max" << std::endl;
+    for (int e = 0; e < NUM_ETAPAS_LATENCIA; e++) {
+        const HistogramaLatencia& h = histogramas[e];
+        std::cerr << "  " << std::left << std::setw(15) << NOMBRES_ETAPA[e] << std::right
+                  << std::setw(11) << h.getMuestras();
+        for (int p = 0; p < 3; p++) {
+            std::cerr << std::setw(12) << static_cast<unsigned long long>(h.percentil(fracciones[p]) * escala);
+        }
+        std::cerr << std::setw(12) << static_cast<unsigned long long>(h.getMaximo() * escala) << std::endl;
+    }
+    std::cerr.flags(formato);
+}
@@ -6,7 +6,10 @@
  */
 
 #include "ListaDeCarga.h"
+#include "NivelDetalle.h"
+#include "RegistroAsincrono.h"
 #include <iostream>
+#include <cstring>
 
 /**
  * @brief Constructor - Inicializa lista vacia
@@ -17,45 +20,115 @@ ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
 
 /**
  * @brief Destructor - Libera toda la memoria
+ *
+ * Los bloques pertenecen al pool, que libera sus losas al destruirse.
  */
 ListaDeCarga::~ListaDeCarga() {
-    NodoCarga* actual = cabeza;
-    
-    while (actual) {
-        NodoCarga* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    }
-    
     cabeza = nullptr;
     cola = nullptr;
     tamanio = 0;
 }
 
 /**
- * @brief Inserta un caracter al final de la lista
+ * @brief Agrega un bloque vacio al final de la lista
  */
-void ListaDeCarga::insertarAlFinal(char dato) {
-    // Crear nuevo nodo
-    NodoCarga* nuevo = new NodoCarga(dato);
-    
-    if (estaVacia()) {
-        // Primer nodo: cabeza y cola apuntan al mismo nodo
+void ListaDeCarga::agregarBloque() {
+    BloqueCarga* nuevo = pool.obtener();
+
+    if (!cola) {
+        // Primer bloque: cabeza y cola apuntan al mismo bloque
         cabeza = nuevo;
         cola = nuevo;
     } else {
-        // Insertar al final
+        // Enlazar al final
         cola->siguiente = nuevo;
         nuevo->previo = cola;
         cola = nuevo;
     }
-    
+}
+
+/**
+ * @brief Inserta un caracter al final de la lista
+ */
+void ListaDeCarga::insertarAlFinal(char dato) {
+    // Solo se necesita un bloque nuevo cuando el de la cola esta lleno
+    if (!cola || cola->usados == BloqueCarga::CAPACIDAD) {
+        agregarBloque();
+    }
+
+    cola->datos[cola->usados++] = dato;
     tamanio++;
-    
-    // Debug: mostrar el caracter agregado
-    std::cout << "Fragmento '" << dato << "' decodificado como '" << dato << "'. ";
-    std::cout << "Mensaje: ";
-    imprimirMensajeEnLinea();
+
+    // Debug: mostrar el caracter agregado segun el nivel de detalle
+    NivelDetalle nivel = obtenerNivelDetalle();
+    if (nivel == DETALLE_TRAMA) {
+        Registro(REGISTRO_TRAZA) << "Fragmento '" << dato << "' decodificado como '" << dato << "'. ";
+        imprimirFragmento(&dato, 1);
+    } else if (nivel == DETALLE_DEMO) {
+        Registro(REGISTRO_TRAZA) << "Fragmento '" << dato << "' decodificado como '" << dato << "'. Mensaje: ";
+        imprimirMensajeEnLinea();
+    }
+}
+
+/**
+ * @brief Inserta varios caracteres al final de la lista
+ */
+void ListaDeCarga::insertarBloque(const char* datos, int n) {
+    insertarBloqueSinEco(datos, n);
+
+    if (obtenerNivelDetalle() >= DETALLE_TRAMA) {
+        imprimirFragmento(datos, n);
+    }
+}
+
+/**
+ * @brief Inserta varios caracteres sin eco
+ *
+ * Copia por tramos hasta llenar cada bloque de la cola.
+ */
+void ListaDeCarga::insertarBloqueSinEco(const char* datos, int n) {
+    while (n > 0) {
+        if (!cola || cola->usados == BloqueCarga::CAPACIDAD) {
+            agregarBloque();
+        }
+
+        int libres = BloqueCarga::CAPACIDAD - cola->usados;
+        int tramo = n < libres ? n : libres;
+
+        std::memcpy(cola->datos + cola->usados, datos, tramo);
+        cola->usados += tramo;
+        tamanio += tramo;
+
+        datos += tramo;
+        n -= tramo;
+    }
+}
+
+/**
+ * @brief Reserva los bloques necesarios para N caracteres mas
+ */
+void ListaDeCarga::reservar(long long caracteres) {
+    int libresEnCola = cola ? BloqueCarga::CAPACIDAD - cola->usados : 0;
+    long long faltantes = caracteres - libresEnCola;
+    if (faltantes <= 0) return;
+
+    pool.reservar(static_cast<int>((faltantes + BloqueCarga::CAPACIDAD - 1) / BloqueCarga::CAPACIDAD));
+}
+
+/**
+ * @brief Devuelve todos los bloques al pool
+ */
+void ListaDeCarga::vaciar() {
+    BloqueCarga* actual = cabeza;
+    while (actual) {
+        BloqueCarga* siguiente = actual->siguiente;
+        pool.devolver(actual);
+        actual = siguiente;
+    }
+
+    cabeza = nullptr;
+    cola = nullptr;
+    tamanio = 0;
 }
 
 /**
@@ -66,42 +139,62 @@ void ListaDeCarga::imprimirMensaje() {
         std::cout << "(mensaje vacio)" << std::endl;
         return;
     }
-    
-    std::cout << std::endl;
-    std::cout << "========================================" << std::endl;
-    std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
-    
-    NodoCarga* actual = cabeza;
+
+    // En modo silencioso solo se imprime el mensaje, sin marco
+    bool conMarco = obtenerNivelDetalle() != DETALLE_SILENCIOSO;
+
+    if (conMarco) {
+        std::cout << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << "MENSAJE OCULTO ENSAMBLADO:" << std::endl;
+    }
+
+    BloqueCarga* actual = cabeza;
     while (actual) {
-        std::cout << actual->dato;
+        std::cout.write(actual->datos, actual->usados);
         actual = actual->siguiente;
     }
-    
+
     std::cout << std::endl;
-    std::cout << "========================================" << std::endl;
+    if (conMarco) {
+        std::cout << "========================================" << std::endl;
+    }
 }
 
 /**
  * @brief Imprime el mensaje en una linea (para debug incremental)
- * 
+ *
  * Metodo auxiliar para mostrar el progreso del mensaje mientras se decodifica.
  */
 void ListaDeCarga::imprimirMensajeEnLinea() {
-    std::cout << "[";
-    
-    NodoCarga* actual = cabeza;
+    Registro traza(REGISTRO_TRAZA);
+    traza << "[";
+
+    BloqueCarga* actual = cabeza;
     while (actual) {
-        std::cout << actual->dato;
+        traza.escribir(actual->datos, actual->usados);
         actual = actual->siguiente;
     }
-    
-    std::cout << "]" << std::endl;
+
+    traza << "]\n";
+}
+
+/**
+ * @brief Imprime solo lo recien agregado y la longitud acumulada
+ *
+ * Cuesta O(fragmento) en lugar de O(mensaje), asi el eco por trama es lineal.
+ */
+void ListaDeCarga::imprimirFragmento(const char* fragmento, int n) {
+    Registro traza(REGISTRO_TRAZA);
+    traza << "Mensaje: +[";
+    traza.escribir(fragmento, n);
+    traza << "] (longitud " << tamanio << ")\n";
 }
 
 /**
  * @brief Obtiene el tamanio de la lista
  */
-int ListaDeCarga::getTamanio() const {
+long long ListaDeCarga::getTamanio() const {
     return tamanio;
 }
 
@@ -109,5 +202,64 @@ int ListaDeCarga::getTamanio() const {
  * @brief Verifica si la lista esta vacia
  */
 bool ListaDeCarga::estaVacia() const {
-    return cabeza == nullptr;
+    return tamanio == 0;
+}
+
+/**
+ * @brief Copia el mensaje a un buffer
+ */
+int ListaDeCarga::copiarMensaje(char* destino, int capacidad) const {
+    if (capacidad <= 0) return 0;
+
+    int copiados = 0;
+    BloqueCarga* actual = cabeza;
+    while (actual && copiados < capacidad - 1) {
+        int tramo = actual->usados;
+        if (tramo > capacidad - 1 - copiados) tramo = capacidad - 1 - copiados;
+
+        std::memcpy(destino + copiados, actual->datos, tramo);
+        copiados += tramo;
+        actual = actual->siguiente;
+    }
+
+    destino[copiados] = '\0';
+    return copiados;
+}
+
+/**
+ * @brief Copia n caracteres desde la posicion indicada
+ *
+ * Busca el bloque de inicio desde la cola hacia atras: lo que se copia
+ * suele ser lo ultimo que se agrego.
+ */
+int ListaDeCarga::copiarTramo(long long desde, char* destino, int n) const {
+    if (desde < 0 || desde >= tamanio || n <= 0) return 0;
+    if (n > tamanio - desde) n = static_cast<int>(tamanio - desde);
+
+    BloqueCarga* actual = cola;
+    long long inicioBloque = tamanio - cola->usados;
+    while (inicioBloque > desde) {
+        actual = actual->previo;
+        inicioBloque -= actual->usados;
+    }
+
+    int copiados = 0;
+    int desplazamiento = static_cast<int>(desde - inicioBloque);
+    while (copiados < n) {
+        int tramo = actual->usados - desplazamiento;
+        if (tramo > n - copiados) tramo = n - copiados;
+
+        std::memcpy(destino + copiados, actual->datos + desplazamiento, tramo);
+        copiados += tramo;
+        desplazamiento = 0;
+        actual = actual->siguiente;
+    }
+    return copiados;
+}
+
+/**
+ * @brief Memoria pedida al sistema para el mensaje
+ */
+long long ListaDeCarga::getBytesReservados() const {
+    return pool.getBytesReservados();
 }
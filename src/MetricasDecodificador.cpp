@@ -0,0 +1,69 @@
+/**
+ * @file MetricasDecodificador.cpp
+ * @brief Implementacion de las metricas del decodificador
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "MetricasDecodificador.h"
+#include <cstdio>
+
+MetricasDecodificador metricas;
+
+/**
+ * @brief Constructor - Todo en cero
+ */
+MetricasDecodificador::MetricasDecodificador()
+    : lineasCortas(0), lineasDesconocidas(0), lineasIgnoradas(0), timeoutsLectura(0),
+      bytesLeidos(0), longitudMensaje(0), desplazamientoRotor(0) {
+    for (int i = 0; i < NUM_TIPOS; i++) {
+        tramas[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Escribe una instantanea en formato Prometheus
+ *
+ * Cada familia lleva su HELP y TYPE; los nombres siguen las convenciones de
+ * Prometheus (sufijo _total en los contadores).
+ */
+int MetricasDecodificador::escribirTexto(char* destino, int capacidad) const {
+    unsigned long long load = tramas[TRAMA_LOAD].load(std::memory_order_relaxed);
+    unsigned long long map = tramas[TRAMA_MAP].load(std::memory_order_relaxed);
+    unsigned long long fin = tramas[TRAMA_FIN].load(std::memory_order_relaxed);
+
+    int n = std::snprintf(destino, static_cast<size_t>(capacidad),
+        "# HELP prt7_tramas_total Tramas validas decodificadas por tipo.\n"
+        "# TYPE prt7_tramas_total counter\n"
+        "prt7_tramas_total{tipo=\"load\"} %llu\n"
+        "prt7_tramas_total{tipo=\"map\"} %llu\n"
+        "prt7_tramas_total{tipo=\"fin\"} %llu\n"
+        "# HELP prt7_lineas_rechazadas_total Lineas que parsearTrama no acepto.\n"
+        "# TYPE prt7_lineas_rechazadas_total counter\n"
+        "prt7_lineas_rechazadas_total{motivo=\"corta\"} %llu\n"
+        "prt7_lineas_rechazadas_total{motivo=\"desconocida\"} %llu\n"
+        "prt7_lineas_rechazadas_total{motivo=\"ignorada\"} %llu\n"
+        "# HELP prt7_timeouts_lectura_total Lecturas del puerto que vencieron sin una linea completa.\n"
+        "# TYPE prt7_timeouts_lectura_total counter\n"
+        "prt7_timeouts_lectura_total %llu\n"
+        "# HELP prt7_bytes_leidos_total Bytes leidos de la fuente.\n"
+        "# TYPE prt7_bytes_leidos_total counter\n"
+        "prt7_bytes_leidos_total %llu\n"
+        "# HELP prt7_longitud_mensaje Caracteres del mensaje decodificado.\n"
+        "# TYPE prt7_longitud_mensaje gauge\n"
+        "prt7_longitud_mensaje %lld\n"
+        "# HELP prt7_desplazamiento_rotor Posicion de la cabeza del rotor (0-26).\n"
+        "# TYPE prt7_desplazamiento_rotor gauge\n"
+        "prt7_desplazamiento_rotor %d\n",
+        load, map, fin,
+        lineasCortas.load(std::memory_order_relaxed),
+        lineasDesconocidas.load(std::memory_order_relaxed),
+        lineasIgnoradas.load(std::memory_order_relaxed),
+        timeoutsLectura.load(std::memory_order_relaxed),
+        bytesLeidos.load(std::memory_order_relaxed),
+        longitudMensaje.load(std::memory_order_relaxed),
+        desplazamientoRotor.load(std::memory_order_relaxed));
+
+    if (n < 0) return 0;
+    return n < capacidad ? n : capacidad - 1;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file NivelDetalle.cpp
+ * @brief Implementacion del nivel de detalle global
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "NivelDetalle.h"
+#include <cstring>
+
+static NivelDetalle nivelActual = DETALLE_TRAMA;  ///< Nivel elegido al arrancar
+static bool rotacionDiferida = false;             ///< Trazas de MAP agrupadas
+static bool sesionesMultiplexadas = false;        ///< Prefijo "#<id>," reconocido
+static bool marcasDeTiempo = false;               ///< Prefijo "@<us>," reconocido
+
+/**
+ * @brief Establece el nivel de detalle global
+ */
+void establecerNivelDetalle(NivelDetalle nivel) {
+    nivelActual = nivel;
+}
+
+/**
+ * @brief Obtiene el nivel de detalle global
+ */
+NivelDetalle obtenerNivelDetalle() {
+    return nivelActual;
+}
+
+/**
+ * @brief Agrupa las trazas de MAP seguidas
+ */
+void establecerRotacionDiferida(bool diferida) {
+    rotacionDiferida = diferida;
+}
+
+/**
+ * @brief Indica si las trazas de MAP se agrupan
+ */
+bool obtenerRotacionDiferida() {
+    return rotacionDiferida;
+}
+
+/**
+ * @brief Reconoce el prefijo de sesion
+ */
+void establecerSesionesMultiplexadas(bool activas) {
+    sesionesMultiplexadas = activas;
+}
+
+/**
+ * @brief Indica si se reconoce el prefijo de sesion
+ */
+bool obtenerSesionesMultiplexadas() {
+    return sesionesMultiplexadas;
+}
+
+/**
+ * @brief Reconoce la marca de tiempo
+ */
+void establecerMarcasDeTiempo(bool activas) {
+    marcasDeTiempo = activas;
+}
+
+/**
+ * @brief Indica si se reconoce la marca de tiempo
+ */
+bool obtenerMarcasDeTiempo() {
+    return marcasDeTiempo;
+}
+
+/**
+ * @brief Convierte un nombre en nivel de detalle
+ */
+bool parsearNivelDetalle(const char* texto, NivelDetalle* nivel) {
+    if (std::strcmp(texto, "silencioso") == 0) {
+        *nivel = DETALLE_SILENCIOSO;
+    } else if (std::strcmp(texto, "resumen") == 0) {
+        *nivel = DETALLE_RESUMEN;
+    } else if (std::strcmp(texto, "trama") == 0) {
+        *nivel = DETALLE_TRAMA;
+    } else if (std::strcmp(texto, "demo") == 0) {
+        *nivel = DETALLE_DEMO;
+    } else {
+        return false;
+    }
+    return true;
+}
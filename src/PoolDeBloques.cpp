@@ -0,0 +1,128 @@
+/**
+ * @file PoolDeBloques.cpp
+ * @brief Implementacion del PoolDeBloques
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "PoolDeBloques.h"
+
+/**
+ * @brief Constructor - Pool vacio
+ */
+PoolDeBloques::PoolDeBloques()
+    : losas(nullptr), siguienteLibre(0), listaLibre(nullptr), bloquesLibres(0),
+      bytesReservados(0) {
+}
+
+/**
+ * @brief Destructor - Libera cada losa con un solo delete[]
+ */
+PoolDeBloques::~PoolDeBloques() {
+    Losa* actual = losas;
+
+    while (actual) {
+        Losa* siguiente = actual->siguiente;
+        delete[] actual->bloques;
+        delete actual;
+        actual = siguiente;
+    }
+
+    losas = nullptr;
+    listaLibre = nullptr;
+}
+
+/**
+ * @brief Pide una nueva losa, del doble de tamanio que la anterior
+ */
+void PoolDeBloques::agregarLosa() {
+    int cantidad = LOSA_INICIAL;
+    if (losas) {
+        cantidad = losas->cantidad * 2;
+        if (cantidad > LOSA_MAXIMA) cantidad = LOSA_MAXIMA;
+    }
+
+    Losa* nueva = new Losa;
+    nueva->bloques = new BloqueCarga[cantidad];
+    nueva->cantidad = cantidad;
+    nueva->siguiente = losas;
+
+    losas = nueva;
+    siguienteLibre = 0;
+    bytesReservados += static_cast<long long>(cantidad) * sizeof(BloqueCarga) + sizeof(Losa);
+}
+
+/**
+ * @brief Obtiene un bloque (primero de la lista libre, luego de la losa actual)
+ */
+BloqueCarga* PoolDeBloques::obtener() {
+    BloqueCarga* bloque;
+
+    if (listaLibre) {
+        // Reutilizar un bloque devuelto
+        bloque = listaLibre;
+        listaLibre = listaLibre->siguiente;
+        bloquesLibres--;
+    } else {
+        if (!losas || siguienteLibre == losas->cantidad) {
+            agregarLosa();
+        }
+        bloque = &losas->bloques[siguienteLibre++];
+    }
+
+    bloque->siguiente = nullptr;
+    bloque->previo = nullptr;
+    bloque->usados = 0;
+    return bloque;
+}
+
+/**
+ * @brief Devuelve un bloque a la lista libre
+ */
+void PoolDeBloques::devolver(BloqueCarga* bloque) {
+    if (!bloque) return;
+
+    bloque->siguiente = listaLibre;
+    listaLibre = bloque;
+    bloquesLibres++;
+}
+
+/**
+ * @brief Pide de una vez los bloques que falten para llegar a N disponibles
+ */
+void PoolDeBloques::reservar(int bloques) {
+    int disponibles = bloquesLibres;
+    if (losas) {
+        disponibles += losas->cantidad - siguienteLibre;
+    }
+
+    int faltantes = bloques - disponibles;
+    if (faltantes <= 0) return;
+
+    Losa* nueva = new Losa;
+    nueva->bloques = new BloqueCarga[faltantes];
+    nueva->cantidad = faltantes;
+    bytesReservados += static_cast<long long>(faltantes) * sizeof(BloqueCarga) + sizeof(Losa);
+
+    // La losa reservada va detras de la actual para no alterar siguienteLibre;
+    // si es la primera, queda como actual pero ya "consumida" hacia la lista libre
+    if (losas) {
+        nueva->siguiente = losas->siguiente;
+        losas->siguiente = nueva;
+    } else {
+        nueva->siguiente = nullptr;
+        losas = nueva;
+        siguienteLibre = faltantes;
+    }
+
+    for (int i = faltantes - 1; i >= 0; i--) {
+        devolver(&nueva->bloques[i]);
+    }
+}
+
+/**
+ * @brief Memoria total pedida al sistema
+ */
+long long PoolDeBloques::getBytesReservados() const {
+    return bytesReservados;
+}
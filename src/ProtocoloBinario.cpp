@@ -0,0 +1,123 @@
+/**
+ * @file ProtocoloBinario.cpp
+ * @brief Codificacion y lectura de tramas PRT-7 binarias
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "ProtocoloBinario.h"
+#include "Trama.h"
+
+/**
+ * @brief Posicion de un caracter en "ABC...XYZ " (-1 si no pertenece)
+ */
+static int posicionEnAlfabeto(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c == ' ') return 26;
+    return -1;
+}
+
+/**
+ * @brief Codifica una trama en binario
+ */
+int codificarTramaBinaria(const Trama& trama, unsigned char* destino) {
+    switch (trama.tipo) {
+        case TRAMA_LOAD: {
+            if (trama.longitud > 1) return 0;
+            // El host entrega cada trama como linea: "L," + '\0' seria "L,", una
+            // trama corta. Ese byte no se codifica (tampoco cabe en modo texto)
+            if (trama.caracter == '\0') return 0;
+            int posicion = posicionEnAlfabeto(trama.caracter);
+            if (posicion >= 0) {
+                destino[0] = static_cast<unsigned char>(BIN_CARGA_ALFABETO + posicion);
+                return 1;
+            }
+            destino[0] = BIN_CARGA_CRUDA;
+            destino[1] = static_cast<unsigned char>(trama.caracter);
+            return 2;
+        }
+        case TRAMA_MAP: {
+            // Zigzag: 0, -1, 1, -2, 2... -> 0, 1, 2, 3, 4... (rotaciones chicas en 1 byte)
+            unsigned int valor = (static_cast<unsigned int>(trama.rotacion) << 1)
+                                 ^ static_cast<unsigned int>(trama.rotacion >> 31);
+            int n = 0;
+            destino[n++] = BIN_MAPA;
+            while (valor >= 0x80) {
+                destino[n++] = static_cast<unsigned char>(valor | 0x80);
+                valor >>= 7;
+            }
+            destino[n++] = static_cast<unsigned char>(valor);
+            return n;
+        }
+        case TRAMA_FIN:
+            destino[0] = BIN_FIN;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Interpreta la trama binaria al inicio del bloque
+ */
+ResultadoBinario interpretarTramaBinaria(const unsigned char* datos, int disponibles,
+                                         Trama* trama, int* consumidos) {
+    *consumidos = 0;
+    if (disponibles <= 0) return BINARIO_INCOMPLETO;
+
+    trama->tipo = TRAMA_NINGUNA;
+    trama->sesion = 0;
+    trama->conMarca = false;
+    unsigned char etiqueta = datos[0];
+
+    trama->longitud = 1;
+    if (etiqueta >= BIN_CARGA_ALFABETO && etiqueta < BIN_CARGA_ALFABETO + 27) {
+        trama->tipo = TRAMA_LOAD;
+        trama->caracter = "ABCDEFGHIJKLMNOPQRSTUVWXYZ "[etiqueta - BIN_CARGA_ALFABETO];
+        *consumidos = 1;
+        return BINARIO_TRAMA;
+    }
+
+    switch (etiqueta) {
+        case BIN_CARGA_CRUDA:
+            if (disponibles < 2) return BINARIO_INCOMPLETO;
+            trama->tipo = TRAMA_LOAD;
+            trama->caracter = static_cast<char>(datos[1]);
+            *consumidos = 2;
+            return BINARIO_TRAMA;
+
+        case BIN_MAPA: {
+            unsigned int valor = 0;
+            for (int i = 1; i < TRAMA_BINARIA_MAXIMA; i++) {
+                if (i >= disponibles) return BINARIO_INCOMPLETO;
+                valor |= static_cast<unsigned int>(datos[i] & 0x7F) << (7 * (i - 1));
+                if ((datos[i] & 0x80) == 0) {
+                    trama->tipo = TRAMA_MAP;
+                    trama->rotacion = static_cast<int>(valor >> 1) ^ -static_cast<int>(valor & 1);
+                    *consumidos = i + 1;
+                    return BINARIO_TRAMA;
+                }
+            }
+            *consumidos = 1;
+            return BINARIO_INVALIDO;
+        }
+
+        case BIN_FIN:
+            trama->tipo = TRAMA_FIN;
+            *consumidos = 1;
+            return BINARIO_TRAMA;
+
+        case BIN_SINCRONIA:
+            if (disponibles < 2) return BINARIO_INCOMPLETO;
+            if (datos[1] == BIN_SINCRONIA_2) {
+                *consumidos = 2;
+                return BINARIO_SINCRONIA;
+            }
+            *consumidos = 1;
+            return BINARIO_INVALIDO;
+
+        default:
+            *consumidos = 1;
+            return BINARIO_INVALIDO;
+    }
+}
@@ -0,0 +1,350 @@
+/**
+ * @file RegistroAsincrono.cpp
+ * @brief Implementacion del registro asincrono (anillos de bytes y hilo de escritura)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "RegistroAsincrono.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * @struct AnilloRegistro
+ * @brief Bytes pendientes de un destino (std::cout o std::cerr)
+ */
+struct AnilloRegistro {
+    char* datos;                    ///< Capacidad bytes, preasignados
+    int capacidad;                  ///< Potencia de dos
+    unsigned long long escritura;   ///< Bytes publicados (posicion absoluta)
+    unsigned long long lectura;     ///< Bytes ya entregados al hilo
+
+    int getUsados() const { return static_cast<int>(escritura - lectura); }
+    int getLibres() const { return capacidad - getUsados(); }
+
+    /**
+     * @brief Copia n bytes al final (hay espacio)
+     */
+    void agregar(const char* texto, int n) {
+        int inicio = static_cast<int>(escritura & static_cast<unsigned long long>(capacidad - 1));
+        int primero = capacidad - inicio < n ? capacidad - inicio : n;
+        std::memcpy(datos + inicio, texto, static_cast<size_t>(primero));
+        std::memcpy(datos, texto + primero, static_cast<size_t>(n - primero));
+        escritura += static_cast<unsigned long long>(n);
+    }
+
+    /**
+     * @brief Saca hasta maximo bytes del principio
+     * @return Bytes copiados
+     */
+    int sacar(char* destino, int maximo) {
+        int n = getUsados() < maximo ? getUsados() : maximo;
+        int inicio = static_cast<int>(lectura & static_cast<unsigned long long>(capacidad - 1));
+        int primero = capacidad - inicio < n ? capacidad - inicio : n;
+        std::memcpy(destino, datos + inicio, static_cast<size_t>(primero));
+        std::memcpy(destino + primero, datos, static_cast<size_t>(n - primero));
+        lectura += static_cast<unsigned long long>(n);
+        return n;
+    }
+};
+
+/**
+ * @struct EstadoRegistro
+ * @brief Todo lo que comparten los productores y el hilo de escritura
+ */
+struct EstadoRegistro {
+    static const int SALIDA = 0;            ///< Anillo de std::cout
+    static const int ERRORES = 1;           ///< Anillo de std::cerr
+    static const int LOTE = 64 * 1024;      ///< Bytes por write() del hilo
+    static const int ESPERA_LOTE_MS = 2;    ///< Espera maxima para juntar un lote
+
+    AnilloRegistro anillos[2];              ///< Salida y errores
+    char* lote;                             ///< Copia de trabajo del hilo (LOTE bytes)
+    PoliticaRegistroLleno politica;         ///< Que hacer con el anillo lleno
+    unsigned long long descartadas;         ///< Trazas descartadas en total
+    unsigned long long sinMarca;            ///< Descartadas aun no anunciadas en la salida
+    unsigned long long vaciadosPedidos;     ///< Llamadas a vaciarRegistro() en curso
+    bool escribiendo;                       ///< El hilo tiene un lote fuera del anillo
+    bool terminar;                          ///< Pide terminar al hilo
+
+    std::mutex mutex;                       ///< Protege todo lo anterior
+    std::condition_variable hayDatos;       ///< Despierta al hilo
+    std::condition_variable hayEspacio;     ///< Despierta a productores con el anillo lleno
+    std::condition_variable vaciado;        ///< Despierta a vaciarRegistro()
+    std::thread hilo;                       ///< Hilo de escritura
+};
+
+/// Registro en marcha (nullptr: cada Registro escribe directo)
+static EstadoRegistro* estado = nullptr;
+
+/// Trazas descartadas por el ultimo registro detenido
+static unsigned long long descartadasAlDetener = 0;
+
+/**
+ * @brief Indica si queda algo por escribir
+ */
+static bool hayPendiente(const EstadoRegistro* e) {
+    return e->anillos[EstadoRegistro::SALIDA].getUsados() > 0
+        || e->anillos[EstadoRegistro::ERRORES].getUsados() > 0;
+}
+
+/**
+ * @brief Cuerpo del hilo de escritura
+ *
+ * Al primer byte espera hasta ESPERA_LOTE_MS para juntar un lote (salvo que
+ * se pida vaciar o terminar) y lo escribe con una sola llamada por destino.
+ * Los errores salen antes que la salida del mismo lote.
+ */
+static void escribirLotes(EstadoRegistro* e) {
+    std::unique_lock<std::mutex> bloqueo(e->mutex);
+    while (true) {
+        e->hayDatos.wait(bloqueo, [e] { return e->terminar || hayPendiente(e); });
+        if (!hayPendiente(e)) break;
+
+        e->hayDatos.wait_for(bloqueo, std::chrono::milliseconds(EstadoRegistro::ESPERA_LOTE_MS), [e] {
+            return e->terminar || e->vaciadosPedidos > 0
+                || e->anillos[EstadoRegistro::SALIDA].getUsados() >= EstadoRegistro::LOTE;
+        });
+
+        for (int destino = EstadoRegistro::ERRORES; destino >= EstadoRegistro::SALIDA; destino--) {
+            std::ostream& flujo = destino == EstadoRegistro::ERRORES ? std::cerr : std::cout;
+            while (e->anillos[destino].getUsados() > 0) {
+                int n = e->anillos[destino].sacar(e->lote, EstadoRegistro::LOTE);
+                e->escribiendo = true;
+                e->hayEspacio.notify_all();
+
+                bloqueo.unlock();
+                flujo.write(e->lote, n);
+                flujo.flush();
+                bloqueo.lock();
+                e->escribiendo = false;
+            }
+        }
+
+        if (e->vaciadosPedidos > 0 && !hayPendiente(e)) {
+            e->vaciado.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Arranca el hilo de escritura
+ */
+void iniciarRegistro(PoliticaRegistroLleno politica, int capacidad) {
+    if (estado != nullptr) return;
+
+    // Un lote completo debe caber, y la mascara requiere potencia de dos
+    int potencia = EstadoRegistro::LOTE;
+    while (potencia < capacidad) potencia <<= 1;
+
+    EstadoRegistro* e = new EstadoRegistro();
+    for (int i = 0; i < 2; i++) {
+        e->anillos[i].datos = new char[potencia];
+        e->anillos[i].capacidad = potencia;
+        e->anillos[i].escritura = 0;
+        e->anillos[i].lectura = 0;
+    }
+    e->lote = new char[EstadoRegistro::LOTE];
+    e->politica = politica;
+    e->descartadas = 0;
+    e->sinMarca = 0;
+    e->vaciadosPedidos = 0;
+    e->escribiendo = false;
+    e->terminar = false;
+
+    // Lo que ya estaba en std::cout (banners) sale antes que el registro
+    std::cout.flush();
+    e->hilo = std::thread(escribirLotes, e);
+    estado = e;
+}
+
+/**
+ * @brief Espera a que el hilo haya escrito todo lo publicado
+ */
+void vaciarRegistro() {
+    EstadoRegistro* e = estado;
+    if (e == nullptr) return;
+
+    std::unique_lock<std::mutex> bloqueo(e->mutex);
+    e->vaciadosPedidos++;
+    e->hayDatos.notify_one();
+    e->vaciado.wait(bloqueo, [e] { return !hayPendiente(e) && !e->escribiendo; });
+    e->vaciadosPedidos--;
+}
+
+/**
+ * @brief Vacia el registro y detiene el hilo
+ */
+void detenerRegistro() {
+    EstadoRegistro* e = estado;
+    if (e == nullptr) return;
+
+    {
+        std::lock_guard<std::mutex> bloqueo(e->mutex);
+        e->terminar = true;
+    }
+    e->hayDatos.notify_one();
+    e->hilo.join();
+
+    // Desde aqui los Registro vuelven a escribir directo
+    estado = nullptr;
+    descartadasAlDetener = e->descartadas;
+    for (int i = 0; i < 2; i++) {
+        delete[] e->anillos[i].datos;
+    }
+    delete[] e->lote;
+    delete e;
+}
+
+/**
+ * @brief Trazas descartadas por REGISTRO_DESCARTAR
+ */
+unsigned long long getTrazasDescartadas() {
+    EstadoRegistro* e = estado;
+    if (e == nullptr) return descartadasAlDetener;
+
+    std::lock_guard<std::mutex> bloqueo(e->mutex);
+    return e->descartadas;
+}
+
+/**
+ * @brief Copia texto ya formateado al anillo de su destino
+ *
+ * Con el anillo lleno, las trazas se descartan enteras (REGISTRO_DESCARTAR) y
+ * la siguiente que entre va precedida de una marca con cuantas se perdieron;
+ * los demas niveles siempre esperan. Solo se despierta al hilo cuando el
+ * anillo estaba vacio o se junto un lote, no en cada registro.
+ */
+bool publicarRegistro(NivelRegistro nivel, const char* texto, int n) {
+    bool esError = nivel >= REGISTRO_AVISO;
+    EstadoRegistro* e = estado;
+    if (e == nullptr) {
+        // Sin hilo: escritura directa, vaciando en cada fin de linea como std::endl
+        std::ostream& flujo = esError ? std::cerr : std::cout;
+        flujo.write(texto, n);
+        if (n > 0 && texto[n - 1] == '\n') flujo.flush();
+        return true;
+    }
+
+    std::unique_lock<std::mutex> bloqueo(e->mutex);
+    AnilloRegistro& anillo = e->anillos[esError ? EstadoRegistro::ERRORES : EstadoRegistro::SALIDA];
+    bool descartable = nivel == REGISTRO_TRAZA && e->politica == REGISTRO_DESCARTAR;
+
+    char marca[64];
+    int largoMarca = 0;
+    if (descartable && e->sinMarca > 0) {
+        largoMarca = std::snprintf(marca, sizeof(marca), "\n[registro: %llu trazas descartadas]\n", e->sinMarca);
+    }
+
+    while (anillo.getLibres() < largoMarca + n) {
+        if (descartable) {
+            e->descartadas++;
+            e->sinMarca++;
+            return false;
+        }
+        e->hayDatos.notify_one();
+        e->hayEspacio.wait(bloqueo);
+    }
+
+    int antes = anillo.getUsados();
+    if (largoMarca > 0) {
+        anillo.agregar(marca, largoMarca);
+        e->sinMarca = 0;
+    }
+    anillo.agregar(texto, n);
+
+    if (antes == 0 || esError
+        || (antes < EstadoRegistro::LOTE && anillo.getUsados() >= EstadoRegistro::LOTE)) {
+        e->hayDatos.notify_one();
+    }
+    return true;
+}
+
+/**
+ * @brief Constructor - Registro vacio
+ */
+Registro::Registro(NivelRegistro nivel) : nivel(nivel), usados(0), descartado(false) {
+}
+
+/**
+ * @brief Destructor - Publica lo que quede
+ */
+Registro::~Registro() {
+    publicar();
+}
+
+/**
+ * @brief Publica lo acumulado como un tramo
+ */
+void Registro::publicar() {
+    if (usados > 0 && !descartado) {
+        descartado = !publicarRegistro(nivel, texto, usados);
+    }
+    usados = 0;
+}
+
+/**
+ * @brief Agrega bytes, publicando un tramo cada vez que se llena el buffer
+ */
+Registro& Registro::escribir(const char* datos, int n) {
+    while (n > 0) {
+        if (usados == CAPACIDAD) publicar();
+        int copia = CAPACIDAD - usados < n ? CAPACIDAD - usados : n;
+        std::memcpy(texto + usados, datos, static_cast<size_t>(copia));
+        usados += copia;
+        datos += copia;
+        n -= copia;
+    }
+    return *this;
+}
+
+/**
+ * @brief Agrega una cadena terminada en '\0'
+ */
+Registro& Registro::operator<<(const char* cadena) {
+    return escribir(cadena, static_cast<int>(std::strlen(cadena)));
+}
+
+/**
+ * @brief Agrega un caracter
+ */
+Registro& Registro::operator<<(char c) {
+    return escribir(&c, 1);
+}
+
+/**
+ * @brief Agrega un entero en decimal
+ */
+Registro& Registro::operator<<(int n) {
+    return *this << static_cast<long long>(n);
+}
+
+/**
+ * @brief Agrega un entero en decimal
+ */
+Registro& Registro::operator<<(long long n) {
+    if (n < 0) {
+        *this << '-';
+        // -(n + 1) + 1 evita desbordar con el minimo
+        return *this << static_cast<unsigned long long>(-(n + 1)) + 1;
+    }
+    return *this << static_cast<unsigned long long>(n);
+}
+
+/**
+ * @brief Agrega un entero en decimal (sin pasar por iostream)
+ */
+Registro& Registro::operator<<(unsigned long long n) {
+    char digitos[20];
+    int i = sizeof(digitos);
+    do {
+        digitos[--i] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n > 0);
+    return escribir(digitos + i, static_cast<int>(sizeof(digitos)) - i);
+}
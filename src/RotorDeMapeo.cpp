@@ -1,190 +1,309 @@
 /**
  * @file RotorDeMapeo.cpp
- * @brief Implementacion del RotorDeMapeo (Lista Circular)
+ * @brief Implementacion del RotorDeMapeo (anillo indexado por desplazamiento)
  * @author Elias de Jesus Zuniga de Leon
  * @date 2025-11-06
  */
 
 #include "RotorDeMapeo.h"
+#include "NivelDetalle.h"
+#include "RegistroAsincrono.h"
 #include <iostream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PRT7_SIMD_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PRT7_SIMD_SSE2
+#endif
+
 /**
- * @brief Constructor - Crea la lista circular con A-Z y espacio
- */
-RotorDeMapeo::RotorDeMapeo() {
-    // Alfabeto completo: A-Z + espacio (27 caracteres)
-    const char alfabeto[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
-    const int tamanio = 27;
-    
-    // Crear el primer nodo (A)
-    cabeza = new NodoRotor(alfabeto[0]);
-    NodoRotor* actual = cabeza;
-    
-    // Crear los demas nodos (B-Z y espacio)
-    for (int i = 1; i < tamanio; i++) {
-        NodoRotor* nuevo = new NodoRotor(alfabeto[i]);
-        
-        // Enlazar: actual <-> nuevo
-        actual->siguiente = nuevo;
-        nuevo->previo = actual;
-        
-        actual = nuevo;
+ * @struct TablasRotor
+ * @brief Tablas de solo lectura compartidas por todos los rotores
+ */
+struct TablasRotor {
+    char alfabeto[RotorDeMapeo::TAMANIO];   ///< Caracteres del anillo en orden circular
+    signed char indice[256];                ///< Posicion de cada byte en el anillo (-1 si no esta)
+    char mapeo[RotorDeMapeo::TAMANIO][RotorDeMapeo::TAMANIO];  ///< mapeo[cabeza][posicion]
+
+    /**
+     * @brief Construye las tablas a partir del alfabeto A-Z + espacio
+     */
+    TablasRotor() {
+        // Alfabeto completo: A-Z + espacio (27 caracteres)
+        const char letras[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+        const int tamanio = RotorDeMapeo::TAMANIO;
+
+        // Ningun byte pertenece al anillo hasta que se registre
+        for (int i = 0; i < 256; i++) {
+            indice[i] = -1;
+        }
+
+        // Copiar el alfabeto y registrar la posicion de cada caracter
+        for (int i = 0; i < tamanio; i++) {
+            alfabeto[i] = letras[i];
+            indice[static_cast<unsigned char>(letras[i])] = static_cast<signed char>(i);
+        }
+
+        // Precalcular el resultado de cada posicion para cada cabeza posible
+        for (int c = 0; c < tamanio; c++) {
+            for (int p = 0; p < tamanio; p++) {
+                mapeo[c][p] = alfabeto[(p - c + tamanio) % tamanio];
+            }
+        }
     }
-    
-    // Cerrar el circulo: ultimo nodo <-> primer nodo
-    actual->siguiente = cabeza;
-    cabeza->previo = actual;
-}
+};
 
 /**
- * @brief Destructor - Libera toda la memoria
+ * @brief Devuelve las tablas compartidas (se construyen una sola vez)
  */
-RotorDeMapeo::~RotorDeMapeo() {
-    if (!cabeza) return;
-    
-    // Romper el circulo para evitar loops infinitos
-    NodoRotor* ultimo = cabeza->previo;
-    ultimo->siguiente = nullptr;
-    
-    // Eliminar todos los nodos
-    NodoRotor* actual = cabeza;
-    while (actual) {
-        NodoRotor* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    }
-    
-    cabeza = nullptr;
+static const TablasRotor* obtenerTablas() {
+    static const TablasRotor tablas;
+    return &tablas;
 }
 
 /**
- * @brief Busca un nodo que contiene un caracter
+ * @brief Constructor - Cabeza en 'A' (posicion 0)
  */
-NodoRotor* RotorDeMapeo::buscarNodo(char c) {
-    if (!cabeza) return nullptr;
-    
-    NodoRotor* actual = cabeza;
-    
-    // Recorrer toda la lista circular
-    do {
-        if (actual->dato == c) {
-            return actual;
-        }
-        actual = actual->siguiente;
-    } while (actual != cabeza);
-    
-    return nullptr;  // No encontrado
+RotorDeMapeo::RotorDeMapeo()
+    : tablas(obtenerTablas()), cabeza(0), rotacionPendiente(0), mapasPendientes(0) {
 }
 
 /**
- * @brief Calcula la distancia entre dos nodos
- */
-int RotorDeMapeo::calcularDistancia(NodoRotor* desde, NodoRotor* hasta) {
-    if (!desde || !hasta) return 0;
-    
-    int distancia = 0;
-    NodoRotor* actual = desde;
-    
-    // Contar cuantos pasos se necesitan para llegar de 'desde' a 'hasta'
-    while (actual != hasta) {
-        actual = actual->siguiente;
-        distancia++;
-        
-        // Seguridad: evitar loops infinitos (no deberia pasar)
-        if (distancia > 100) break;
-    }
-    
-    return distancia;
+ * @brief Destructor - No hay memoria dinamica que liberar
+ */
+RotorDeMapeo::~RotorDeMapeo() {
 }
 
 /**
  * @brief Rota el rotor N posiciones
+ *
+ * Mover la cabeza N nodos hacia adelante (o atras) en el anillo equivale a
+ * sumar N a la posicion actual modulo 27.
  */
 void RotorDeMapeo::rotar(int n) {
-    if (!cabeza) return;
-    
     // Normalizar n para evitar rotaciones innecesarias
     // (27 posiciones = una vuelta completa)
-    n = n % 27;
-    
-    if (n > 0) {
-        // Rotar a la derecha (siguiente)
-        for (int i = 0; i < n; i++) {
-            cabeza = cabeza->siguiente;
-        }
-    } else if (n < 0) {
-        // Rotar a la izquierda (previo)
-        for (int i = 0; i > n; i--) {
-            cabeza = cabeza->previo;
+    n = n % TAMANIO;
+
+    cabeza += n;
+    if (cabeza < 0) {
+        cabeza += TAMANIO;
+    } else if (cabeza >= TAMANIO) {
+        cabeza -= TAMANIO;
+    }
+
+    // Debug: mostrar la rotacion (solo con trazas por trama)
+    if (obtenerNivelDetalle() >= DETALLE_TRAMA) {
+        if (obtenerRotacionDiferida()) {
+            // Una sola traza por rafaga de MAP, al llegar la siguiente LOAD
+            rotacionPendiente = (rotacionPendiente + n) % TAMANIO;
+            mapasPendientes++;
+            return;
         }
+        Registro(REGISTRO_TRAZA) << "\n>>> ROTANDO ROTOR " << (n >= 0 ? "+" : "") << n
+                                 << " (Ahora 'A' se mapea a '" << getMapeo('A') << "')\n";
     }
-    
-    // Debug: mostrar la rotacion
-    std::cout << "\n>>> ROTANDO ROTOR " << (n >= 0 ? "+" : "") << n 
-              << " (Ahora 'A' se mapea a '" << getMapeo('A') << "')" << std::endl;
+}
+
+/**
+ * @brief Imprime la traza de la rotacion neta acumulada
+ */
+void RotorDeMapeo::emitirRotacionPendiente() {
+    if (mapasPendientes == 0) return;
+
+    Registro(REGISTRO_TRAZA) << "\n>>> ROTANDO ROTOR " << (rotacionPendiente >= 0 ? "+" : "") << rotacionPendiente
+                             << " neto en " << mapasPendientes << (mapasPendientes == 1 ? " trama MAP" : " tramas MAP")
+                             << " (Ahora 'A' se mapea a '" << getMapeo('A') << "')\n";
+    rotacionPendiente = 0;
+    mapasPendientes = 0;
+}
+
+/**
+ * @brief Desplazamiento neto acumulado
+ */
+int RotorDeMapeo::getDesplazamiento() const {
+    return cabeza;
+}
+
+/**
+ * @brief Coloca la cabeza directamente
+ */
+void RotorDeMapeo::setDesplazamiento(int d) {
+    d = d % TAMANIO;
+    cabeza = d < 0 ? d + TAMANIO : d;
+    rotacionPendiente = 0;
+    mapasPendientes = 0;
 }
 
 /**
  * @brief Obtiene el caracter mapeado
- * 
- * LOGICA COMPLEJA DEL MAPEO:
- * 
- * Ejemplo: Si el rotor esta rotado +2:
- *   Rotor original: A B C D E F G ...
- *   Cabeza en:      C (rotado +2)
- * 
- *   Si llega 'A':
- *   1. Buscar 'A' en el rotor (siempre esta en su posicion original)
- *   2. Calcular distancia desde cabeza (C) hasta 'A'
- *      C -> D -> E -> ... -> Z -> espacio -> A = 25 pasos
- *   3. Buscar el nodo 'A' original (sin rotacion)
- *   4. Avanzar 25 pasos desde 'A' original
- *   5. Resultado: 'A' + 25 = 'Z' (overflow circular)
- *   
- *   Simplificado: 'A' rotado +2 = 'C'
- */
-char RotorDeMapeo::getMapeo(char in) {
+ *
+ * LOGICA DEL MAPEO:
+ *
+ * La distancia (en pasos hacia adelante) desde la cabeza hasta el caracter
+ * de entrada se aplica a partir de 'A' (posicion 0 del anillo):
+ *
+ *   distancia = (posicion(in) - cabeza) mod 27
+ *   resultado = alfabeto[distancia]
+ *
+ * Ejemplo con el rotor rotado +2 (cabeza en 'C'):
+ *   'A' esta a 25 pasos de 'C' -> alfabeto[25] = 'Z'
+ *
+ * El resultado para cada (cabeza, posicion) ya esta en tablas->mapeo.
+ */
+char RotorDeMapeo::getMapeo(char in) const {
     // Caso especial: caracter no esta en el rotor
-    NodoRotor* nodoOriginal = buscarNodo(in);
-    if (!nodoOriginal) {
+    int posicion = tablas->indice[static_cast<unsigned char>(in)];
+    if (posicion < 0) {
         return in;  // Devolver sin modificar
     }
-    
-    // Calcular la posicion del caracter relativa a la cabeza actual
-    int distancia = calcularDistancia(cabeza, nodoOriginal);
-    
-    // Encontrar el nodo 'A' original (referencia fija)
-    NodoRotor* nodoA = buscarNodo('A');
-    if (!nodoA) return in;
-    
-    // Avanzar la misma distancia desde 'A'
-    NodoRotor* resultado = nodoA;
-    for (int i = 0; i < distancia; i++) {
-        resultado = resultado->siguiente;
+
+    return tablas->mapeo[cabeza][posicion];
+}
+
+#ifdef PRT7_SIMD_SSE2
+/**
+ * @brief Decodifica 16 bytes con comparaciones y selecciones SSE2
+ *
+ * Por cada byte: posicion = letra - 'A' (o 26 si es espacio), se resta la
+ * cabeza modulo 27 y se convierte de vuelta a caracter. Los bytes fuera del
+ * alfabeto se copian sin cambios.
+ */
+static inline __m128i decodificar16(__m128i v, __m128i vCabeza) {
+    const __m128i cero = _mm_setzero_si128();
+    const __m128i vA = _mm_set1_epi8('A');
+    const __m128i v26 = _mm_set1_epi8(26);
+    const __m128i v27 = _mm_set1_epi8(27);
+    const __m128i vEspacio = _mm_set1_epi8(' ');
+    const __m128i menosUno = _mm_set1_epi8(-1);
+
+    __m128i t = _mm_sub_epi8(v, vA);
+    __m128i esLetra = _mm_and_si128(_mm_cmpgt_epi8(t, menosUno), _mm_cmplt_epi8(t, v26));
+    __m128i esEspacio = _mm_cmpeq_epi8(v, vEspacio);
+
+    // posicion en el anillo (solo es valida donde esLetra o esEspacio)
+    __m128i pos = _mm_or_si128(_mm_and_si128(esLetra, t), _mm_andnot_si128(esLetra, v26));
+
+    // distancia = (pos - cabeza) mod 27
+    __m128i d = _mm_sub_epi8(pos, vCabeza);
+    d = _mm_add_epi8(d, _mm_and_si128(_mm_cmplt_epi8(d, cero), v27));
+
+    // distancia 26 -> espacio, el resto -> 'A' + distancia
+    __m128i esUltima = _mm_cmpeq_epi8(d, v26);
+    __m128i car = _mm_or_si128(_mm_and_si128(esUltima, vEspacio),
+                               _mm_andnot_si128(esUltima, _mm_add_epi8(d, vA)));
+
+    __m128i enAlfabeto = _mm_or_si128(esLetra, esEspacio);
+    return _mm_or_si128(_mm_and_si128(enAlfabeto, car), _mm_andnot_si128(enAlfabeto, v));
+}
+#endif
+
+#ifdef PRT7_SIMD_AVX2
+/**
+ * @brief Version AVX2 de decodificar16 (32 bytes por iteracion)
+ */
+static inline __m256i decodificar32(__m256i v, __m256i vCabeza) {
+    const __m256i cero = _mm256_setzero_si256();
+    const __m256i vA = _mm256_set1_epi8('A');
+    const __m256i v26 = _mm256_set1_epi8(26);
+    const __m256i v27 = _mm256_set1_epi8(27);
+    const __m256i vEspacio = _mm256_set1_epi8(' ');
+    const __m256i menosUno = _mm256_set1_epi8(-1);
+
+    __m256i t = _mm256_sub_epi8(v, vA);
+    __m256i esLetra = _mm256_and_si256(_mm256_cmpgt_epi8(t, menosUno), _mm256_cmpgt_epi8(v26, t));
+    __m256i esEspacio = _mm256_cmpeq_epi8(v, vEspacio);
+
+    __m256i pos = _mm256_blendv_epi8(v26, t, esLetra);
+
+    __m256i d = _mm256_sub_epi8(pos, vCabeza);
+    d = _mm256_add_epi8(d, _mm256_and_si256(_mm256_cmpgt_epi8(cero, d), v27));
+
+    __m256i car = _mm256_blendv_epi8(_mm256_add_epi8(d, vA), vEspacio, _mm256_cmpeq_epi8(d, v26));
+
+    return _mm256_blendv_epi8(v, car, _mm256_or_si256(esLetra, esEspacio));
+}
+#endif
+
+/**
+ * @brief Aplica a un bloque el mapeo de una cabeza dada
+ *
+ * Kernel vectorial para la mayor parte del bloque y tabla precalculada
+ * (tablas->mapeo[cabeza]) para la cola y para plataformas sin SIMD.
+ */
+static void mapearBloque(const TablasRotor* tablas, int cabeza, const char* entrada, char* salida, int n) {
+    int i = 0;
+
+#ifdef PRT7_SIMD_AVX2
+    const __m256i vCabeza32 = _mm256_set1_epi8(static_cast<char>(cabeza));
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(entrada + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(salida + i), decodificar32(v, vCabeza32));
+    }
+#endif
+
+#ifdef PRT7_SIMD_SSE2
+    const __m128i vCabeza16 = _mm_set1_epi8(static_cast<char>(cabeza));
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entrada + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(salida + i), decodificar16(v, vCabeza16));
+    }
+#endif
+
+    // Cola (o bloque completo sin SIMD): tabla de 27 entradas para esta cabeza
+    const char* fila = tablas->mapeo[cabeza];
+    for (; i < n; i++) {
+        int posicion = tablas->indice[static_cast<unsigned char>(entrada[i])];
+        salida[i] = (posicion < 0) ? entrada[i] : fila[posicion];
     }
-    
-    return resultado->dato;
 }
 
 /**
- * @brief Imprime el rotor (debug)
+ * @brief Decodifica un bloque de bytes con la rotacion actual
+ */
+void RotorDeMapeo::decodificarBloque(const char* entrada, char* salida, int n) const {
+    mapearBloque(tablas, cabeza, entrada, salida, n);
+}
+
+/**
+ * @brief Cifra un caracter (inversa de getMapeo)
+ *
+ * getMapeo() resta la cabeza a la posicion; cifrar la suma, que es lo
+ * mismo que decodificar con la cabeza opuesta (27 - cabeza).
  */
-void RotorDeMapeo::imprimirRotor() {
-    if (!cabeza) {
-        std::cout << "Rotor vacio" << std::endl;
-        return;
+char RotorDeMapeo::getCifrado(char in) const {
+    int posicion = tablas->indice[static_cast<unsigned char>(in)];
+    if (posicion < 0) {
+        return in;
     }
-    
-    std::cout << "Rotor (cabeza en '" << cabeza->dato << "'): ";
-    
-    NodoRotor* actual = cabeza;
-    do {
-        std::cout << actual->dato;
-        if (actual->siguiente != cabeza) {
+
+    return tablas->mapeo[(TAMANIO - cabeza) % TAMANIO][posicion];
+}
+
+/**
+ * @brief Cifra un bloque de bytes con la rotacion actual
+ */
+void RotorDeMapeo::codificarBloque(const char* entrada, char* salida, int n) const {
+    mapearBloque(tablas, (TAMANIO - cabeza) % TAMANIO, entrada, salida, n);
+}
+
+/**
+ * @brief Imprime el rotor (debug)
+ */
+void RotorDeMapeo::imprimirRotor() const {
+    std::cout << "Rotor (cabeza en '" << tablas->alfabeto[cabeza] << "'): ";
+
+    // Recorrer el anillo empezando por la cabeza
+    for (int i = 0; i < TAMANIO; i++) {
+        std::cout << tablas->alfabeto[(cabeza + i) % TAMANIO];
+        if (i < TAMANIO - 1) {
             std::cout << " -> ";
         }
-        actual = actual->siguiente;
-    } while (actual != cabeza);
-    
+    }
+
     std::cout << " (circular)" << std::endl;
 }
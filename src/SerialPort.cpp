@@ -1,18 +1,35 @@
 /**
  * @file SerialPort.cpp
- * @brief Implementacion de comunicacion serial para Windows
+ * @brief Implementacion de comunicacion serial (Windows y POSIX)
  * @author Elias de Jesus Zuniga de Leon
  * @date 2025-11-06
  */
 
 #include "SerialPort.h"
+#include "NivelDetalle.h"
+#include "ProtocoloBinario.h"
+#include "Trama.h"
+#include "MetricasDecodificador.h"
+#include "RegistroAsincrono.h"
+#include "LatenciaEnlace.h"
 #include <iostream>
 #include <cstring>
+#include <chrono>
+
+#ifndef WINDOWS_BUILD
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <errno.h>
+#endif
 
 /**
  * @brief Constructor - Abre y configura el puerto serial
  */
-SerialPort::SerialPort(const char* portName) : conectado(false) {
+SerialPort::SerialPort(const char* portName)
+    : conectado(false), timeoutLecturaMs(100), lectura(0), escritura(0), escaneado(0), bytesLeidos(0),
+      modoBinario(false), sincronizado(false), solicitudesRestantes(0), bytesDescartados(0) {
     // Copiar nombre del puerto
     int len = 0;
     while (portName[len] != '\0') len++;
@@ -20,7 +37,7 @@ SerialPort::SerialPort(const char* portName) : conectado(false) {
     for (int i = 0; i <= len; i++) {
         puerto[i] = portName[i];
     }
-    
+
 #ifdef WINDOWS_BUILD
     // Construir el nombre completo del puerto (ej: "\\\\.\\COM9")
     char fullPortName[20];
@@ -32,7 +49,7 @@ SerialPort::SerialPort(const char* portName) : conectado(false) {
         i++;
     }
     fullPortName[4 + i] = '\0';
-    
+
     // Abrir el puerto serial
     hSerial = CreateFileA(
         fullPortName,
@@ -43,51 +60,110 @@ SerialPort::SerialPort(const char* portName) : conectado(false) {
         FILE_ATTRIBUTE_NORMAL,
         nullptr
     );
-    
+
     if (hSerial == INVALID_HANDLE_VALUE) {
         std::cerr << "Error: No se pudo abrir el puerto " << portName << std::endl;
         return;
     }
-    
+
     // Configurar parametros del puerto (115200 baudios, 8N1)
     dcbSerialParams = {0};
     dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
-    
+
     if (!GetCommState(hSerial, &dcbSerialParams)) {
         std::cerr << "Error: No se pudo obtener el estado del puerto" << std::endl;
         CloseHandle(hSerial);
         return;
     }
-    
+
     dcbSerialParams.BaudRate = CBR_115200;  // 115200 baudios
     dcbSerialParams.ByteSize = 8;           // 8 bits de datos
     dcbSerialParams.StopBits = ONESTOPBIT;  // 1 bit de parada
     dcbSerialParams.Parity = NOPARITY;      // Sin paridad
-    
+
     if (!SetCommState(hSerial, &dcbSerialParams)) {
         std::cerr << "Error: No se pudo configurar el puerto" << std::endl;
         CloseHandle(hSerial);
         return;
     }
-    
-    // Configurar timeouts
+
+    // Configurar timeouts: ReadFile regresa en cuanto hay al menos un byte,
+    // o tras ReadTotalTimeoutConstant ms sin datos (bloquea sin usar CPU)
     timeouts = {0};
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant = timeoutLecturaMs;
+    timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
     timeouts.WriteTotalTimeoutConstant = 50;
     timeouts.WriteTotalTimeoutMultiplier = 10;
-    
+
     if (!SetCommTimeouts(hSerial, &timeouts)) {
         std::cerr << "Error: No se pudo configurar los timeouts" << std::endl;
         CloseHandle(hSerial);
         return;
     }
-    
+
     conectado = true;
-    std::cout << "Puerto " << portName << " abierto correctamente a 115200 baudios" << std::endl;
+    if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+        std::cout << "Puerto " << portName << " abierto correctamente a 115200 baudios" << std::endl;
+    }
 #else
-    std::cerr << "Error: Esta version solo soporta Windows" << std::endl;
+    // Aceptar "ttyUSB0" como abreviatura de "/dev/ttyUSB0"
+    char ruta[256];
+    int pos = 0;
+    if (portName[0] != '/') {
+        const char* prefijo = "/dev/";
+        while (prefijo[pos] != '\0') {
+            ruta[pos] = prefijo[pos];
+            pos++;
+        }
+    }
+    for (int i = 0; portName[i] != '\0' && pos < 255; i++) {
+        ruta[pos++] = portName[i];
+    }
+    ruta[pos] = '\0';
+
+    // Abrir el dispositivo (sin convertirlo en terminal de control)
+    fd = open(ruta, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        std::cerr << "Error: No se pudo abrir el puerto " << ruta
+                  << " (" << std::strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    struct termios opciones;
+    if (tcgetattr(fd, &opciones) != 0) {
+        std::cerr << "Error: No se pudo obtener el estado del puerto" << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    // Modo crudo 8N1 a 115200 baudios, sin control de flujo
+    cfmakeraw(&opciones);
+    cfsetispeed(&opciones, B115200);
+    cfsetospeed(&opciones, B115200);
+    opciones.c_cflag |= (CLOCAL | CREAD);
+    opciones.c_cflag &= ~(PARENB | CSTOPB | CSIZE);
+    opciones.c_cflag |= CS8;
+#ifdef CRTSCTS
+    opciones.c_cflag &= ~CRTSCTS;
+#endif
+
+    // read() nunca bloquea: la espera se hace con poll() en llenarAnillo()
+    opciones.c_cc[VMIN] = 0;
+    opciones.c_cc[VTIME] = 0;
+
+    if (tcsetattr(fd, TCSANOW, &opciones) != 0) {
+        std::cerr << "Error: No se pudo configurar el puerto" << std::endl;
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    conectado = true;
+    if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+        std::cout << "Puerto " << ruta << " abierto correctamente a 115200 baudios" << std::endl;
+    }
 #endif
 }
 
@@ -107,52 +183,342 @@ bool SerialPort::estaConectado() const {
 }
 
 /**
- * @brief Lee una linea del puerto serial
+ * @brief Espera datos y los lee al espacio libre contiguo del anillo
  */
-int SerialPort::leerLinea(char* buffer, int bufferSize) {
+int SerialPort::llenarAnillo(int esperaMs) {
+    unsigned int libre = TAMANIO_ANILLO - (escritura - lectura);
+    if (libre == 0) return 0;
+
+    unsigned int posicion = escritura & (TAMANIO_ANILLO - 1);
+    unsigned int contiguo = TAMANIO_ANILLO - posicion;
+    if (contiguo > libre) contiguo = libre;
+
 #ifdef WINDOWS_BUILD
-    if (!conectado) return 0;
-    
+    // La espera la hace ReadFile segun ReadTotalTimeoutConstant
+    // (con MAXDWORD en los otros dos campos, la constante debe ser > 0)
+    DWORD constante = esperaMs > 0 ? static_cast<DWORD>(esperaMs) : 1;
+    if (timeouts.ReadTotalTimeoutConstant != constante) {
+        timeouts.ReadTotalTimeoutConstant = constante;
+        SetCommTimeouts(hSerial, &timeouts);
+    }
+
     DWORD bytesLeidos = 0;
+    if (!ReadFile(hSerial, anillo + posicion, contiguo, &bytesLeidos, nullptr)) {
+        return -1;
+    }
+    int n = static_cast<int>(bytesLeidos);
+#else
+    // Dormir en poll() hasta que el descriptor tenga datos
+    struct pollfd espera;
+    espera.fd = fd;
+    espera.events = POLLIN;
+    espera.revents = 0;
+
+    int listo = poll(&espera, 1, esperaMs);
+    if (listo < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    if (listo == 0) {
+        return 0;
+    }
+
+    ssize_t n = read(fd, anillo + posicion, contiguo);
+    if (n < 0) {
+        // Interrupcion o sin datos: equivale a un timeout
+        if (errno == EINTR || errno == EAGAIN) return 0;
+        return -1;
+    }
+    if (n == 0 && (espera.revents & (POLLHUP | POLLERR)) != 0) {
+        // Dispositivo desconectado (con VMIN = 0, read() devuelve 0 en vez de error)
+        return -1;
+    }
+#endif
+
+    escritura += static_cast<unsigned int>(n);
+    bytesLeidos += static_cast<unsigned long long>(n);
+    return static_cast<int>(n);
+}
+
+/**
+ * @brief Copia n bytes del anillo al buffer (omitiendo '\r') y los consume
+ */
+int SerialPort::extraerLinea(char* buffer, int bufferSize, unsigned int n, unsigned int separador) {
     int posicion = 0;
-    char caracter;
-    
-    // Leer caracter por caracter hasta encontrar '\n'
-    while (posicion < bufferSize - 1) {
-        if (ReadFile(hSerial, &caracter, 1, &bytesLeidos, nullptr)) {
-            if (bytesLeidos > 0) {
-                // Ignorar \r
-                if (caracter == '\r') {
-                    continue;
-                }
-                
+
+    for (unsigned int i = 0; i < n && posicion < bufferSize - 1; i++) {
+        char caracter = anillo[(lectura + i) & (TAMANIO_ANILLO - 1)];
+
+        // Ignorar \r
+        if (caracter == '\r') {
+            continue;
+        }
+
+        buffer[posicion++] = caracter;
+    }
+
+    buffer[posicion] = '\0';
+    lectura += n + separador;
+    escaneado = lectura;
+    return posicion;
+}
+
+/**
+ * @brief Lee una linea del puerto serial
+ */
+int SerialPort::leerLinea(char* buffer, int bufferSize) {
+    if (bufferSize <= 0) return 0;
+    buffer[0] = '\0';
+    if (bufferSize == 1) return 0;
+
+    if (modoBinario) {
+        return leerTramaBinaria(buffer, bufferSize, timeoutLecturaMs);
+    }
+    if (solicitudesRestantes > 0) {
+        reintentarSolicitud();
+    }
+
+    // Momento limite para entregar una linea completa
+    std::chrono::steady_clock::time_point limite =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutLecturaMs);
+    int esperaMs = timeoutLecturaMs;
+
+    unsigned int trozoMaximo = static_cast<unsigned int>(bufferSize - 1);
+
+    while (true) {
+        // Buscar '\n' solo en los bytes que aun no se revisaron, sin pasar del
+        // trozo que cabe en el buffer (hayLineaCompleta() pudo revisar mas alla)
+        while (escaneado != escritura) {
+            if (anillo[escaneado & (TAMANIO_ANILLO - 1)] == '\n' && escaneado - lectura <= trozoMaximo) {
                 // Fin de linea
-                if (caracter == '\n') {
-                    buffer[posicion] = '\0';
-                    return posicion;
+                int largo = extraerLinea(buffer, bufferSize, escaneado - lectura, 1);
+                if (solicitudesRestantes > 0 && std::strcmp(buffer, CONFIRMACION_BINARIO) == 0) {
+                    // Desde el byte siguiente el ESP32 transmite en binario
+                    modoBinario = true;
+                    solicitudesRestantes = 0;
+                    if (obtenerNivelDetalle() >= DETALLE_RESUMEN) {
+                        Registro(REGISTRO_INFO) << "Modo binario confirmado por el ESP32\n";
+                    }
+                    long long restante = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        limite - std::chrono::steady_clock::now()).count();
+                    return leerTramaBinaria(buffer, bufferSize, restante > 0 ? static_cast<int>(restante) : 0);
                 }
-                
-                // Agregar caracter al buffer
-                buffer[posicion++] = caracter;
-            } else {
-                // No hay datos disponibles
-                break;
+                return largo;
             }
-        } else {
+            if (escaneado - lectura >= trozoMaximo) {
+                // Linea mas larga que el buffer: un trozo, el resto queda en el anillo
+                return extraerLinea(buffer, bufferSize, trozoMaximo, 0);
+            }
+            escaneado++;
+        }
+
+        // Linea mas larga que el buffer (o que el anillo): entregar un trozo
+        unsigned int pendientes = escritura - lectura;
+        if (pendientes >= trozoMaximo || pendientes == TAMANIO_ANILLO) {
+            unsigned int trozo = trozoMaximo;
+            if (trozo > pendientes) trozo = pendientes;
+            return extraerLinea(buffer, bufferSize, trozo, 0);
+        }
+
+        if (!conectado) return 0;
+
+        // Traer mas bytes en bloque; si no llego nada, la linea queda pendiente
+        int leidos = llenarAnillo(esperaMs);
+        if (leidos < 0) {
             // Error de lectura
             conectado = false;
             return 0;
         }
+        if (leidos == 0) {
+            metricas.timeoutsLectura.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+
+        // Llegaron bytes pero quiza no el '\n': esperar solo lo que resta
+        long long restante = std::chrono::duration_cast<std::chrono::milliseconds>(
+            limite - std::chrono::steady_clock::now()).count();
+        esperaMs = restante > 0 ? static_cast<int>(restante) : 0;
     }
-    
-    buffer[posicion] = '\0';
-    return posicion;
+}
+
+/**
+ * @brief Busca un '\n' en los bytes del anillo aun no revisados
+ */
+bool SerialPort::hayLineaCompleta() {
+    if (modoBinario) {
+        unsigned char trama[TRAMA_BINARIA_MAXIMA];
+        int n = 0;
+        while (lectura + n != escritura && n < TRAMA_BINARIA_MAXIMA) {
+            trama[n] = static_cast<unsigned char>(anillo[(lectura + n) & (TAMANIO_ANILLO - 1)]);
+            n++;
+        }
+        Trama descartada;
+        int consumidos;
+        return n > 0 && interpretarTramaBinaria(trama, n, &descartada, &consumidos) != BINARIO_INCOMPLETO;
+    }
+
+    while (escaneado != escritura) {
+        if (anillo[escaneado & (TAMANIO_ANILLO - 1)] == '\n') {
+            return true;
+        }
+        escaneado++;
+    }
+    return false;
+}
+
+#ifndef WINDOWS_BUILD
+/**
+ * @brief Descriptor del dispositivo
+ */
+int SerialPort::getDescriptor() const {
+    return fd;
+}
+#endif
+
+/**
+ * @brief Bytes recibidos por el puerto
+ */
+unsigned long long SerialPort::getBytesLeidos() const {
+    return bytesLeidos;
+}
+
+/**
+ * @brief Escribe bytes en el puerto
+ */
+bool SerialPort::escribir(const char* datos, int n) {
+    if (!conectado) return false;
+#ifdef WINDOWS_BUILD
+    DWORD escritos = 0;
+    return WriteFile(hSerial, datos, static_cast<DWORD>(n), &escritos, nullptr)
+           && escritos == static_cast<DWORD>(n);
 #else
-    buffer[0] = '\0';
-    return 0;
+    while (n > 0) {
+        ssize_t escritos = write(fd, datos, static_cast<size_t>(n));
+        if (escritos < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            return false;
+        }
+        datos += escritos;
+        n -= static_cast<int>(escritos);
+    }
+    return true;
 #endif
 }
 
+/**
+ * @brief Envia la solicitud de modo binario
+ */
+bool SerialPort::solicitarModoBinario() {
+    if (modoBinario) return true;
+    solicitudesRestantes = INTENTOS_BINARIO;
+    ultimaSolicitud = std::chrono::steady_clock::now();
+    solicitudesRestantes--;
+    return escribir(SOLICITUD_BINARIO "\n", static_cast<int>(sizeof(SOLICITUD_BINARIO)));
+}
+
+/**
+ * @brief Envia la solicitud de marcas de tiempo
+ */
+bool SerialPort::solicitarMarcasDeTiempo() {
+    return escribir(SOLICITUD_MARCAS "\n", static_cast<int>(sizeof(SOLICITUD_MARCAS)));
+}
+
+/**
+ * @brief Reenvia la solicitud si el ESP32 no contesto a tiempo
+ */
+void SerialPort::reintentarSolicitud() {
+    std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+    if (ahora - ultimaSolicitud < std::chrono::milliseconds(PAUSA_SOLICITUD_MS)) return;
+
+    ultimaSolicitud = ahora;
+    solicitudesRestantes--;
+    escribir(SOLICITUD_BINARIO "\n", static_cast<int>(sizeof(SOLICITUD_BINARIO)));
+    if (solicitudesRestantes == 0 && obtenerNivelDetalle() >= DETALLE_RESUMEN) {
+        Registro(REGISTRO_AVISO) << "Aviso: el ESP32 no confirmo el modo binario; se continua en modo texto\n";
+    }
+}
+
+/**
+ * @brief Entrega la siguiente trama binaria como linea de texto
+ */
+int SerialPort::leerTramaBinaria(char* buffer, int bufferSize, int esperaMs) {
+    std::chrono::steady_clock::time_point limite =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(esperaMs);
+
+    while (true) {
+        // Copiar el inicio del anillo (la trama puede cruzar el final)
+        unsigned char bytes[TRAMA_BINARIA_MAXIMA];
+        int n = 0;
+        while (lectura + n != escritura && n < TRAMA_BINARIA_MAXIMA) {
+            bytes[n] = static_cast<unsigned char>(anillo[(lectura + n) & (TAMANIO_ANILLO - 1)]);
+            n++;
+        }
+
+        Trama trama;
+        int consumidos = 0;
+        ResultadoBinario resultado = interpretarTramaBinaria(bytes, n, &trama, &consumidos);
+
+        if (!sincronizado && resultado != BINARIO_SINCRONIA && resultado != BINARIO_INCOMPLETO) {
+            // Descartar hasta la siguiente marca de sincronia
+            lectura++;
+            bytesDescartados++;
+            continue;
+        }
+
+        if (resultado == BINARIO_TRAMA) {
+            lectura += static_cast<unsigned int>(consumidos);
+            escaneado = lectura;
+            return escribirTrama(trama, buffer, bufferSize);
+        }
+        if (resultado == BINARIO_SINCRONIA) {
+            lectura += static_cast<unsigned int>(consumidos);
+            sincronizado = true;
+            continue;
+        }
+        if (resultado == BINARIO_INVALIDO) {
+            lectura++;
+            bytesDescartados++;
+            sincronizado = false;
+            continue;
+        }
+
+        // Trama incompleta: traer mas bytes
+        if (!conectado) return 0;
+        int leidos = llenarAnillo(esperaMs);
+        if (leidos < 0) {
+            conectado = false;
+            return 0;
+        }
+        if (leidos == 0) {
+            metricas.timeoutsLectura.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+        long long restante = std::chrono::duration_cast<std::chrono::milliseconds>(
+            limite - std::chrono::steady_clock::now()).count();
+        esperaMs = restante > 0 ? static_cast<int>(restante) : 0;
+    }
+}
+
+/**
+ * @brief Indica si el puerto ya recibe tramas binarias
+ */
+bool SerialPort::esModoBinario() const {
+    return modoBinario;
+}
+
+/**
+ * @brief Bytes descartados al resincronizar
+ */
+unsigned long long SerialPort::getBytesDescartados() const {
+    return bytesDescartados;
+}
+
+/**
+ * @brief Cambia la espera maxima de leerLinea()
+ */
+void SerialPort::setTimeoutLectura(int ms) {
+    timeoutLecturaMs = ms < 0 ? 0 : ms;
+}
+
 /**
  * @brief Cierra el puerto serial
  */
@@ -161,7 +527,18 @@ void SerialPort::cerrar() {
     if (conectado) {
         CloseHandle(hSerial);
         conectado = false;
-        std::cout << "Puerto serial cerrado" << std::endl;
+        if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+            std::cout << "Puerto serial cerrado" << std::endl;
+        }
+    }
+#else
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+        conectado = false;
+        if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+            std::cout << "Puerto serial cerrado" << std::endl;
+        }
     }
 #endif
 }
@@ -0,0 +1,298 @@
+/**
+ * @file TablaDeSesiones.cpp
+ * @brief Implementacion de la tabla de sesiones multiplexadas
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "TablaDeSesiones.h"
+#include "NivelDetalle.h"
+#include "Trama.h"
+#include "RegistroAsincrono.h"
+#include <iostream>
+
+/**
+ * @brief Constructor - Tabla vacia con 64 ranuras
+ */
+TablaDeSesiones::TablaDeSesiones()
+    : bits(BITS_INICIALES), activas(0), maximoActivas(0), creadas(0), cerradas(0),
+      primera(nullptr), ultima(nullptr), libres(nullptr), ultimaUsada(nullptr) {
+    int capacidad = 1 << bits;
+    ranuras = new Sesion*[capacidad];
+    for (int i = 0; i < capacidad; i++) {
+        ranuras[i] = nullptr;
+    }
+}
+
+/**
+ * @brief Destructor - Libera las sesiones abiertas y las recicladas
+ */
+TablaDeSesiones::~TablaDeSesiones() {
+    Sesion* actual = primera;
+    while (actual) {
+        Sesion* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+
+    actual = libres;
+    while (actual) {
+        Sesion* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+
+    delete[] ranuras;
+}
+
+/**
+ * @brief Hash de Fibonacci: los bits altos del producto
+ */
+unsigned int TablaDeSesiones::ranuraDe(unsigned int id) const {
+    return (id * 2654435769u) >> (32 - bits);
+}
+
+/**
+ * @brief Duplica la tabla
+ */
+void TablaDeSesiones::crecer() {
+    int capacidadAnterior = 1 << bits;
+    Sesion** anteriores = ranuras;
+
+    bits++;
+    unsigned int mascara = (1u << bits) - 1;
+    ranuras = new Sesion*[mascara + 1];
+    for (unsigned int i = 0; i <= mascara; i++) {
+        ranuras[i] = nullptr;
+    }
+
+    for (int i = 0; i < capacidadAnterior; i++) {
+        if (!anteriores[i]) continue;
+        unsigned int posicion = ranuraDe(anteriores[i]->id);
+        while (ranuras[posicion]) {
+            posicion = (posicion + 1) & mascara;
+        }
+        ranuras[posicion] = anteriores[i];
+    }
+
+    delete[] anteriores;
+}
+
+/**
+ * @brief Busca una sesion abierta
+ */
+Sesion* TablaDeSesiones::buscar(unsigned int id) {
+    if (ultimaUsada && ultimaUsada->id == id) {
+        return ultimaUsada;
+    }
+
+    unsigned int mascara = (1u << bits) - 1;
+    unsigned int posicion = ranuraDe(id);
+    while (ranuras[posicion]) {
+        if (ranuras[posicion]->id == id) {
+            ultimaUsada = ranuras[posicion];
+            return ultimaUsada;
+        }
+        posicion = (posicion + 1) & mascara;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Busca una sesion y la abre si no existe
+ */
+Sesion* TablaDeSesiones::obtener(unsigned int id) {
+    Sesion* sesion = buscar(id);
+    if (sesion) return sesion;
+
+    // Mantener la ocupacion por debajo del 50%
+    if (2 * (activas + 1) > (1 << bits)) {
+        crecer();
+    }
+
+    // Reutilizar un nodo cerrado (sus bloques ya volvieron a su pool)
+    if (libres) {
+        sesion = libres;
+        libres = libres->siguiente;
+    } else {
+        sesion = new Sesion;
+    }
+    sesion->id = id;
+    sesion->tramas = 0;
+    sesion->numPendiente = 0;
+    sesion->rotor.setDesplazamiento(0);
+
+    // Agregar al final de la lista de sesiones abiertas
+    sesion->anterior = ultima;
+    sesion->siguiente = nullptr;
+    if (ultima) {
+        ultima->siguiente = sesion;
+    } else {
+        primera = sesion;
+    }
+    ultima = sesion;
+
+    unsigned int mascara = (1u << bits) - 1;
+    unsigned int posicion = ranuraDe(id);
+    while (ranuras[posicion]) {
+        posicion = (posicion + 1) & mascara;
+    }
+    ranuras[posicion] = sesion;
+
+    activas++;
+    creadas++;
+    if (activas > maximoActivas) {
+        maximoActivas = activas;
+    }
+    ultimaUsada = sesion;
+    return sesion;
+}
+
+/**
+ * @brief Quita una sesion de la tabla y recicla su nodo
+ */
+void TablaDeSesiones::cerrar(Sesion* sesion) {
+    unsigned int mascara = (1u << bits) - 1;
+    unsigned int hueco = ranuraDe(sesion->id);
+    while (ranuras[hueco] != sesion) {
+        hueco = (hueco + 1) & mascara;
+    }
+    ranuras[hueco] = nullptr;
+
+    // Recorrer hacia el hueco las entradas que lo necesitan para ser encontradas
+    unsigned int j = hueco;
+    while (true) {
+        j = (j + 1) & mascara;
+        if (!ranuras[j]) break;
+        unsigned int inicio = ranuraDe(ranuras[j]->id);
+        if (((j - inicio) & mascara) >= ((j - hueco) & mascara)) {
+            ranuras[hueco] = ranuras[j];
+            ranuras[j] = nullptr;
+            hueco = j;
+        }
+    }
+
+    // Sacar de la lista de sesiones abiertas
+    if (sesion->anterior) {
+        sesion->anterior->siguiente = sesion->siguiente;
+    } else {
+        primera = sesion->siguiente;
+    }
+    if (sesion->siguiente) {
+        sesion->siguiente->anterior = sesion->anterior;
+    } else {
+        ultima = sesion->anterior;
+    }
+
+    if (ultimaUsada == sesion) {
+        ultimaUsada = nullptr;
+    }
+
+    sesion->carga.vaciar();
+    sesion->anterior = nullptr;
+    sesion->siguiente = libres;
+    libres = sesion;
+
+    activas--;
+    cerradas++;
+}
+
+/**
+ * @brief Sesion abierta mas antigua
+ */
+Sesion* TablaDeSesiones::getPrimera() const {
+    return primera;
+}
+
+/**
+ * @brief Sesiones abiertas
+ */
+int TablaDeSesiones::getActivas() const {
+    return activas;
+}
+
+/**
+ * @brief Mayor numero de sesiones abiertas a la vez
+ */
+int TablaDeSesiones::getMaximoActivas() const {
+    return maximoActivas;
+}
+
+/**
+ * @brief Sesiones abiertas desde el inicio
+ */
+unsigned long long TablaDeSesiones::getCreadas() const {
+    return creadas;
+}
+
+/**
+ * @brief Sesiones cerradas
+ */
+unsigned long long TablaDeSesiones::getCerradas() const {
+    return cerradas;
+}
+
+/**
+ * @brief Aplica una trama a la sesion
+ */
+void TablaDeSesiones::aplicar(Sesion* sesion, const Trama& trama) {
+    sesion->tramas++;
+
+    // Con trazas: mismo eco por trama que el bucle principal
+    if (obtenerNivelDetalle() >= DETALLE_TRAMA) {
+        completar(sesion);
+        procesarTrama(trama, &sesion->carga, &sesion->rotor);
+        return;
+    }
+
+    if (trama.tipo == TRAMA_LOAD && trama.longitud > 1) {
+        // Rafaga: decodificar por tramos directo al buffer pendiente
+        const char* texto = trama.texto;
+        int restantes = trama.longitud;
+        while (restantes > 0) {
+            int libres = Sesion::TAMANIO_PENDIENTE - sesion->numPendiente;
+            int tramo = restantes < libres ? restantes : libres;
+            sesion->rotor.decodificarBloque(texto, sesion->pendiente + sesion->numPendiente, tramo);
+            sesion->numPendiente += tramo;
+            if (sesion->numPendiente == Sesion::TAMANIO_PENDIENTE) {
+                completar(sesion);
+            }
+            texto += tramo;
+            restantes -= tramo;
+        }
+    } else if (trama.tipo == TRAMA_LOAD) {
+        sesion->pendiente[sesion->numPendiente++] = sesion->rotor.getMapeo(trama.caracter);
+        if (sesion->numPendiente == Sesion::TAMANIO_PENDIENTE) {
+            completar(sesion);
+        }
+    } else if (trama.tipo == TRAMA_MAP) {
+        // Lo pendiente ya se decodifico con el rotor anterior
+        sesion->rotor.rotar(trama.rotacion);
+    }
+}
+
+/**
+ * @brief Pasa los caracteres pendientes a la lista
+ */
+void TablaDeSesiones::completar(Sesion* sesion) {
+    if (sesion->numPendiente == 0) return;
+    sesion->carga.insertarBloque(sesion->pendiente, sesion->numPendiente);
+    sesion->numPendiente = 0;
+}
+
+/**
+ * @brief Imprime el mensaje de una sesion
+ */
+void TablaDeSesiones::imprimirSesion(Sesion* sesion, bool completa) {
+    completar(sesion);
+    sesion->rotor.emitirRotacionPendiente();
+    // Las trazas de las tramas anteriores salen antes que el mensaje
+    vaciarRegistro();
+    if (obtenerNivelDetalle() != DETALLE_SILENCIOSO) {
+        std::cout << std::endl << "[sesion " << sesion->id << "] " << sesion->tramas << " tramas"
+                  << (completa ? "" : " (sin FIN)") << std::endl;
+    } else {
+        std::cout << "#" << sesion->id << ": ";
+    }
+    sesion->carga.imprimirMensaje();
+}
@@ -0,0 +1,308 @@
+/**
+ * @file Trama.cpp
+ * @brief Parser y despacho de tramas PRT-7 por valor
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "Trama.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "NivelDetalle.h"
+#include "LatenciaPorEtapa.h"
+#include "TrazaEventos.h"
+#include "MetricasDecodificador.h"
+#include "RegistroAsincrono.h"
+#include <cstdio>
+
+/**
+ * @brief Clasifica y parsea una linea (sin E/S)
+ */
+ResultadoLinea interpretarTrama(const char* linea, Trama* trama) {
+    trama->tipo = TRAMA_NINGUNA;
+    trama->sesion = 0;
+    trama->conMarca = false;
+
+    // Marca de tiempo opcional del emisor: "@<us>," (hasta 10 digitos, modulo 2^32),
+    // solo con --latencia-enlace; una marca mal formada se toma como banner
+    if (linea[0] == '@' && obtenerMarcasDeTiempo()) {
+        unsigned int marca = 0;
+        int i = 1;
+        while (linea[i] >= '0' && linea[i] <= '9' && i <= 10) {
+            marca = marca * 10 + static_cast<unsigned int>(linea[i] - '0');
+            i++;
+        }
+        if (i == 1 || linea[i] != ',') {
+            return LINEA_IGNORADA;
+        }
+        trama->conMarca = true;
+        trama->marca = marca;
+        linea += i + 1;
+    }
+
+    // Prefijo de sesion opcional: "#<id>," (hasta 9 digitos), solo con --sesiones
+    if (linea[0] == '#' && obtenerSesionesMultiplexadas()) {
+        unsigned int sesion = 0;
+        int i = 1;
+        while (linea[i] >= '0' && linea[i] <= '9' && i <= 9) {
+            sesion = sesion * 10 + static_cast<unsigned int>(linea[i] - '0');
+            i++;
+        }
+        if (i == 1 || linea[i] != ',') {
+            trama->caracter = '#';
+            return LINEA_DESCONOCIDA;
+        }
+        trama->sesion = sesion;
+        linea += i + 1;
+    }
+
+    // Verificar que la linea no este vacia
+    if (linea[0] == '\0') {
+        return LINEA_VACIA;
+    }
+
+    // Verificar si es trama de fin
+    if (linea[0] == 'F' && linea[1] == 'I' && linea[2] == 'N') {
+        trama->tipo = TRAMA_FIN;
+        return LINEA_VALIDA;
+    }
+
+    // Verificar formato minimo: "X,Y"
+    if (linea[1] == '\0' || linea[2] == '\0') {
+        return LINEA_CORTA;
+    }
+
+    // Extraer el tipo de trama (primer caracter)
+    char tipo = linea[0];
+
+    // Verificar que el segundo caracter sea una coma
+    if (linea[1] != ',') {
+        // Ignorar silenciosamente (probablemente es texto del banner del ESP32)
+        return LINEA_IGNORADA;
+    }
+
+    // Extraer el dato (despues de la coma)
+    const char* dato = &linea[2];
+
+    if (tipo == 'L') {
+        // Trama LOAD: L,<caracter> o rafaga L,<caracteres>
+        trama->tipo = TRAMA_LOAD;
+        trama->caracter = dato[0];
+        trama->texto = dato;
+        int longitud = 1;
+        while (dato[longitud] != '\0') {
+            longitud++;
+        }
+        trama->longitud = longitud;
+
+    } else if (tipo == 'M') {
+        // Trama MAP: M,<numero>
+        // Convertir el string a int manualmente (atoi casero)
+        int numero = 0;
+        int signo = 1;
+        int i = 0;
+
+        // Verificar signo
+        if (dato[0] == '-') {
+            signo = -1;
+            i = 1;
+        } else if (dato[0] == '+') {
+            i = 1;
+        }
+
+        // Convertir digitos
+        while (dato[i] >= '0' && dato[i] <= '9') {
+            numero = numero * 10 + (dato[i] - '0');
+            i++;
+        }
+
+        trama->tipo = TRAMA_MAP;
+        trama->rotacion = numero * signo;
+
+    } else {
+        trama->caracter = tipo;
+        return LINEA_DESCONOCIDA;
+    }
+
+    return LINEA_VALIDA;
+}
+
+/**
+ * @brief Parsea una linea en una Trama por valor
+ */
+bool parsearTrama(const char* linea, Trama* trama) {
+    switch (interpretarTrama(linea, trama)) {
+        case LINEA_VALIDA:
+            break;
+        case LINEA_CORTA:
+            metricas.lineasCortas.fetch_add(1, std::memory_order_relaxed);
+            Registro(REGISTRO_AVISO) << "Trama invalida (muy corta): " << linea << "\n";
+            return false;
+        case LINEA_DESCONOCIDA:
+            metricas.lineasDesconocidas.fetch_add(1, std::memory_order_relaxed);
+            Registro(REGISTRO_AVISO) << "Tipo de trama desconocido: " << trama->caracter << "\n";
+            return false;
+        case LINEA_IGNORADA:
+            metricas.lineasIgnoradas.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        default:
+            return false;
+    }
+
+    // Con rotacion diferida los MAP no dejan traza propia (ver RotorDeMapeo::rotar)
+    bool conTraza = trama->tipo != TRAMA_FIN
+                    && !(trama->tipo == TRAMA_MAP && obtenerRotacionDiferida());
+    if (conTraza && obtenerNivelDetalle() >= DETALLE_TRAMA) {
+        Registro(REGISTRO_TRAZA) << "\nTrama recibida: [" << linea << "] -> Procesando... -> ";
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe una trama como linea de texto
+ */
+int escribirTrama(const Trama& trama, char* destino, int capacidad) {
+    if (capacidad <= 0) return 0;
+
+    char linea[32];
+    int n = 0;
+    if (trama.sesion != 0) {
+        n = std::sprintf(linea, "#%u,", trama.sesion);
+    }
+
+    switch (trama.tipo) {
+        case TRAMA_LOAD:
+            linea[n++] = 'L';
+            linea[n++] = ',';
+            if (trama.longitud > 1) {
+                // Rafaga: copiar directo al destino, truncando si no cabe
+                int total = n + trama.longitud;
+                if (total > capacidad - 1) total = capacidad - 1;
+                for (int i = 0; i < total; i++) {
+                    destino[i] = i < n ? linea[i] : trama.texto[i - n];
+                }
+                destino[total] = '\0';
+                return total;
+            }
+            linea[n++] = trama.caracter;
+            break;
+        case TRAMA_MAP:
+            n += std::sprintf(linea + n, "M,%d", trama.rotacion);
+            break;
+        case TRAMA_FIN:
+            linea[n++] = 'F';
+            linea[n++] = 'I';
+            linea[n++] = 'N';
+            break;
+        default:
+            destino[0] = '\0';
+            return 0;
+    }
+
+    if (n > capacidad - 1) n = capacidad - 1;
+    for (int i = 0; i < n; i++) {
+        destino[i] = linea[i];
+    }
+    destino[n] = '\0';
+    return n;
+}
+
+/**
+ * @brief Parsea una linea y crea el objeto trama correspondiente (adaptador)
+ */
+TramaBase* parsearTrama(char* linea) {
+    Trama trama;
+    if (!parsearTrama(linea, &trama)) {
+        return nullptr;
+    }
+    return crearTramaPolimorfica(trama);
+}
+
+/**
+ * @brief Decodifica una rafaga de caracteres y la agrega como bloque
+ */
+void cargarRafaga(const char* texto, int longitud, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    const int TRAMO = 256;
+    char decodificado[TRAMO];
+    bool conTraza = obtenerNivelDetalle() >= DETALLE_TRAMA;
+    LATENCIA_EN_CURSO(muestra);
+
+    for (int hecho = 0; hecho < longitud; hecho += TRAMO) {
+        int n = longitud - hecho < TRAMO ? longitud - hecho : TRAMO;
+        LATENCIA_MARCA(muestra, antes);
+        rotor->decodificarBloque(texto + hecho, decodificado, n);
+        LATENCIA_MARCA(muestra, decodificada);
+        LATENCIA_ETAPA(muestra, ETAPA_DECODIFICACION, antes, decodificada);
+
+        if (conTraza) {
+            Registro traza(REGISTRO_TRAZA);
+            traza << "Fragmento '";
+            traza.escribir(texto + hecho, n);
+            traza << "' decodificado como '";
+            traza.escribir(decodificado, n);
+            traza << "'. ";
+        }
+        carga->insertarBloque(decodificado, n);
+        LATENCIA_MARCA(muestra, insertada);
+        LATENCIA_ETAPA(muestra, ETAPA_INSERCION, decodificada, insertada);
+    }
+}
+
+/**
+ * @brief Aplica una trama al decodificador (mismo efecto que TramaBase::procesar)
+ */
+void procesarTrama(const Trama& trama, ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    LATENCIA_EN_CURSO(muestra);
+    TRAZA_MARCA(trazaInicio);
+    switch (trama.tipo) {
+        case TRAMA_LOAD: {
+            // Decodificar el caracter y almacenarlo (ver TramaLoad::procesar)
+            if (obtenerNivelDetalle() >= DETALLE_TRAMA) {
+                rotor->emitirRotacionPendiente();
+            }
+            if (trama.longitud > 1) {
+                cargarRafaga(trama.texto, trama.longitud, carga, rotor);
+            } else {
+                LATENCIA_MARCA(muestra, antes);
+                char decodificado = rotor->getMapeo(trama.caracter);
+                LATENCIA_MARCA(muestra, decodificada);
+                carga->insertarAlFinal(decodificado);
+                LATENCIA_MARCA(muestra, insertada);
+                LATENCIA_ETAPA(muestra, ETAPA_DECODIFICACION, antes, decodificada);
+                LATENCIA_ETAPA(muestra, ETAPA_INSERCION, decodificada, insertada);
+            }
+            TRAZA_MARCA(trazaFin);
+            TRAZA_TRAMO("insercion", trazaInicio, trazaFin);
+            break;
+        }
+        case TRAMA_MAP: {
+            // Solo rotar el rotor (ver TramaMap::procesar)
+            LATENCIA_MARCA(muestra, antes);
+            rotor->rotar(trama.rotacion);
+            LATENCIA_MARCA(muestra, rotada);
+            LATENCIA_ETAPA(muestra, ETAPA_DECODIFICACION, antes, rotada);
+            TRAZA_MARCA(trazaFin);
+            TRAZA_TRAMO("rotor", trazaInicio, trazaFin);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Crea el objeto polimorfico equivalente
+ */
+TramaBase* crearTramaPolimorfica(const Trama& trama) {
+    if (trama.tipo == TRAMA_LOAD) {
+        if (trama.longitud > 1) {
+            return new TramaLoad(trama.texto, trama.longitud);
+        }
+        return new TramaLoad(trama.caracter);
+    } else if (trama.tipo == TRAMA_MAP) {
+        return new TramaMap(trama.rotacion);
+    }
+    return nullptr;
+}
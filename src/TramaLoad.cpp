@@ -8,19 +8,31 @@
 #include "TramaLoad.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "NivelDetalle.h"
+#include "Trama.h"
+#include "TrazaEventos.h"
 
 /**
  * @brief Constructor de TramaLoad
  */
-TramaLoad::TramaLoad(char c) : dato(c) {
+TramaLoad::TramaLoad(char c) : dato(c), rafaga(nullptr), longitud(1) {
     // Inicializa el dato a decodificar
 }
 
+/**
+ * @brief Constructor de TramaLoad para una rafaga
+ */
+TramaLoad::TramaLoad(const char* texto, int n) : dato(texto[0]), rafaga(new char[n]), longitud(n) {
+    for (int i = 0; i < n; i++) {
+        rafaga[i] = texto[i];
+    }
+}
+
 /**
  * @brief Destructor de TramaLoad
  */
 TramaLoad::~TramaLoad() {
-    // No hay recursos dinamicos que liberar en esta clase
+    delete[] rafaga;
 }
 
 /**
@@ -32,9 +44,24 @@ TramaLoad::~TramaLoad() {
  * 3. Insertar el caracter decodificado en la lista de carga
  */
 void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
-    // Obtener el caracter decodificado usando el rotor
-    char decodificado = rotor->getMapeo(dato);
-    
-    // Insertar el caracter decodificado en la lista de carga
-    carga->insertarAlFinal(decodificado);
+    TRAZA_MARCA(trazaInicio);
+
+    // Traza agrupada de los MAP anteriores (rotacion diferida)
+    if (obtenerNivelDetalle() >= DETALLE_TRAMA) {
+        rotor->emitirRotacionPendiente();
+    }
+
+    // Rafaga: una pasada por el rotor y un solo bloque en la lista
+    if (rafaga) {
+        cargarRafaga(rafaga, longitud, carga, rotor);
+    } else {
+        // Obtener el caracter decodificado usando el rotor
+        char decodificado = rotor->getMapeo(dato);
+
+        // Insertar el caracter decodificado en la lista de carga
+        carga->insertarAlFinal(decodificado);
+    }
+
+    TRAZA_MARCA(trazaFin);
+    TRAZA_TRAMO("insercion", trazaInicio, trazaFin);
 }
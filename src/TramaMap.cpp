@@ -8,6 +8,7 @@
 #include "TramaMap.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "TrazaEventos.h"
 
 /**
  * @brief Constructor de TramaMap
@@ -34,5 +35,8 @@ TramaMap::~TramaMap() {
 void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     // La lista de carga no se usa en tramas MAP (parametro ignorado)
     // Solo rotamos el rotor
+    TRAZA_MARCA(trazaInicio);
     rotor->rotar(rotacion);
+    TRAZA_MARCA(trazaFin);
+    TRAZA_TRAMO("rotor", trazaInicio, trazaFin);
 }
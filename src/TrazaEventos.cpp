@@ -0,0 +1,153 @@
+/**
+ * @file TrazaEventos.cpp
+ * @brief Implementacion de la traza de eventos (buffers por hilo y escritura del JSON)
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "TrazaEventos.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+/**
+ * @struct EventoTraza
+ * @brief Un tramo completo ("ph":"X")
+ */
+struct EventoTraza {
+    const char* nombre;             ///< Nombre estatico del tramo
+    unsigned long long inicio;      ///< Marca al entrar (ns)
+    unsigned long long duracion;    ///< Nanosegundos
+};
+
+/**
+ * @struct BufferTraza
+ * @brief Eventos de un hilo (solo ese hilo escribe en el)
+ */
+struct BufferTraza {
+    EventoTraza* eventos;           ///< Capacidad eventos preasignados
+    int usados;                     ///< Eventos registrados
+    int capacidad;                  ///< Tamanio de eventos
+    unsigned long long perdidos;    ///< Eventos que no cupieron
+    int hilo;                       ///< Numero de hilo en la traza (tid)
+    char nombre[32];                ///< Nombre del hilo en la traza
+    BufferTraza* siguiente;         ///< Lista de todos los buffers
+};
+
+bool trazandoEventos = false;
+
+/// Buffers de todos los hilos que trazaron (los hilos pueden haber terminado)
+static BufferTraza* buffers = nullptr;
+static int hilosTrazados = 0;               ///< Ultimo tid asignado
+static int capacidadPorHilo = 0;            ///< Eventos por buffer nuevo
+static unsigned long long origenTraza = 0;  ///< Marca del instante 0 de la traza
+static std::mutex mutexBuffers;             ///< Protege la lista y los contadores
+
+/// Buffer del hilo llamador
+static thread_local BufferTraza* bufferHilo = nullptr;
+
+/**
+ * @brief Empieza a registrar
+ */
+void habilitarTrazaEventos(int capacidad) {
+    capacidadPorHilo = capacidad > 0 ? capacidad : CAPACIDAD_TRAZA_POR_HILO;
+    origenTraza = marcaTraza();
+    trazandoEventos = true;
+}
+
+/**
+ * @brief Reserva y enlaza el buffer del hilo llamador
+ */
+static BufferTraza* crearBufferHilo() {
+    BufferTraza* buffer = new BufferTraza();
+    buffer->eventos = new EventoTraza[capacidadPorHilo];
+    // Tocar las paginas ahora y no en medio de la decodificacion
+    std::memset(buffer->eventos, 0, sizeof(EventoTraza) * static_cast<size_t>(capacidadPorHilo));
+    buffer->usados = 0;
+    buffer->capacidad = capacidadPorHilo;
+    buffer->perdidos = 0;
+
+    std::lock_guard<std::mutex> bloqueo(mutexBuffers);
+    buffer->hilo = ++hilosTrazados;
+    std::snprintf(buffer->nombre, sizeof(buffer->nombre), "hilo %d", buffer->hilo);
+    buffer->siguiente = buffers;
+    buffers = buffer;
+    return buffer;
+}
+
+/**
+ * @brief Nombra el hilo llamador
+ */
+void nombrarHiloTraza(const char* nombre) {
+    if (!trazandoEventos) return;
+    if (bufferHilo == nullptr) bufferHilo = crearBufferHilo();
+    std::snprintf(bufferHilo->nombre, sizeof(bufferHilo->nombre), "%s", nombre);
+}
+
+/**
+ * @brief Registra un tramo del hilo llamador
+ */
+void registrarTramo(const char* nombre, unsigned long long desde, unsigned long long hasta) {
+    BufferTraza* buffer = bufferHilo;
+    if (buffer == nullptr) buffer = bufferHilo = crearBufferHilo();
+
+    if (buffer->usados == buffer->capacidad) {
+        buffer->perdidos++;
+        return;
+    }
+    EventoTraza& evento = buffer->eventos[buffer->usados++];
+    evento.nombre = nombre;
+    evento.inicio = desde;
+    evento.duracion = hasta - desde;
+}
+
+/**
+ * @brief Eventos que no cupieron
+ */
+unsigned long long getEventosTrazaPerdidos() {
+    std::lock_guard<std::mutex> bloqueo(mutexBuffers);
+    unsigned long long perdidos = 0;
+    for (BufferTraza* buffer = buffers; buffer; buffer = buffer->siguiente) {
+        perdidos += buffer->perdidos;
+    }
+    return perdidos;
+}
+
+/**
+ * @brief Escribe el JSON trace-event
+ *
+ * Formato "JSON Object": metadatos con el nombre del proceso y de cada hilo
+ * y un evento "X" por tramo; ts y dur van en microsegundos con tres
+ * decimales (resolucion de nanosegundos).
+ */
+bool escribirTrazaEventos(const char* ruta) {
+    FILE* archivo = std::fopen(ruta, "wb");
+    if (!archivo) return false;
+
+    static char bufferSalida[1 << 16];
+    std::setvbuf(archivo, bufferSalida, _IOFBF, sizeof(bufferSalida));
+
+    std::lock_guard<std::mutex> bloqueo(mutexBuffers);
+    std::fprintf(archivo, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                          "\"args\":{\"name\":\"DecodificadorPRT7\"}}");
+
+    unsigned long long perdidos = 0;
+    for (BufferTraza* buffer = buffers; buffer; buffer = buffer->siguiente) {
+        std::fprintf(archivo, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                              "\"args\":{\"name\":\"%s\"}}", buffer->hilo, buffer->nombre);
+        perdidos += buffer->perdidos;
+
+        for (int i = 0; i < buffer->usados; i++) {
+            const EventoTraza& evento = buffer->eventos[i];
+            unsigned long long inicio = evento.inicio - origenTraza;
+            std::fprintf(archivo, ",\n{\"name\":\"%s\",\"cat\":\"trama\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                                  "\"ts\":%llu.%03llu,\"dur\":%llu.%03llu}",
+                         evento.nombre, buffer->hilo, inicio / 1000, inicio % 1000,
+                         evento.duracion / 1000, evento.duracion % 1000);
+        }
+    }
+
+    std::fprintf(archivo, "\n],\"otherData\":{\"eventos_perdidos\":\"%llu\"}}\n", perdidos);
+    return std::fclose(archivo) == 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file TuberiaDecodificacion.cpp
+ * @brief Implementacion de la tuberia lectura -> decodificacion
+ * @author Elias de Jesus Zuniga de Leon
+ * @date 2025-11-06
+ */
+
+#include "TuberiaDecodificacion.h"
+#include "FuenteDeTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "Trama.h"
+#include "MetricasDecodificador.h"
+#include "TrazaEventos.h"
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+/**
+ * @brief Constructor - No arranca hilos hasta ejecutar()
+ */
+TuberiaDecodificacion::TuberiaDecodificacion(FuenteDeTramas* fuente, ListaDeCarga* carga, RotorDeMapeo* rotor,
+                                             PoliticaColaLlena politica)
+    : fuente(fuente), carga(carga), rotor(rotor), politica(politica), tramasProcesadas(0),
+      detener(false), lecturaTerminada(false), consumidorDormido(false), productorDormido(false),
+      lineasLeidas(0), colaLlena(0) {
+}
+
+/**
+ * @brief Destructor - Espera al hilo de E/S
+ */
+TuberiaDecodificacion::~TuberiaDecodificacion() {
+    detener.store(true);
+    if (hiloLectura.joinable()) {
+        hiloLectura.join();
+    }
+}
+
+/**
+ * @brief Hilo de E/S: lee lineas directo a las ranuras de la cola
+ */
+void TuberiaDecodificacion::leerFuente() {
+    nombrarHiloTraza("lector");
+    while (!detener.load(std::memory_order_relaxed)) {
+        // Leer directamente en la ranura libre (o en 'descarte' si no hay)
+        LineaRecibida* ranura = cola.reservarEscritura();
+        char* destino = ranura ? ranura->texto : descarte;
+
+        TRAZA_MARCA(trazaAntes);
+        int n = fuente->leerLinea(destino, LineaRecibida::TAMANIO);
+        TRAZA_MARCA(trazaLeida);
+        TRAZA_TRAMO("lectura", trazaAntes, trazaLeida);
+        metricas.publicarFuente(fuente->getBytesLeidos());
+
+        if (n > 0) {
+            lineasLeidas.fetch_add(1, std::memory_order_relaxed);
+
+            // La linea llego con la cola llena: esperar o descartar segun la politica
+            if (!ranura) {
+                // FIN nunca se descarta, tambien con marca de tiempo o prefijo de sesion
+                Trama clasificada;
+                bool esFin = interpretarTrama(descarte, &clasificada) == LINEA_VALIDA
+                             && clasificada.tipo == TRAMA_FIN;
+                ranura = ranuraConColaLlena(esFin);
+                if (ranura) std::memcpy(ranura->texto, descarte, n + 1);
+            }
+
+            if (ranura) {
+                ranura->longitud = n;
+                cola.confirmarEscritura();
+                despertarDecodificador();
+            } else {
+                cola.registrarDescarte();
+            }
+        }
+
+        if (!fuente->estaConectado()) {
+            break;
+        }
+    }
+
+    lecturaTerminada.store(true);
+    despertarDecodificador();
+}
+
+/**
+ * @brief Ranura para una linea que llego con la cola llena
+ */
+LineaRecibida* TuberiaDecodificacion::ranuraConColaLlena(bool obligatoria) {
+    // La cola pudo vaciarse mientras se leia
+    LineaRecibida* ranura = cola.reservarEscritura();
+    if (ranura) return ranura;
+
+    colaLlena.fetch_add(1, std::memory_order_relaxed);
+    if (politica == COLA_DESCARTAR && !obligatoria) {
+        return nullptr;
+    }
+
+    // Mientras se espera, los bytes siguientes quedan en el driver del puerto
+    while (!(ranura = cola.reservarEscritura())) {
+        if (detener.load()) return nullptr;
+        esperarEspacio();
+    }
+    return ranura;
+}
+
+/**
+ * @brief Despierta al decodificador solo si esta dormido
+ */
+void TuberiaDecodificacion::despertarDecodificador() {
+    // Ordena la publicacion de la linea antes de consultar la bandera
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (consumidorDormido.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> candado(mutexAviso);
+        avisoLineas.notify_one();
+    }
+}
+
+/**
+ * @brief Despierta al hilo de E/S solo si espera espacio
+ */
+void TuberiaDecodificacion::despertarLector() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (productorDormido.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> candado(mutexAviso);
+        avisoEspacio.notify_one();
+    }
+}
+
+/**
+ * @brief Duerme hasta que haya lineas (con un limite por si se pierde un aviso)
+ */
+void TuberiaDecodificacion::esperarLineas() {
+    std::unique_lock<std::mutex> candado(mutexAviso);
+    consumidorDormido.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (cola.getProfundidad() == 0 && !lecturaTerminada.load()) {
+        avisoLineas.wait_for(candado, std::chrono::milliseconds(100));
+    }
+
+    consumidorDormido.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Duerme hasta que haya una ranura libre (con el mismo limite)
+ */
+void TuberiaDecodificacion::esperarEspacio() {
+    std::unique_lock<std::mutex> candado(mutexAviso);
+    productorDormido.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (cola.getProfundidad() == CAPACIDAD_COLA && !detener.load()) {
+        avisoEspacio.wait_for(candado, std::chrono::milliseconds(100));
+    }
+
+    productorDormido.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ejecuta la tuberia; el hilo llamador es el decodificador
+ */
+bool TuberiaDecodificacion::ejecutar() {
+    nombrarHiloTraza("decodificador");
+    hiloLectura = std::thread(&TuberiaDecodificacion::leerFuente, this);
+
+    Trama trama;
+    bool finRecibido = false;
+    unsigned int lineasSinPublicar = 0;
+
+    while (!finRecibido) {
+        LineaRecibida* linea = cola.frenteLectura();
+
+        if (!linea) {
+            // Sin lineas: terminar si el lector ya acabo, si no dormir
+            if (lecturaTerminada.load() && cola.getProfundidad() == 0) {
+                break;
+            }
+            metricas.publicarMensaje(carga->getTamanio(), rotor->getDesplazamiento());
+            esperarLineas();
+            continue;
+        }
+
+        TRAZA_MARCA(trazaAntes);
+        bool valida = parsearTrama(linea->texto, &trama);
+        TRAZA_MARCA(trazaParseada);
+        TRAZA_TRAMO("parseo", trazaAntes, trazaParseada);
+
+        if (valida) {
+            tramasProcesadas++;
+            metricas.contarTrama(trama.tipo);
+            if (trama.tipo == TRAMA_FIN) {
+                finRecibido = true;
+            } else {
+                procesarTrama(trama, carga, rotor);
+            }
+        }
+
+        cola.liberarLectura();
+        despertarLector();
+
+        if (++lineasSinPublicar >= MetricasDecodificador::PERIODO_PUBLICACION) {
+            lineasSinPublicar = 0;
+            metricas.publicarMensaje(carga->getTamanio(), rotor->getDesplazamiento());
+        }
+    }
+
+    // MAP justo antes de FIN (o del fin del flujo): no queda LOAD que emita su traza
+    rotor->emitirRotacionPendiente();
+
+    // Ninguna fuente bloquea sin limite (timeout del puerto, poll() en tuberias),
+    // asi que el lector ve 'detener' aunque el emisor ya no mande nada tras FIN
+    detener.store(true);
+    despertarLector();
+    hiloLectura.join();
+    return finRecibido;
+}
+
+/**
+ * @brief Lineas leidas de la fuente
+ */
+unsigned long long TuberiaDecodificacion::getLineasLeidas() const {
+    return lineasLeidas.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Tramas validas decodificadas
+ */
+unsigned long long TuberiaDecodificacion::getTramasProcesadas() const {
+    return tramasProcesadas;
+}
+
+/**
+ * @brief Lineas descartadas por cola llena
+ */
+unsigned long long TuberiaDecodificacion::getLineasDescartadas() const {
+    return cola.getDescartados();
+}
+
+/**
+ * @brief Veces que la cola estaba llena
+ */
+unsigned long long TuberiaDecodificacion::getVecesColaLlena() const {
+    return colaLlena.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Profundidad actual de la cola
+ */
+unsigned int TuberiaDecodificacion::getProfundidadCola() const {
+    return cola.getProfundidad();
+}
+
+/**
+ * @brief Profundidad maxima de la cola
+ */
+unsigned int TuberiaDecodificacion::getProfundidadMaxima() const {
+    return cola.getProfundidadMaxima();
+}
+
+/**
+ * @brief Imprime los contadores de la tuberia
+ */
+void TuberiaDecodificacion::imprimirEstadisticas() const {
+    std::cout << "Tuberia: " << getLineasLeidas() << " lineas leidas, profundidad maxima "
+              << getProfundidadMaxima() << "/" << CAPACIDAD_COLA << ", cola llena "
+              << getVecesColaLlena() << " veces, " << getLineasDescartadas() << " descartadas" << std::endl;
+}
@@ -7,172 +7,759 @@
 
 #include <iostream>
 #include <cstring>
-#include "SerialPort.h"
-#include "TramaBase.h"
-#include "TramaLoad.h"
-#include "TramaMap.h"
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <csignal>
+#include "FuenteDeTramas.h"
+#include "Trama.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "NivelDetalle.h"
+#include "TuberiaDecodificacion.h"
+#include "FuenteMapeada.h"
+#include "DecodificadorParalelo.h"
+#include "DecodificadorMultipuerto.h"
+#include "TablaDeSesiones.h"
+#include "LatenciaPorEtapa.h"
+#include "MetricasDecodificador.h"
+#include "ExportadorMetricas.h"
+#include "RegistroAsincrono.h"
+#include "TrazaEventos.h"
+#include "LatenciaEnlace.h"
+#include "FuenteGrabada.h"
+#include "FuenteCaptura.h"
+#include "DiarioDeDecodificacion.h"
 
-// Configuracion del puerto COM (CAMBIAR SEGUN TU SISTEMA)
+#ifndef WINDOWS_BUILD
+#include <signal.h>
+#endif
+
+// Configuracion del puerto por defecto (CAMBIAR SEGUN TU SISTEMA o usar --puerto=)
+#ifdef WINDOWS_BUILD
 const char* PUERTO_COM = "COM9";
+#else
+const char* PUERTO_COM = "/dev/ttyUSB0";
+#endif
+
+/// Tramas por muestra de --latencias sin valor
+const unsigned int PERIODO_LATENCIAS = 64;
+
+/// Solicitudes de marcas de tiempo mientras no llegue ninguna trama con marca
+const int INTENTOS_MARCAS = 3;
+
+/// Ultima senal recibida con --latencias, --traza o --diario (0 = ninguna pendiente)
+static volatile std::sig_atomic_t senalPendiente = 0;
+
+/**
+ * @brief Anota la senal; el bucle principal la atiende entre dos tramas
+ */
+static void anotarSenal(int senal) {
+    senalPendiente = senal;
+}
+
+/**
+ * @brief Instala anotarSenal() para una senal
+ *
+ * Con sigaction() y sin SA_RESTART (std::signal() lo pone en glibc): una
+ * lectura bloqueada vuelve con EINTR y el bucle ve la senal enseguida, no
+ * hasta la siguiente linea.
+ */
+static void instalarSenal(int senal) {
+#ifdef WINDOWS_BUILD
+    std::signal(senal, anotarSenal);
+#else
+    struct sigaction accion;
+    std::memset(&accion, 0, sizeof(accion));
+    accion.sa_handler = anotarSenal;
+    sigemptyset(&accion.sa_mask);
+    accion.sa_flags = 0;
+    sigaction(senal, &accion, nullptr);
+#endif
+}
+
+/**
+ * @brief Muestra las opciones de linea de comandos
+ */
+void mostrarUso(const char* programa) {
+    std::cout << "Uso: " << programa << " [--fuente=FUENTE] [--puerto=NOMBRE] [--tuberia[=descartar]] [--paralelo[=N]]" << std::endl;
+    std::cout << "       [--puertos=A,B,...] [--sesiones] [--rotacion-diferida] [--binario] [--rendimiento]" << std::endl;
+    std::cout << "       [--latencias[=N]] [--metricas=RUTA|unix:RUTA] [--metricas-intervalo=MS]" << std::endl;
+    std::cout << "       [--registro=esperar|descartar] [--traza=RUTA] [--latencia-enlace]" << std::endl;
+    std::cout << "       [--grabar=RUTA] [--velocidad=N|max] [--diario=RUTA] [--diario-intervalo=MS]" << std::endl;
+    std::cout << "       [--detalle=silencioso|resumen|trama|demo]" << std::endl;
+    std::cout << "  --fuente    serial (por defecto), stdin, archivo:RUTA, mmap:RUTA o captura:RUTA" << std::endl;
+    std::cout << "  --puerto    COM9, /dev/ttyUSB0, ttyACM0, /dev/pts/N... (por defecto " << PUERTO_COM << ")" << std::endl;
+    std::cout << "  --tuberia   Leer el puerto en un hilo aparte y decodificar en paralelo" << std::endl;
+    std::cout << "              (=descartar: perder lineas si el decodificador no alcanza)" << std::endl;
+    std::cout << "  --paralelo  Decodificar una captura mmap:RUTA en N hilos (por defecto uno por nucleo)," << std::endl;
+    std::cout << "              sin trazas por trama" << std::endl;
+    std::cout << "  --puertos   Decodificar varios puertos a la vez, cada uno con su rotor y mensaje," << std::endl;
+    std::cout << "              en un hilo por nucleo (sin trazas por trama)" << std::endl;
+    std::cout << "  --sesiones  Separar las tramas \"#id,...\" en un mensaje por sesion; cada sesion" << std::endl;
+    std::cout << "              termina con su \"#id,FIN\" y un FIN sin prefijo termina el enlace" << std::endl;
+    std::cout << "  --rotacion-diferida  Una sola traza por rafaga de MAP, al llegar la siguiente LOAD" << std::endl;
+    std::cout << "  --binario   Pedir al ESP32 el modo binario compacto (si no lo confirma, sigue en texto)" << std::endl;
+    std::cout << "  --rendimiento  Reportar tramas/s y MB/s al terminar (en stderr)" << std::endl;
+    std::cout << "  --latencias Medir una trama de cada N (por defecto " << PERIODO_LATENCIAS << ") y reportar p50/p99/p999/max" << std::endl;
+    std::cout << "              de lectura, parseo, decodificacion e insercion al terminar y con SIGUSR1" << std::endl;
+    std::cout << "  --metricas  Publicar contadores en formato Prometheus: RUTA se reescribe cada intervalo" << std::endl;
+    std::cout << "              (por defecto " << ExportadorMetricas::INTERVALO_POR_DEFECTO_MS
+              << " ms); unix:RUTA entrega una instantanea por conexion" << std::endl;
+    std::cout << "  --registro  Con el buffer de trazas lleno: esperar al hilo de escritura (por defecto)" << std::endl;
+    std::cout << "              o descartar trazas por trama y anotar cuantas se perdieron" << std::endl;
+    std::cout << "  --traza     Escribir al terminar una linea de tiempo por trama (lectura, parseo, rotor," << std::endl;
+    std::cout << "              insercion) en formato trace-event de Chrome/Perfetto" << std::endl;
+    std::cout << "  --latencia-enlace  Pedir al ESP32 tramas con su marca de tiempo y reportar al terminar" << std::endl;
+    std::cout << "              la latencia desde su println hasta la recepcion y la lista, y la fluctuacion" << std::endl;
+    std::cout << "  --grabar    Agregar cada linea recibida, con su instante, a la captura binaria RUTA" << std::endl;
+    std::cout << "  --velocidad Reproducir captura:RUTA a N veces el ritmo grabado (por defecto 1)" << std::endl;
+    std::cout << "              o sin esperas (max)" << std::endl;
+    std::cout << "  --diario    Guardar en RUTA puntos de control del mensaje y del rotor (cada "
+              << DiarioDeDecodificacion::INTERVALO_POR_DEFECTO_MS << " ms por" << std::endl;
+    std::cout << "              defecto) y, si ya existe, reanudar desde el ultimo" << std::endl;
+    std::cout << "  silencioso  Solo el mensaje final" << std::endl;
+    std::cout << "  resumen     Banners y mensaje final, sin trazas por trama" << std::endl;
+    std::cout << "  trama       Una linea por trama con el fragmento nuevo (por defecto)" << std::endl;
+    std::cout << "  demo        Una linea por trama con el mensaje completo" << std::endl;
+}
+
+/**
+ * @brief Reporta el rendimiento de la decodificacion en stderr
+ * @param tramas Tramas validas decodificadas
+ * @param bytes Bytes leidos de la fuente
+ * @param segundos Duracion de la decodificacion
+ */
+void imprimirRendimiento(unsigned long long tramas, unsigned long long bytes, double segundos) {
+    if (segundos <= 0.0) segundos = 1e-9;
+    std::cerr << std::fixed << std::setprecision(3)
+              << "Rendimiento: " << tramas << " tramas, " << bytes << " bytes en "
+              << segundos << " s -> " << std::setprecision(0) << (tramas / segundos) << " tramas/s, "
+              << std::setprecision(1) << (bytes / segundos / 1e6) << " MB/s" << std::endl;
+}
+
+/**
+ * @brief Decodifica varios puertos a la vez (--puertos=)
+ * @param nombres Nombres de los puertos
+ * @param cantidad Numero de puertos
+ * @param conRendimiento Reportar el rendimiento agregado
+ * @return Codigo de salida del programa
+ */
+int ejecutarMultipuerto(char* const* nombres, int cantidad, bool conRendimiento) {
+    bool conBanners = obtenerNivelDetalle() != DETALLE_SILENCIOSO;
+
+    if (conBanners) {
+        std::cout << "========================================" << std::endl;
+        std::cout << "  Decodificador de Protocolo PRT-7     " << std::endl;
+        std::cout << "  Version 1.0 - Sistema de Ciberseguridad" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Conectando a " << cantidad << " puertos..." << std::endl;
+    }
+
+    DecodificadorMultipuerto* multipuerto = new DecodificadorMultipuerto(nombres, cantidad);
+    if (!multipuerto->estanConectados()) {
+        std::cerr << "Error: No se pudieron abrir todos los puertos." << std::endl;
+        delete multipuerto;
+        return 1;
+    }
+
+    if (conBanners) {
+        std::cout << "Conexion establecida. Atendiendo " << cantidad << " puertos con "
+                  << multipuerto->getHilos() << " hilos..." << std::endl;
+        std::cout << std::endl;
+    }
+
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    multipuerto->ejecutar();
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (conBanners) {
+        std::cout << "\n---" << std::endl;
+        std::cout << "Flujo de datos terminado." << std::endl;
+    }
+    multipuerto->imprimirMensajes();
+    if (conBanners) {
+        std::cout << "---" << std::endl;
+    }
+
+    unsigned long long tramas = multipuerto->getTramasTotales();
+    unsigned long long bytes = multipuerto->getBytesTotales();
+    delete multipuerto;
+
+    if (conBanners) {
+        std::cout << "\nSistema apagado." << std::endl;
+    }
+    if (conRendimiento) {
+        imprimirRendimiento(tramas, bytes, segundos);
+    }
+    return 0;
+}
 
 /**
- * @brief Parsea una linea y crea el objeto trama correspondiente
- * @param linea Linea del puerto (ej: "L,H" o "M,2")
- * @return Puntero a TramaBase (TramaLoad o TramaMap)
+ * @brief Funcion principal del programa
  */
-TramaBase* parsearTrama(char* linea) {
-    // Verificar que la linea no este vacia
-    if (linea[0] == '\0') {
-        return nullptr;
+int main(int argc, char* argv[]) {
+    // Opciones de linea de comandos
+    const char* puerto = PUERTO_COM;
+    const char* especificacion = "serial";
+    bool usarTuberia = false;
+    int hilosParalelos = -1;
+    bool conRendimiento = false;
+    PoliticaColaLlena politica = COLA_ESPERAR;
+    char* listaPuertos = nullptr;
+    bool usarSesiones = false;
+    bool usarBinario = false;
+    unsigned int periodoLatencias = 0;
+    const char* destinoMetricas = nullptr;
+    int intervaloMetricas = ExportadorMetricas::INTERVALO_POR_DEFECTO_MS;
+    PoliticaRegistroLleno politicaRegistro = REGISTRO_ESPERAR;
+    const char* rutaTraza = nullptr;
+    bool conLatenciaEnlace = false;
+    const char* rutaGrabacion = nullptr;
+    double velocidad = -1.0;
+    const char* rutaDiario = nullptr;
+    int intervaloDiario = DiarioDeDecodificacion::INTERVALO_POR_DEFECTO_MS;
+    for (int i = 1; i < argc; i++) {
+        NivelDetalle nivel;
+        if (std::strncmp(argv[i], "--detalle=", 10) == 0 && parsearNivelDetalle(argv[i] + 10, &nivel)) {
+            establecerNivelDetalle(nivel);
+        } else if (std::strncmp(argv[i], "--puerto=", 9) == 0 && argv[i][9] != '\0') {
+            puerto = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--fuente=", 9) == 0 && esFuenteValida(argv[i] + 9)) {
+            especificacion = argv[i] + 9;
+        } else if (std::strcmp(argv[i], "--rendimiento") == 0) {
+            conRendimiento = true;
+        } else if (std::strcmp(argv[i], "--tuberia") == 0) {
+            usarTuberia = true;
+        } else if (std::strcmp(argv[i], "--tuberia=descartar") == 0) {
+            usarTuberia = true;
+            politica = COLA_DESCARTAR;
+        } else if (std::strcmp(argv[i], "--paralelo") == 0) {
+            hilosParalelos = 0;
+        } else if (std::strncmp(argv[i], "--paralelo=", 11) == 0 && std::atoi(argv[i] + 11) > 0) {
+            hilosParalelos = std::atoi(argv[i] + 11);
+        } else if (std::strncmp(argv[i], "--puertos=", 10) == 0 && argv[i][10] != '\0') {
+            listaPuertos = argv[i] + 10;
+        } else if (std::strcmp(argv[i], "--sesiones") == 0) {
+            usarSesiones = true;
+            establecerSesionesMultiplexadas(true);
+        } else if (std::strcmp(argv[i], "--rotacion-diferida") == 0) {
+            establecerRotacionDiferida(true);
+        } else if (std::strcmp(argv[i], "--binario") == 0) {
+            usarBinario = true;
+        } else if (std::strcmp(argv[i], "--latencias") == 0) {
+            periodoLatencias = PERIODO_LATENCIAS;
+        } else if (std::strncmp(argv[i], "--latencias=", 12) == 0 && std::atoi(argv[i] + 12) > 0) {
+            periodoLatencias = static_cast<unsigned int>(std::atoi(argv[i] + 12));
+        } else if (std::strncmp(argv[i], "--metricas=", 11) == 0 && ExportadorMetricas::esDestinoValido(argv[i] + 11)) {
+            destinoMetricas = argv[i] + 11;
+        } else if (std::strncmp(argv[i], "--metricas-intervalo=", 21) == 0 && std::atoi(argv[i] + 21) > 0) {
+            intervaloMetricas = std::atoi(argv[i] + 21);
+        } else if (std::strcmp(argv[i], "--registro=esperar") == 0) {
+            politicaRegistro = REGISTRO_ESPERAR;
+        } else if (std::strcmp(argv[i], "--registro=descartar") == 0) {
+            politicaRegistro = REGISTRO_DESCARTAR;
+        } else if (std::strncmp(argv[i], "--traza=", 8) == 0 && argv[i][8] != '\0') {
+            rutaTraza = argv[i] + 8;
+        } else if (std::strcmp(argv[i], "--latencia-enlace") == 0) {
+            conLatenciaEnlace = true;
+            establecerMarcasDeTiempo(true);
+        } else if (std::strncmp(argv[i], "--grabar=", 9) == 0 && argv[i][9] != '\0') {
+            rutaGrabacion = argv[i] + 9;
+        } else if (std::strcmp(argv[i], "--velocidad=max") == 0) {
+            velocidad = 0.0;
+        } else if (std::strncmp(argv[i], "--velocidad=", 12) == 0 && std::atof(argv[i] + 12) > 0.0) {
+            velocidad = std::atof(argv[i] + 12);
+        } else if (std::strncmp(argv[i], "--diario=", 9) == 0 && argv[i][9] != '\0') {
+            rutaDiario = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--diario-intervalo=", 19) == 0 && std::atoi(argv[i] + 19) > 0) {
+            intervaloDiario = std::atoi(argv[i] + 19);
+        } else {
+            mostrarUso(argv[0]);
+            return 1;
+        }
     }
     
-    // Verificar si es trama de fin
-    if (linea[0] == 'F' && linea[1] == 'I' && linea[2] == 'N') {
-        return nullptr;
+    // Las sesiones se separan en el bucle secuencial
+    if (usarSesiones && (usarTuberia || hilosParalelos >= 0 || listaPuertos != nullptr)) {
+        std::cerr << "Error: --sesiones no admite --tuberia, --paralelo ni --puertos" << std::endl;
+        return 1;
     }
     
-    // Verificar formato minimo: "X,Y"
-    int longitud = 0;
-    while (linea[longitud] != '\0') longitud++;
+    // Las latencias se muestrean en el bucle secuencial
+    if (periodoLatencias > 0) {
+#ifndef PRT7_LATENCIAS
+        std::cerr << "Error: --latencias requiere compilar con PRT7_LATENCIAS" << std::endl;
+        return 1;
+#endif
+        if (usarTuberia || hilosParalelos >= 0 || listaPuertos != nullptr) {
+            std::cerr << "Error: --latencias no admite --tuberia, --paralelo ni --puertos" << std::endl;
+            return 1;
+        }
+    }
     
-    if (longitud < 3) {
-        std::cerr << "Trama invalida (muy corta): " << linea << std::endl;
-        return nullptr;
+    // Los tramos se marcan en el bucle secuencial y en los dos hilos de la tuberia
+    if (rutaTraza != nullptr) {
+#ifndef PRT7_TRAZA_EVENTOS
+        std::cerr << "Error: --traza requiere compilar con PRT7_TRAZA_EVENTOS" << std::endl;
+        return 1;
+#endif
+        if (hilosParalelos >= 0 || listaPuertos != nullptr) {
+            std::cerr << "Error: --traza no admite --paralelo ni --puertos" << std::endl;
+            return 1;
+        }
     }
     
-    // Extraer el tipo de trama (primer caracter)
-    char tipo = linea[0];
+    // Las marcas se cruzan con el reloj del host en el bucle secuencial; el
+    // modo binario no las transporta
+    if (conLatenciaEnlace && (usarTuberia || hilosParalelos >= 0 || listaPuertos != nullptr || usarBinario)) {
+        std::cerr << "Error: --latencia-enlace no admite --tuberia, --paralelo, --puertos ni --binario" << std::endl;
+        return 1;
+    }
     
-    // Verificar que el segundo caracter sea una coma
-    if (linea[1] != ',') {
-        // Ignorar silenciosamente (probablemente es texto del banner del ESP32)
-        return nullptr;
+    // Se graba lo que entrega leerLinea() en el bucle secuencial o en el lector de la tuberia
+    if (rutaGrabacion != nullptr && (hilosParalelos >= 0 || listaPuertos != nullptr)) {
+        std::cerr << "Error: --grabar no admite --paralelo ni --puertos" << std::endl;
+        return 1;
     }
     
-    // Extraer el dato (despues de la coma)
-    char* dato = &linea[2];
+    // El ritmo solo existe en las capturas de --grabar
+    if (velocidad >= 0.0 && std::strncmp(especificacion, "captura:", 8) != 0) {
+        std::cerr << "Error: --velocidad requiere --fuente=captura:RUTA" << std::endl;
+        return 1;
+    }
     
-    if (tipo == 'L') {
-        // Trama LOAD: L,<caracter>
-        char caracter = dato[0];
-        std::cout << "\nTrama recibida: [" << linea << "] -> Procesando... -> ";
-        return new TramaLoad(caracter);
-        
-    } else if (tipo == 'M') {
-        // Trama MAP: M,<numero>
-        // Convertir el string a int manualmente (atoi casero)
-        int numero = 0;
-        int signo = 1;
-        int i = 0;
-        
-        // Verificar signo
-        if (dato[0] == '-') {
-            signo = -1;
-            i = 1;
-        } else if (dato[0] == '+') {
-            i = 1;
+    // Los puntos de control se toman entre dos tramas del bucle secuencial,
+    // con un solo mensaje y un solo rotor
+    if (rutaDiario != nullptr && (usarTuberia || hilosParalelos >= 0 || listaPuertos != nullptr || usarSesiones)) {
+        std::cerr << "Error: --diario no admite --tuberia, --paralelo, --puertos ni --sesiones" << std::endl;
+        return 1;
+    }
+    
+    // Las metricas las publican el bucle secuencial y la tuberia
+    if (destinoMetricas != nullptr && (hilosParalelos >= 0 || listaPuertos != nullptr)) {
+        std::cerr << "Error: --metricas no admite --paralelo ni --puertos" << std::endl;
+        return 1;
+    }
+    
+    // Solo el puerto serial negocia el modo binario
+    if (usarBinario && (std::strcmp(especificacion, "serial") != 0 || listaPuertos != nullptr)) {
+        std::cerr << "Error: --binario requiere --fuente=serial (y no admite --puertos)" << std::endl;
+        return 1;
+    }
+    
+    // La decodificacion paralela necesita la captura completa en memoria
+    if (hilosParalelos >= 0) {
+        if (std::strncmp(especificacion, "mmap:", 5) != 0 || usarTuberia) {
+            std::cerr << "Error: --paralelo requiere --fuente=mmap:RUTA (y no admite --tuberia)" << std::endl;
+            return 1;
         }
-        
-        // Convertir digitos
-        while (dato[i] >= '0' && dato[i] <= '9') {
-            numero = numero * 10 + (dato[i] - '0');
-            i++;
+        if (obtenerNivelDetalle() > DETALLE_RESUMEN) {
+            establecerNivelDetalle(DETALLE_RESUMEN);
         }
-        
-        numero *= signo;
-        
-        std::cout << "\nTrama recibida: [" << linea << "] -> Procesando... -> ";
-        return new TramaMap(numero);
-        
-    } else {
-        std::cerr << "Tipo de trama desconocido: " << tipo << std::endl;
-        return nullptr;
     }
-}
+    
+    // Varios puertos: cada uno con su propio rotor y mensaje
+    if (listaPuertos != nullptr) {
+        if (std::strcmp(especificacion, "serial") != 0 || usarTuberia || hilosParalelos >= 0) {
+            std::cerr << "Error: --puertos no admite --fuente, --tuberia ni --paralelo" << std::endl;
+            return 1;
+        }
+        if (obtenerNivelDetalle() > DETALLE_RESUMEN) {
+            establecerNivelDetalle(DETALLE_RESUMEN);
+        }
 
-/**
- * @brief Funcion principal del programa
- */
-int main() {
-    // Banner de inicio
-    std::cout << "========================================" << std::endl;
-    std::cout << "  Decodificador de Protocolo PRT-7     " << std::endl;
-    std::cout << "  Version 1.0 - Sistema de Ciberseguridad" << std::endl;
-    std::cout << "========================================" << std::endl;
-    std::cout << std::endl;
+        // Separar "A,B,C" en su lugar
+        int cantidad = 1;
+        for (char* c = listaPuertos; *c != '\0'; c++) {
+            if (*c == ',') cantidad++;
+        }
+        char** nombres = new char*[cantidad];
+        int n = 0;
+        nombres[n++] = listaPuertos;
+        for (char* c = listaPuertos; *c != '\0'; c++) {
+            if (*c == ',') {
+                *c = '\0';
+                nombres[n++] = c + 1;
+            }
+        }
+        for (int i = 0; i < cantidad; i++) {
+            if (nombres[i][0] == '\0') {
+                delete[] nombres;
+                mostrarUso(argv[0]);
+                return 1;
+            }
+        }
+
+        int codigo = ejecutarMultipuerto(nombres, cantidad, conRendimiento);
+        delete[] nombres;
+        return codigo;
+    }
     
-    std::cout << "Iniciando Decodificador PRT-7..." << std::endl;
-    std::cout << "Conectando a puerto " << PUERTO_COM << "..." << std::endl;
+    bool conBanners = obtenerNivelDetalle() != DETALLE_SILENCIOSO;
+    bool esSerial = std::strcmp(especificacion, "serial") == 0;
     
-    // Crear puerto serial
-    SerialPort serial(PUERTO_COM);
+    // Banner de inicio
+    if (conBanners) {
+        std::cout << "========================================" << std::endl;
+        std::cout << "  Decodificador de Protocolo PRT-7     " << std::endl;
+        std::cout << "  Version 1.0 - Sistema de Ciberseguridad" << std::endl;
+        std::cout << "========================================" << std::endl;
+        std::cout << std::endl;
+        
+        std::cout << "Iniciando Decodificador PRT-7..." << std::endl;
+        if (esSerial) {
+            std::cout << "Conectando a puerto " << puerto << "..." << std::endl;
+        } else {
+            std::cout << "Leyendo tramas desde " << especificacion << "..." << std::endl;
+        }
+    }
     
-    if (!serial.estaConectado()) {
-        std::cerr << "Error: No se pudo conectar al puerto serial." << std::endl;
-        std::cerr << "Verifica que el ESP32 este conectado al puerto " << PUERTO_COM << std::endl;
-        std::cout << "\nPresione Enter para salir..." << std::endl;
-        std::cin.get();
+    // Crear la fuente de tramas (puerto serial, stdin o captura)
+    FuenteDeTramas* fuente = crearFuenteDeTramas(especificacion, puerto);
+    
+    if (!fuente->estaConectado()) {
+        delete fuente;
+        if (esSerial) {
+            std::cerr << "Error: No se pudo conectar al puerto serial." << std::endl;
+            std::cerr << "Verifica que el ESP32 este conectado al puerto " << puerto << std::endl;
+            std::cout << "\nPresione Enter para salir..." << std::endl;
+            std::cin.get();
+        }
         return 1;
     }
     
-    std::cout << "Conexion establecida. Esperando tramas..." << std::endl;
-    std::cout << std::endl;
+    // Reproduccion de una captura: ritmo original, N veces mas rapido o sin esperas
+    FuenteCaptura* captura = nullptr;
+    if (std::strncmp(especificacion, "captura:", 8) == 0) {
+        captura = static_cast<FuenteCaptura*>(fuente);
+        if (velocidad >= 0.0) captura->setVelocidad(velocidad);
+    }
+    
+    // La grabacion envuelve a la fuente (la captura queda dentro de ella)
+    FuenteGrabada* grabada = nullptr;
+    if (rutaGrabacion != nullptr) {
+        grabada = new FuenteGrabada(fuente, rutaGrabacion);
+        fuente = grabada;
+        if (!grabada->estaGrabando()) {
+            delete fuente;
+            return 1;
+        }
+    }
+    
+    if (usarBinario && !fuente->solicitarModoBinario()) {
+        std::cerr << "Aviso: no se pudo enviar la solicitud de modo binario" << std::endl;
+    }
+    
+    // Con captura o stdin las marcas vienen (o no) en las lineas
+    LatenciaEnlace* enlace = nullptr;
+    int solicitudesMarcas = 0;
+    if (conLatenciaEnlace) {
+        enlace = new LatenciaEnlace(esSerial ? LatenciaEnlace::BAUDIOS : 0);
+        if (fuente->solicitarMarcasDeTiempo()) solicitudesMarcas++;
+    }
+    
+    if (conBanners) {
+        if (esSerial) {
+            std::cout << "Conexion establecida. Esperando tramas..." << std::endl;
+        } else {
+            std::cout << "Fuente abierta. Decodificando..." << std::endl;
+        }
+        std::cout << std::endl;
+    }
     
     // Crear las estructuras de datos
     ListaDeCarga* listaCarga = new ListaDeCarga();
     RotorDeMapeo* rotor = new RotorDeMapeo();
     
-    // Buffer para leer lineas
-    const int BUFFER_SIZE = 256;
-    char buffer[BUFFER_SIZE];
+    // Reanudar el mensaje y el rotor del ultimo punto de control
+    DiarioDeDecodificacion* diario = nullptr;
+    if (rutaDiario != nullptr) {
+        std::chrono::steady_clock::time_point antesDiario = std::chrono::steady_clock::now();
+        diario = new DiarioDeDecodificacion(rutaDiario, intervaloDiario);
+        if (!diario->abrir(listaCarga, rotor)) {
+            delete diario;
+            delete listaCarga;
+            delete rotor;
+            delete fuente;
+            return 1;
+        }
+        if (diario->getTramasPrevias() > 0) {
+            std::cerr << std::fixed << std::setprecision(1) << "Diario: reanudado desde " << rutaDiario << " con "
+                      << diario->getLargoRestaurado() << " caracteres, rotor en " << rotor->getDesplazamiento()
+                      << " y " << diario->getTramasPrevias() << " tramas previas ("
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - antesDiario).count()
+                      << " ms)" << std::endl;
+        }
+    }
     
     bool decodificacionCompleta = false;
+    TablaDeSesiones* sesiones = nullptr;
+    unsigned long long tramasProcesadas = 0;
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    
+    ExportadorMetricas* exportador = nullptr;
+    if (destinoMetricas != nullptr) {
+        exportador = new ExportadorMetricas(&metricas, destinoMetricas, intervaloMetricas);
+        if (!exportador->iniciar()) {
+            std::cerr << "Aviso: no se pudo publicar metricas en " << destinoMetricas << std::endl;
+        }
+    }
     
-    // Bucle principal de lectura y decodificacion
-    while (!decodificacionCompleta) {
-        // Leer una linea del puerto serial
-        int bytesLeidos = serial.leerLinea(buffer, BUFFER_SIZE);
+    if (periodoLatencias > 0) {
+        // SIGUSR1 imprime las latencias sin parar; SIGINT/SIGTERM terminan
+        // la lectura y se imprimen con el mensaje parcial
+        habilitarLatencias(periodoLatencias);
+        instalarSenal(SIGINT);
+        instalarSenal(SIGTERM);
+#ifndef WINDOWS_BUILD
+        instalarSenal(SIGUSR1);
+#endif
+    }
+    
+    if (rutaTraza != nullptr) {
+        // El buffer del hilo principal se reserva antes de medir; en el bucle
+        // secuencial SIGINT/SIGTERM tambien dejan escrita la traza
+        habilitarTrazaEventos();
+        nombrarHiloTraza("principal");
+        if (!usarTuberia) {
+            instalarSenal(SIGINT);
+            instalarSenal(SIGTERM);
+        }
+    }
+    
+    if (diario != nullptr) {
+        // SIGINT/SIGTERM terminan el bucle y el ultimo punto de control
+        // guarda las tramas que llegaron despues del anterior
+        instalarSenal(SIGINT);
+        instalarSenal(SIGTERM);
+    }
+    
+    // Trazas y avisos por trama pasan por el hilo de escritura (ver RegistroAsincrono)
+    iniciarRegistro(politicaRegistro);
+    
+    if (hilosParalelos >= 0) {
+        // Captura completa repartida entre hilos (ver DecodificadorParalelo)
+        DecodificadorParalelo paralelo(hilosParalelos);
+        decodificacionCompleta = paralelo.decodificar(static_cast<FuenteMapeada*>(fuente), listaCarga, rotor);
+        tramasProcesadas = paralelo.getTramasProcesadas();
+        if (paralelo.getLineasInvalidas() > 0) {
+            std::cerr << "Aviso: " << paralelo.getLineasInvalidas() << " tramas invalidas ignoradas" << std::endl;
+        }
+        if (conBanners) {
+            std::cout << "Decodificado en " << paralelo.getHilos() << " hilos" << std::endl;
+        }
+    } else if (usarTuberia) {
+        // Lectura y decodificacion en hilos separados (ver TuberiaDecodificacion)
+        TuberiaDecodificacion* tuberia = new TuberiaDecodificacion(fuente, listaCarga, rotor, politica);
+        decodificacionCompleta = tuberia->ejecutar();
+        tramasProcesadas = tuberia->getTramasProcesadas();
+        vaciarRegistro();
+        if (conBanners) {
+            std::cout << std::endl;
+            tuberia->imprimirEstadisticas();
+        }
+        delete tuberia;
+    } else {
+        // Buffer para leer lineas
+        const int BUFFER_SIZE = 256;
+        char buffer[BUFFER_SIZE];
+        
+        // Trama reutilizable: se parsea en el mismo lugar en cada iteracion
+        Trama trama;
+        
+        // Sesiones multiplexadas (las tramas sin prefijo van a listaCarga)
+        sesiones = usarSesiones ? new TablaDeSesiones() : nullptr;
+        unsigned int lineasSinPublicar = 0;
         
-        if (bytesLeidos > 0) {
-            // Parsear la trama
-            TramaBase* trama = parsearTrama(buffer);
+        // Bucle principal de lectura y decodificacion
+        while (!decodificacionCompleta) {
+            // Leer una linea de la fuente (una de cada N se mide, ver LatenciaPorEtapa).
+            // Sin espera activa: leerLinea() duerme en el puerto hasta que llegan
+            // bytes (o vence su timeout), asi que el proceso no usa CPU en reposo
+            LATENCIA_MUESTRA(muestra);
+            LATENCIA_MARCA(muestra, antes);
+            TRAZA_MARCA(trazaAntes);
+            int bytesLeidos = fuente->leerLinea(buffer, BUFFER_SIZE);
+            LATENCIA_MARCA(muestra, leida);
+            TRAZA_MARCA(trazaLeida);
+            unsigned long long recibida = enlace != nullptr ? LatenciaEnlace::ahora() : 0;
             
-            if (trama != nullptr) {
-                // Procesar la trama (polimorfismo en accion!)
-                trama->procesar(listaCarga, rotor);
-                
-                // Liberar memoria de la trama
-                delete trama;
-            } else {
-                // Verificar si es el marcador de fin
-                if (buffer[0] == 'F' && buffer[1] == 'I' && buffer[2] == 'N') {
+            bool valida = bytesLeidos > 0 && parsearTrama(buffer, &trama);
+            TRAZA_TRAMO("lectura", trazaAntes, trazaLeida);
+            if (bytesLeidos > 0) {
+                LATENCIA_MARCA(muestra, parseada);
+                LATENCIA_ETAPA(muestra, ETAPA_LECTURA, antes, leida);
+                LATENCIA_ETAPA(muestra, ETAPA_PARSEO, leida, parseada);
+                TRAZA_MARCA(trazaParseada);
+                TRAZA_TRAMO("parseo", trazaLeida, trazaParseada);
+            }
+            
+            if (valida) {
+                tramasProcesadas++;
+                metricas.contarTrama(trama.tipo);
+                if (trama.tipo == TRAMA_FIN && (sesiones == nullptr || trama.sesion == 0)) {
                     decodificacionCompleta = true;
+                } else if (sesiones != nullptr && trama.sesion != 0) {
+                    // Trama de una sesion: su propio rotor y su propio mensaje
+                    Sesion* sesion = sesiones->obtener(trama.sesion);
+                    if (trama.tipo == TRAMA_FIN) {
+                        TablaDeSesiones::imprimirSesion(sesion, true);
+                        sesiones->cerrar(sesion);
+                    } else {
+                        TablaDeSesiones::aplicar(sesion, trama);
+                    }
+                } else {
+                    // Despacho por etiqueta (sin new/delete ni llamada virtual)
+                    procesarTrama(trama, listaCarga, rotor);
+                }
+                
+                if (enlace != nullptr) {
+                    if (trama.conMarca) {
+                        enlace->registrar(trama.marca, bytesLeidos, recibida,
+                                          trama.tipo == TRAMA_LOAD ? LatenciaEnlace::ahora() : 0);
+                    } else if (enlace->getMuestras() == 0 && solicitudesMarcas > 0
+                               && solicitudesMarcas < INTENTOS_MARCAS) {
+                        // El ESP32 pudo perder la solicitud mientras arrancaba
+                        fuente->solicitarMarcasDeTiempo();
+                        solicitudesMarcas++;
+                    }
+                }
+                
+                // Comparar el reloj por trama es barato; el fsync solo ocurre una vez por intervalo
+                if (diario != nullptr) {
+                    diario->puntoDeControlSiVencido(listaCarga, rotor, tramasProcesadas);
                 }
             }
+        
+            // Estado para las metricas cada tantas lineas y en cada timeout
+            if (++lineasSinPublicar >= MetricasDecodificador::PERIODO_PUBLICACION || bytesLeidos == 0) {
+                lineasSinPublicar = 0;
+                metricas.publicarFuente(fuente->getBytesLeidos());
+                metricas.publicarMensaje(listaCarga->getTamanio(), rotor->getDesplazamiento());
+                if (diario != nullptr) {
+                    diario->puntoDeControlSiVencido(listaCarga, rotor, tramasProcesadas);
+                }
+            }
+            
+            if (!fuente->estaConectado()) {
+                break;
+            }
+            
+            if (senalPendiente != 0) {
+#ifndef WINDOWS_BUILD
+                if (senalPendiente == SIGUSR1) {
+                    senalPendiente = 0;
+                    vaciarRegistro();
+                    imprimirLatencias();
+                    continue;
+                }
+#endif
+                break;
+            }
         }
         
-        // Pequena pausa para no saturar el CPU
-        // (en Windows no hay sleep estandar sin STL, asi que usamos un loop vacio)
-        for (volatile int i = 0; i < 1000000; i++);
+        // MAP justo antes de FIN (o del fin del flujo): no queda LOAD que emita su traza
+        rotor->emitirRotacionPendiente();
+    }
+    
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    unsigned long long bytesFuente = fuente->getBytesLeidos();
+    
+    // Ultimo punto de control: con FIN, la proxima ejecucion empieza otro mensaje
+    if (diario != nullptr) {
+        diario->puntoDeControl(listaCarga, rotor, tramasProcesadas, decodificacionCompleta);
+        delete diario;
+    }
+    
+    // Todo lo registrado sale antes que los avisos finales y el mensaje
+    detenerRegistro();
+    if (getTrazasDescartadas() > 0) {
+        std::cerr << "Aviso: " << getTrazasDescartadas() << " trazas descartadas con el registro lleno" << std::endl;
+    }
+    
+    // Instantanea final con el estado completo
+    metricas.publicarFuente(bytesFuente);
+    metricas.publicarMensaje(listaCarga->getTamanio(), rotor->getDesplazamiento());
+    delete exportador;
+    
+    if (!decodificacionCompleta) {
+        if (senalPendiente == SIGINT || senalPendiente == SIGTERM) {
+            std::cerr << "Aviso: Decodificacion interrumpida por una senal" << std::endl;
+        } else if (esSerial) {
+            std::cerr << "Error: Se perdio la conexion con el puerto " << puerto << std::endl;
+        } else {
+            std::cerr << "Aviso: La fuente termino sin trama FIN" << std::endl;
+        }
     }
     
     // Mostrar el mensaje final
-    std::cout << "\n---" << std::endl;
-    std::cout << "Flujo de datos terminado." << std::endl;
+    if (conBanners) {
+        std::cout << "\n---" << std::endl;
+        std::cout << "Flujo de datos terminado." << std::endl;
+    }
     listaCarga->imprimirMensaje();
-    std::cout << "---" << std::endl;
+    if (sesiones != nullptr) {
+        // Sesiones que no alcanzaron su FIN
+        for (Sesion* sesion = sesiones->getPrimera(); sesion; sesion = sesion->siguiente) {
+            TablaDeSesiones::imprimirSesion(sesion, false);
+        }
+        if (conBanners) {
+            std::cout << "\nSesiones: " << sesiones->getCerradas() << " con FIN, "
+                      << sesiones->getActivas() << " sin FIN, maximo "
+                      << sesiones->getMaximoActivas() << " simultaneas" << std::endl;
+        }
+    }
+    if (conBanners) {
+        std::cout << "---" << std::endl;
+    }
     
     // Limpiar memoria
-    std::cout << "\nLiberando memoria... ";
+    if (conBanners) {
+        std::cout << "\nLiberando memoria... ";
+    }
     delete listaCarga;
     delete rotor;
-    serial.cerrar();
-    std::cout << "Sistema apagado." << std::endl;
+    delete sesiones;
+    fuente->cerrar();
+    if (conBanners) {
+        std::cout << "Sistema apagado." << std::endl;
+        if (grabada != nullptr) {
+            std::cout << "Captura: " << grabada->getLineasGrabadas() << " lineas ("
+                      << grabada->getBytesGrabados() << " bytes) agregadas a " << rutaGrabacion << std::endl;
+        }
+    }
+    
+    if (conRendimiento && captura != nullptr && velocidad != 0.0) {
+        std::cerr << "Reproduccion: " << captura->getLineas() << " lineas, retraso maximo "
+                  << captura->getRetrasoMaximo() << " us" << std::endl;
+    }
+    delete fuente;
+    
+    if (conRendimiento) {
+        imprimirRendimiento(tramasProcesadas, bytesFuente, segundos);
+    }
+    if (latenciasHabilitadas()) {
+        imprimirLatencias();
+    }
+    if (enlace != nullptr) {
+        enlace->imprimir();
+        delete enlace;
+    }
+    if (rutaTraza != nullptr) {
+        if (!escribirTrazaEventos(rutaTraza)) {
+            std::cerr << "Aviso: no se pudo escribir la traza en " << rutaTraza << std::endl;
+        } else if (getEventosTrazaPerdidos() > 0) {
+            std::cerr << "Aviso: " << getEventosTrazaPerdidos() << " eventos de traza perdidos (buffer de "
+                      << CAPACIDAD_TRAZA_POR_HILO << " por hilo lleno)" << std::endl;
+        }
+    }
     
-    std::cout << "\nPresione Enter para salir..." << std::endl;
-    std::cin.get();
+    if (conBanners && esSerial) {
+        std::cout << "\nPresione Enter para salir..." << std::endl;
+        std::cin.get();
+    }
     
     return 0;
 }